@@ -1,6 +1,7 @@
 #include "Asset.h"
 
-Asset::Asset(const std::string& symbol, const std::string& fn, const std::string& iso) : cs{CandleSeries()}, symbol_{symbol}, iso_{iso} {cs.read_clean(fn);};   
+Asset::Asset(const std::string& symbol, const std::string& fn, const std::string& iso, const std::string& storage) : 
+	cs{SeriesCatalog::global().get(symbol, fn, storage)}, symbol_{symbol}, iso_{iso} {};   
 
 std::string Asset::get_symbol() const{
 	return symbol_; 	
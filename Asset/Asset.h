@@ -1,13 +1,16 @@
 #pragma once
 #include "../CandleSeries/CandleSeries.h"
+#include "SeriesCatalog.h"
 #include "../Utility/utility.h" 
 
 class Asset{
 	public:
-		Asset(const std::string& symbol, const std::string& fn, const std::string& iso); 
+		//the series in fn is shared through SeriesCatalog::global() (storage is passed to CandleSeries::read_clean)
+		Asset(const std::string& symbol, const std::string& fn, const std::string& iso, const std::string& storage = "rows"); 
 		std::string get_symbol() const;
 		std::string get_iso() const;
-		CandleSeries cs; 
+		//read only handle to the candle series (shared with the other Assets reading the same file)
+		std::shared_ptr<const CandleSeries> cs; 
 	protected:
 		 //String to hold the asset symbol
 		std::string symbol_;
@@ -10,14 +10,12 @@ Forex::Forex(const std::string symbol, const std::string& fn, ValidForex& vfx) :
 
 Forex::Forex(const std::string symbol, const std::string& usd_b_or_b_usd, const std::string usd_q_or_q_usd, const std::string fn_1, const std::string fn_2, const std::string fn_3, ValidForex& vfx) : 
 	Asset{symbol, fn_1, symbol.substr(0, 3)},  base_iso_{symbol.substr(0, 3)}, quote_iso_{symbol.substr(4, 3)}, 
-	usd_b_or_b_usd_{usd_b_or_b_usd}, usd_q_or_q_usd_{usd_q_or_q_usd}, usd_b_or_b_usd_cs_{CandleSeries()}, usd_q_or_q_usd_cs_{CandleSeries()} 
+	usd_b_or_b_usd_{usd_b_or_b_usd}, usd_q_or_q_usd_{usd_q_or_q_usd}, 
+	usd_b_or_b_usd_cs_{SeriesCatalog::global().get(usd_b_or_b_usd, fn_2)}, usd_q_or_q_usd_cs_{SeriesCatalog::global().get(usd_q_or_q_usd, fn_3)} 
 {
-	//call read clean on the usd/base and usd/quote files 
-	usd_b_or_b_usd_cs_.read_clean(fn_2); 
-	usd_q_or_q_usd_cs_.read_clean(fn_3);
 	//check if the timeframes are the same 
-	if(usd_b_or_b_usd_cs_.tf() != usd_q_or_q_usd_cs_.tf()){
-		if(usd_b_or_b_usd_cs_.tf() != this->cs.tf()){
+	if(usd_b_or_b_usd_cs_->tf() != usd_q_or_q_usd_cs_->tf()){
+		if(usd_b_or_b_usd_cs_->tf() != this->cs->tf()){
 			throw std::invalid_argument("Forex Constructor: The timeframes of the three CandleSeries must be the same."); 
 		}
 	}
@@ -25,9 +23,9 @@ Forex::Forex(const std::string symbol, const std::string& usd_b_or_b_usd, const
 	validate_(vfx);
 	validate_(vfx, usd_b_or_b_usd, usd_q_or_q_usd);
 	//sync the .cbegin() & .cend() iterator pairs for all 3 CandleSeries 
-	unsynced_it_pairs = std::make_tuple(std::make_pair(cs.cs_it_b(), cs.cs_it_e()), 
-									  std::make_pair(usd_b_or_b_usd_cs_.cs_it_b(), usd_b_or_b_usd_cs_.cs_it_e()), 
-									  std::make_pair(usd_q_or_q_usd_cs_.cs_it_b(), usd_q_or_q_usd_cs_.cs_it_e()));
+	unsynced_it_pairs = std::make_tuple(std::make_pair(cs->cs_it_b(), cs->cs_it_e()), 
+									  std::make_pair(usd_b_or_b_usd_cs_->cs_it_b(), usd_b_or_b_usd_cs_->cs_it_e()), 
+									  std::make_pair(usd_q_or_q_usd_cs_->cs_it_b(), usd_q_or_q_usd_cs_->cs_it_e()));
 	synced_it_pairs = unsynced_it_pairs; 
 	utility::sync_iterators(synced_it_pairs);
 
@@ -65,13 +63,11 @@ double Forex::usd_base(std::vector<Candle>::const_iterator it) const{
 	}else{
 		//if neither base or quote is usd we must use the usd/base and usd/quote candleseries
 		//check if it corresponds to a datetime in usd_b_or_b_usd CandleSeries	
-		if((it->dt() < usd_b_or_b_usd_cs_.cs_it_b()->dt()) || (it->dt() > usd_b_or_b_usd_cs_.cs_it_rb()->dt())){
+		if((it->dt() < usd_b_or_b_usd_cs_->cs_it_b()->dt()) || (it->dt() > usd_b_or_b_usd_cs_->cs_it_rb()->dt())){
 			throw std::runtime_error("get_usd_base: The iterator it corresponds to a datetime not in usd_b_or_b_usd's CandleSeries"); 
 		}
-		//distance from the synced first iterator in symbol's cs to the input iterator
-		auto n = std::distance(std::get<0>(synced_it_pairs).first, it);                    
-		//get the usd_b_or_b_usd_cs_ iterator which corresponds to the same datetime as it.
-		auto usd_base_it = std::next(std::get<1>(synced_it_pairs).first, n); 
+		//get the usd_b_or_b_usd_cs_ iterator which corresponds to the same datetime as it (grid index lookup)
+		auto usd_base_it = std::next(usd_b_or_b_usd_cs_->cs_it_b(), usd_b_or_b_usd_cs_->index_of(it->dt())); 
 		std::string base = usd_b_or_b_usd_.substr(0, 3);  
 		std::string quote = usd_b_or_b_usd_.substr(4, 3);
 		if(base == "USD"){
@@ -96,13 +92,11 @@ double Forex::quote_usd(std::vector<Candle>::const_iterator it) const{
 	}else{
 		//if neither base or quote is usd we must use the usd/base and usd/quote candleseries
 		//check if it corresponds to a datetime in usd_q_or_q_usd CandleSeries	
-		if((it->dt() < usd_q_or_q_usd_cs_.cs_it_b()->dt()) || (it->dt() > usd_q_or_q_usd_cs_.cs_it_rb()->dt())){
+		if((it->dt() < usd_q_or_q_usd_cs_->cs_it_b()->dt()) || (it->dt() > usd_q_or_q_usd_cs_->cs_it_rb()->dt())){
 			throw std::runtime_error("quote_usd: The iterator it corresponds to a datetime not in usd_q_or_q_usd's CandleSeries"); 
 		}
-		//distance from the synced first iterator in symbol's cs to the input iterator
-		auto n = std::distance(std::get<0>(synced_it_pairs).first, it);                    
-		//get the usd_q_or_q_usd_cs_ iterator which corresponds to the same datetime as it.
-		auto usd_quote_it = std::next(std::get<2>(synced_it_pairs).first, n); 
+		//get the usd_q_or_q_usd_cs_ iterator which corresponds to the same datetime as it (grid index lookup)
+		auto usd_quote_it = std::next(usd_q_or_q_usd_cs_->cs_it_b(), usd_q_or_q_usd_cs_->index_of(it->dt())); 
 		std::string base = usd_b_or_b_usd_.substr(0, 3);  
 		std::string quote = usd_b_or_b_usd_.substr(4, 3);
 		if(base == "USD"){
@@ -41,9 +41,9 @@ class Forex : public Asset{
 		std::string usd_b_or_b_usd_;
 		//either quote/USD or USD/quote
 		std::string usd_q_or_q_usd_;
-		//candleseries for the other exchange rates (only set in the case of cross pairs)
-		CandleSeries usd_b_or_b_usd_cs_; 
-		CandleSeries usd_q_or_q_usd_cs_;
+		//candleseries for the other exchange rates (only set in the case of cross pairs, shared through the SeriesCatalog)
+		std::shared_ptr<const CandleSeries> usd_b_or_b_usd_cs_; 
+		std::shared_ptr<const CandleSeries> usd_q_or_q_usd_cs_;
 		//unsynced cbegin & cend iterator pairs for the symbol candle series, the usd_b_or_b_usd and the usd_q_or_q_usd candle series 
 		std::tuple<std::pair<std::vector<Candle>::const_iterator, std::vector<Candle>::const_iterator>, 
 				   std::pair<std::vector<Candle>::const_iterator, std::vector<Candle>::const_iterator>,	
@@ -0,0 +1,97 @@
+#include "SeriesCatalog.h"
+#include <filesystem>
+#include <iostream>
+
+SeriesCatalog& SeriesCatalog::global(){
+	static SeriesCatalog catalog;
+	return catalog;
+}
+
+SeriesCatalog::Key SeriesCatalog::key_(const std::string& symbol, const std::string& fn, const std::string& storage){
+	//different spellings of the same path share an entry
+	std::error_code ec;
+	std::filesystem::path p = std::filesystem::weakly_canonical(fn, ec);
+	return Key(symbol, ec ? fn : p.string(), storage);
+}
+
+std::shared_ptr<const CandleSeries> SeriesCatalog::get(const std::string& symbol, const std::string& fn, const std::string& storage){
+	Key k = key_(symbol, fn, storage);
+	std::promise<std::shared_ptr<const CandleSeries>> p;
+	std::shared_future<std::shared_ptr<const CandleSeries>> f;
+	bool read = false;
+	{
+		std::lock_guard<std::mutex> lock(m_);
+		auto it = series_.find(k);
+		if(it != series_.end()){
+			hits_++;
+			f = it->second;
+		}else{
+			misses_++;
+			f = p.get_future().share();
+			series_.emplace(k, f);
+			read = true;
+		}
+	}
+	if(!read){
+		//waits if another thread is still reading the series
+		return f.get();
+	}
+	try{
+		auto cs = std::make_shared<CandleSeries>();
+		cs->read_clean(fn, storage);
+		p.set_value(std::move(cs));
+	}catch(...){
+		//failed reads are not cached (threads already waiting see the exception)
+		p.set_exception(std::current_exception());
+		std::lock_guard<std::mutex> lock(m_);
+		series_.erase(k);
+		throw;
+	}
+	return f.get();
+}
+
+bool SeriesCatalog::contains(const std::string& symbol, const std::string& fn, const std::string& storage) const{
+	Key k = key_(symbol, fn, storage);
+	std::lock_guard<std::mutex> lock(m_);
+	return series_.count(k) > 0;
+}
+
+void SeriesCatalog::clear(){
+	std::lock_guard<std::mutex> lock(m_);
+	series_.clear();
+}
+
+SeriesCatalog::Stats SeriesCatalog::stats() const{
+	std::lock_guard<std::mutex> lock(m_);
+	Stats s;
+	s.hits = hits_;
+	s.misses = misses_;
+	for(const auto& [k, f] : series_){
+		//series which are still being read are not counted
+		if(f.wait_for(std::chrono::seconds{0}) != std::future_status::ready){
+			continue;
+		}
+		std::shared_ptr<const CandleSeries> cs;
+		try{
+			cs = f.get();
+		}catch(...){
+			continue;
+		}
+		s.n_series++;
+		s.owned_bytes += sizeof(CandleSeries) + static_cast<std::size_t>(std::distance(cs->cs_it_b(), cs->cs_it_e())) * sizeof(Candle);
+		//8 columns of 8 bytes per candle
+		std::size_t col_bytes = cs->cols().size() * 8 * sizeof(double);
+		if(cs->cols().mapped()){
+			s.mapped_bytes += col_bytes;
+		}else{
+			s.owned_bytes += col_bytes;
+		}
+	}
+	return s;
+}
+
+void SeriesCatalog::display_stats() const{
+	Stats s = stats();
+	std::cout << "Series catalog: " << s.n_series << " series, " << s.hits << " hits, " << s.misses << " misses" << std::endl;
+	std::cout << "Owned memory: " << s.owned_bytes << " bytes, mapped columns: " << s.mapped_bytes << " bytes" << std::endl;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "../CandleSeries/CandleSeries.h"
+#include <cstddef>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+//Process wide catalog of cleaned candle series. Each series is keyed by (symbol, source file, storage) & is read at most once,
+//the Assets which use it share a read only handle (e.g. the USD legs of a universe of cross pairs are loaded once). Binary candle
+//files read with storage "columns" are memory mapped (see CandleSeries::read_clean). The timeframe of a series is the timeframe
+//of its file. Thread safe (a series requested by several threads at once is read by one of them)
+class SeriesCatalog{
+	public:
+		struct Stats{
+			//number of requests served from the catalog & number of series read
+			std::size_t hits = 0;
+			std::size_t misses = 0;
+			std::size_t n_series = 0;
+			//approximate memory held by the series (owned rows & columns) & size of the mapped columns
+			std::size_t owned_bytes = 0;
+			std::size_t mapped_bytes = 0;
+		};
+		//the catalog shared by the process
+		static SeriesCatalog& global();
+		//shared handle to the series in fn (read with CandleSeries::read_clean(fn, storage) the first time it is requested)
+		std::shared_ptr<const CandleSeries> get(const std::string& symbol, const std::string& fn, const std::string& storage = "rows");
+		//true if the series is in the catalog
+		bool contains(const std::string& symbol, const std::string& fn, const std::string& storage = "rows") const;
+		//drop the catalog's references (handles which are still held stay valid)
+		void clear();
+		//accessors to the statistics
+		Stats stats() const;
+		void display_stats() const;
+	private:
+		using Key = std::tuple<std::string, std::string, std::string>;
+		static Key key_(const std::string& symbol, const std::string& fn, const std::string& storage);
+		mutable std::mutex m_;
+		std::map<Key, std::shared_future<std::shared_ptr<const CandleSeries>>> series_;
+		std::size_t hits_ = 0;
+		std::size_t misses_ = 0;
+};
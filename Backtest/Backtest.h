@@ -938,7 +938,7 @@ template <typename A, typename It>
 void backtest::basic_info_table(std::string& latex, const A& asset, const std::pair<It, It>& start_end_it, int n_trades){
 	auto headers = std::make_tuple("Symbol", "Timeframe", "Start Datetime", "End Datetime", "Number of Trades");
 	std::vector<std::tuple<std::string, int, Datetime, Datetime, int>> rows{
-		std::make_tuple(asset.get_symbol(), asset.cs.tf(), start_end_it.first->dt(), start_end_it.second->dt(), n_trades)};
+		std::make_tuple(asset.get_symbol(), asset.cs->tf(), start_end_it.first->dt(), start_end_it.second->dt(), n_trades)};
 	auto h_fcn_console = [](const std::string& s){
 		return s; 
 	};
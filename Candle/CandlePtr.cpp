@@ -5,122 +5,92 @@ __host__ __device__
 #endif 
 
 //Parameterized Constructor
-CandlePtr::CandlePtr(const Datetime& dt, const double& o, const double& h, const double& l, const double& c, double&& v, const double& b, const double& a){
-	dt_ptr_ = std::make_shared<Datetime>(dt); 
-	o_ptr_ = std::make_shared<double>(o); 
-	h_ptr_ = std::make_shared<double>(h); 
-	l_ptr_ = std::make_shared<double>(l); 
-	c_ptr_ = std::make_shared<double>(c);
+CandlePtr::CandlePtr(const Datetime& dt, const double& o, const double& h, const double& l, const double& c, double&& v, const double& b, const double& a, 
+		bool validate){
+	block_ = std::make_shared<Block>(Block{dt, o, h, l, c, b, a}); 
 	v_ = std::move(v); 
-	b_ptr_ = std::make_shared<double>(b); 
-	a_ptr_ = std::make_shared<double>(a); 
-	validate_(); 
+	if(validate){
+		validate_(); 
+	}
 }
-//Move Constructor 
+//Move Constructor (the block is shared rather than copied so rhs stays valid) 
 CandlePtr::CandlePtr(CandlePtr &&rhs){
-	dt_ptr_ = std::make_shared<Datetime>(std::move(*rhs.dt_ptr_)); 
-	o_ptr_ = std::make_shared<double>(std::move(*rhs.o_ptr_)); 
-	h_ptr_ = std::make_shared<double>(std::move(*rhs.h_ptr_)); 
-	l_ptr_ = std::make_shared<double>(std::move(*rhs.l_ptr_)); 
-	c_ptr_ = std::make_shared<double>(std::move(*rhs.c_ptr_)); 
+	block_ = rhs.block_; 
 	v_ = std::move(rhs.v_); 
-	b_ptr_ = std::make_shared<double>(std::move(*rhs.b_ptr_)); 
-	a_ptr_ = std::make_shared<double>(std::move(*rhs.a_ptr_)); 
 }
 //Copy Constructor 
 CandlePtr::CandlePtr(const CandlePtr &rhs){
-	//std::cout << "CandlePtr Copy Constructor Called" << std::endl; 
-	dt_ptr_ = rhs.dt_ptr_; 
-	o_ptr_ = rhs.o_ptr_; 
-	h_ptr_ = rhs.h_ptr_; 
-	l_ptr_ = rhs.l_ptr_; 
-	c_ptr_ = rhs.c_ptr_; 
+	block_ = rhs.block_; 
 	v_ = rhs.v_; 
-	b_ptr_ = rhs.b_ptr_;
-	a_ptr_ = rhs.a_ptr_; 
 }
 //Destructor 
 
 std::shared_ptr<Datetime> CandlePtr::dt() const{
-	return dt_ptr_; 
+	//aliasing constructor: points at the datetime & shares ownership of the block 
+	return std::shared_ptr<Datetime>(block_, &block_->dt); 
 }
 double CandlePtr::o() const{
-	return *o_ptr_; 
+	return block_->o; 
 }
 double CandlePtr::h() const{
-	return *h_ptr_; 
+	return block_->h; 
 }
 double CandlePtr::l() const{
-	return *l_ptr_; 
+	return block_->l; 
 }
 double CandlePtr::c() const{
-	return *c_ptr_; 
+	return block_->c; 
 }
 double CandlePtr::v() const{
 	return v_; 
 }
 double CandlePtr::b() const{
-	return *b_ptr_; 
+	return block_->b; 
 }
 double CandlePtr::a() const{
-	return *a_ptr_; 
+	return block_->a; 
 }
 
 double CandlePtr::hl2() const{
-	//dereference the ptrs and return hl2 price
-	return (*h_ptr_ + *l_ptr_) / 2; 
+	return (block_->h + block_->l) / 2; 
 }
 double CandlePtr::oc2() const{
-	//deref and return oc2 price
-	return (*o_ptr_ + *c_ptr_) / 2; 
+	return (block_->o + block_->c) / 2; 
 }
 double CandlePtr::hlc3() const{
-	return (*h_ptr_ + *l_ptr_ + *c_ptr_) / 3; 
+	return (block_->h + block_->l + block_->c) / 3; 
 }
 double CandlePtr::ohlc4() const{
-	return (*o_ptr_ + *h_ptr_ + *l_ptr_ + *c_ptr_) / 4; 
+	return (block_->o + block_->h + block_->l + block_->c) / 4; 
 }
 //compute & return high minus low 
 double CandlePtr::hml() const{
-	return *h_ptr_ - *l_ptr_;  
+	return block_->h - block_->l;  
 }
-//bull and bear boolean functions 
 //Move Assignment Operator 
 CandlePtr& CandlePtr::operator=(CandlePtr &&rhs){
-	dt_ptr_ = std::make_shared<Datetime>(std::move(*rhs.dt_ptr_)); 
-	o_ptr_ = std::make_shared<double>(std::move(*rhs.o_ptr_)); 
-	h_ptr_ = std::make_shared<double>(std::move(*rhs.h_ptr_)); 
-	l_ptr_ = std::make_shared<double>(std::move(*rhs.l_ptr_)); 
-	c_ptr_ = std::make_shared<double>(std::move(*rhs.c_ptr_)); 
+	block_ = rhs.block_; 
 	v_ = std::move(rhs.v_); 
-	b_ptr_ = std::make_shared<double>(std::move(*rhs.b_ptr_)); 
-	a_ptr_ = std::make_shared<double>(std::move(*rhs.a_ptr_)); 
 	return *this; 
 }
 //Copy Assignement Operator 
 CandlePtr& CandlePtr::operator=(const CandlePtr &rhs){
-	//std::cout << "Copy Assignement Operator for CandlePtr Called" << std::endl; 
-	dt_ptr_ = rhs.dt_ptr_; 
-	o_ptr_ = rhs.o_ptr_; 
-	h_ptr_ = rhs.h_ptr_; 
-	l_ptr_ = rhs.l_ptr_; 
-	c_ptr_ = rhs.c_ptr_; 
+	block_ = rhs.block_; 
 	v_ = rhs.v_; 
-	b_ptr_ = rhs.b_ptr_;
-	a_ptr_ = rhs.a_ptr_; 
 	return *this; 	
 }
 //Display function
 void CandlePtr::display() const{
-	(this->dt())->display(); 	
-	std::cout << " Open: " << *o_ptr_ << " High: " << *h_ptr_; 
-	std::cout << " Low: " << *l_ptr_ << " Close: " << *c_ptr_; 
-	std::cout << " Volume: " << v_ << " Bid: " << *b_ptr_; 
-	std::cout << " Ask: " << *a_ptr_ << std::endl; 	
+	block_->dt.display(); 	
+	std::cout << " Open: " << block_->o << " High: " << block_->h; 
+	std::cout << " Low: " << block_->l << " Close: " << block_->c; 
+	std::cout << " Volume: " << v_ << " Bid: " << block_->b; 
+	std::cout << " Ask: " << block_->a << std::endl; 	
 }
 //validate function
 void CandlePtr::validate_() const{
-	if(*h_ptr_ < *l_ptr_ || *h_ptr_ < *c_ptr_ || *h_ptr_ < *o_ptr_ || *l_ptr_ > *c_ptr_ || *l_ptr_ > *o_ptr_ || v_ < 0){
+	const Block& k = *block_; 
+	if(k.h < k.l || k.h < k.c || k.h < k.o || k.l > k.c || k.l > k.o || v_ < 0){
 		/*invalid candles have either negative volume or 
 		highs that are not larger than o, l, c or lows not less 
 		than o, c, h*/ 
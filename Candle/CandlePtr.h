@@ -4,14 +4,16 @@
 #include "../Datetime/Datetime.h" 
 class CandlePtr{
 	public:
-		CandlePtr(const Datetime& dt, const double& o, const double& h, const double& l, const double& c, double&& v, const double& b, const double& a);
+		//validate = false skips the per object check (for candles from a store which was already validated, see CandleSeries::validate)
+		CandlePtr(const Datetime& dt, const double& o, const double& h, const double& l, const double& c, double&& v, const double& b, const double& a, 
+				bool validate = true);
 		//Move Constructor 
 		CandlePtr(CandlePtr &&rhs); 
 		//Copy Constructor 
 		CandlePtr(const CandlePtr &rhs);
 		//Destructor (Use compiler Default) 
 		~CandlePtr() = default; 
-		//accessors
+		//accessors (dt shares ownership of the candle's block) 
 		std::shared_ptr<Datetime> dt() const;
 		double o() const; 
 		double h() const; 
@@ -33,13 +35,17 @@ class CandlePtr{
 		//Copy assignement operator
 		CandlePtr& operator=(const CandlePtr &rhs); 
 	private:
-		std::shared_ptr<Datetime> dt_ptr_; 
-		std::shared_ptr<double> o_ptr_; 
-		std::shared_ptr<double> h_ptr_; 
-		std::shared_ptr<double> l_ptr_; 
-		std::shared_ptr<double> c_ptr_;
-		std::shared_ptr<double> b_ptr_; 
-		std::shared_ptr<double> a_ptr_; 
+		//the shared fields live in a single allocation (one control block & one refcount per copy) 
+		struct Block{
+			Datetime dt; 
+			double o; 
+			double h; 
+			double l; 
+			double c; 
+			double b; 
+			double a; 
+		}; 
+		std::shared_ptr<Block> block_; 
 		double v_; 
 		//validate function 
 		void validate_() const; 
@@ -0,0 +1,66 @@
+#include "CandleView.h"
+
+CandleView::CandleView(const CandleColumnPtrs* cols, std::size_t i) : cols_{cols}, i_{i} {};
+
+//Accessors
+Datetime CandleView::dt() const{
+	return Datetime(std::chrono::sys_seconds{std::chrono::seconds{cols_->dt[i_]}}, cols_->tmz);
+}
+std::int64_t CandleView::epoch() const{
+	return cols_->dt[i_];
+}
+double CandleView::o() const{
+	return cols_->o[i_];
+}
+double CandleView::h() const{
+	return cols_->h[i_];
+}
+double CandleView::l() const{
+	return cols_->l[i_];
+}
+double CandleView::c() const{
+	return cols_->c[i_];
+}
+double CandleView::v() const{
+	return cols_->v[i_];
+}
+double CandleView::b() const{
+	return cols_->b[i_];
+}
+double CandleView::a() const{
+	return cols_->a[i_];
+}
+
+//alternate price types
+double CandleView::hl2() const{
+	return (h() + l()) / 2;
+}
+double CandleView::oc2() const{
+	return (o() + c()) / 2;
+}
+double CandleView::hlc3() const{
+	return (h() + l() + c()) / 3;
+}
+double CandleView::ohlc4() const{
+	return (o() + h() + l() + c()) / 4;
+}
+double CandleView::hml() const{
+	return h() - l();
+}
+
+void CandleView::display() const{
+	this->dt().display();
+	std::cout << " Open: " << this->o() << " High: " << this->h();
+	std::cout << " Low: " << this->l() << " Close: " << this->c();
+	std::cout << " Volume: " << this->v() << " Bid: ";
+	std::cout << this->b() << " Ask: " << this->a() << std::endl;
+}
+std::size_t CandleView::index() const{
+	return i_;
+}
+Candle CandleView::candle() const{
+	return Candle(dt(), o(), h(), l(), c(), v(), b(), a());
+}
+CandleViewIterator CandleView::operator&() const{
+	return CandleViewIterator(cols_, i_);
+}
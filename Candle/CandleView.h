@@ -0,0 +1,97 @@
+#pragma once
+#include "Candle.h"
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+//pointers to the columns of a structure of arrays candle series (see CandleSeries/CandleColumns.h)
+struct CandleColumnPtrs{
+	//seconds since the unix epoch (utc)
+	const std::int64_t* dt = nullptr;
+	const double* o = nullptr;
+	const double* h = nullptr;
+	const double* l = nullptr;
+	const double* c = nullptr;
+	const double* v = nullptr;
+	const double* b = nullptr;
+	const double* a = nullptr;
+	//time zone used when constructing Datetime objects from dt
+	const std::chrono::time_zone* tmz = nullptr;
+};
+
+class CandleViewIterator;
+
+//Non-owning view of the candle at position i of a columnar candle series. Has the same accessors as Candle so that the
+//tech_ind and cand_pat templates accept it (copying a view copies a pointer and an index)
+class CandleView{
+	public:
+		CandleView(const CandleColumnPtrs* cols, std::size_t i);
+		//accessors
+		Datetime dt() const;
+		//seconds since the unix epoch (no Datetime is constructed)
+		std::int64_t epoch() const;
+		double o() const;
+		double h() const;
+		double l() const;
+		double c() const;
+		double v() const;
+		double b() const;
+		double a() const;
+		//compute alternate price types
+		double hl2() const;
+		double oc2() const;
+		double hlc3() const;
+		double ohlc4() const;
+		//compute high minus low
+		double hml() const;
+		//Display Function
+		void display() const;
+		//position of the candle in the series
+		std::size_t index() const;
+		//materialize the candle
+		Candle candle() const;
+		//the tech_ind templates recover positions with std::distance(&(*first1), &c)
+		//==> taking the address of a CandleView returns an iterator to the candle it refers to
+		CandleViewIterator operator&() const;
+	private:
+		const CandleColumnPtrs* cols_;
+		std::size_t i_;
+};
+
+//random access iterator over a columnar candle series (dereferences to a CandleView by value)
+class CandleViewIterator{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = CandleView;
+		using difference_type = std::ptrdiff_t;
+		using reference = CandleView;
+		//operator-> returns an object holding the CandleView so that it->c() works
+		struct pointer{
+			CandleView ref;
+			const CandleView* operator->() const{ return std::addressof(ref); }
+		};
+		CandleViewIterator() = default;
+		CandleViewIterator(const CandleColumnPtrs* cols, std::size_t i) : cols_{cols}, i_{i} {};
+		reference operator*() const{ return CandleView(cols_, i_); }
+		pointer operator->() const{ return pointer{CandleView(cols_, i_)}; }
+		reference operator[](difference_type n) const{ return CandleView(cols_, i_ + n); }
+		CandleViewIterator& operator++(){ ++i_; return *this; }
+		CandleViewIterator operator++(int){ CandleViewIterator tmp = *this; ++i_; return tmp; }
+		CandleViewIterator& operator--(){ --i_; return *this; }
+		CandleViewIterator operator--(int){ CandleViewIterator tmp = *this; --i_; return tmp; }
+		CandleViewIterator& operator+=(difference_type n){ i_ += n; return *this; }
+		CandleViewIterator& operator-=(difference_type n){ i_ -= n; return *this; }
+		friend CandleViewIterator operator+(CandleViewIterator it, difference_type n){ return it += n; }
+		friend CandleViewIterator operator+(difference_type n, CandleViewIterator it){ return it += n; }
+		friend CandleViewIterator operator-(CandleViewIterator it, difference_type n){ return it -= n; }
+		friend difference_type operator-(const CandleViewIterator& lhs, const CandleViewIterator& rhs){
+			return static_cast<difference_type>(lhs.i_) - static_cast<difference_type>(rhs.i_);
+		}
+		friend bool operator==(const CandleViewIterator& lhs, const CandleViewIterator& rhs){ return lhs.i_ == rhs.i_; }
+		friend auto operator<=>(const CandleViewIterator& lhs, const CandleViewIterator& rhs){ return lhs.i_ <=> rhs.i_; }
+		std::size_t index() const{ return i_; }
+	private:
+		const CandleColumnPtrs* cols_ = nullptr;
+		std::size_t i_ = 0;
+};
@@ -0,0 +1,45 @@
+#include "PriceField.h"
+#include <stdexcept>
+
+PriceField price_field::from_string(const std::string& pt){
+	if(pt == "open" || pt == "o"){
+		return PriceField::open;
+	}else if(pt == "high" || pt == "h"){
+		return PriceField::high;
+	}else if(pt == "low" || pt == "l"){
+		return PriceField::low;
+	}else if(pt == "close" || pt == "c"){
+		return PriceField::close;
+	}else if(pt == "hl2"){
+		return PriceField::hl2;
+	}else if(pt == "oc2"){
+		return PriceField::oc2;
+	}else if(pt == "hlc3"){
+		return PriceField::hlc3;
+	}else if(pt == "ohlc4"){
+		return PriceField::ohlc4;
+	}else if(pt == "volume" || pt == "v"){
+		return PriceField::volume;
+	}else if(pt == "bid" || pt == "b"){
+		return PriceField::bid;
+	}else if(pt == "ask" || pt == "a"){
+		return PriceField::ask;
+	}
+	throw std::invalid_argument("price_field::from_string: Enter a valid price type.");
+}
+
+std::string price_field::to_string(PriceField pf){
+	switch(pf){
+		case PriceField::open: return "open";
+		case PriceField::high: return "high";
+		case PriceField::low: return "low";
+		case PriceField::close: return "close";
+		case PriceField::hl2: return "hl2";
+		case PriceField::oc2: return "oc2";
+		case PriceField::hlc3: return "hlc3";
+		case PriceField::ohlc4: return "ohlc4";
+		case PriceField::volume: return "volume";
+		case PriceField::bid: return "bid";
+		default: return "ask";
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <string>
+#include <type_traits>
+#include <utility>
+
+//price fields of a candle like object (Candle, CandlePtr, CandleView)
+enum class PriceField{open, high, low, close, hl2, oc2, hlc3, ohlc4, volume, bid, ask};
+
+namespace price_field{
+	//map a price type string to a PriceField ("open" or "o", "high" or "h", ..., "hl2", "oc2", "hlc3", "ohlc4", "volume" or "v", "bid" or "b", "ask" or "a")
+	//throws std::invalid_argument for any other string
+	PriceField from_string(const std::string& pt);
+	std::string to_string(PriceField pf);
+	//project a candle onto the price field F (resolved at compile time so loops over candles have no branches)
+	template <PriceField F, typename C>
+	double project(const C& c);
+	//call f(std::integral_constant<PriceField, pf>{}) ==> a runtime PriceField is dispatched once to a compile time one
+	template <typename Fn>
+	decltype(auto) visit(PriceField pf, Fn&& f);
+}
+
+template <PriceField F, typename C>
+double price_field::project(const C& c){
+	if constexpr(F == PriceField::open){
+		return c.o();
+	}else if constexpr(F == PriceField::high){
+		return c.h();
+	}else if constexpr(F == PriceField::low){
+		return c.l();
+	}else if constexpr(F == PriceField::close){
+		return c.c();
+	}else if constexpr(F == PriceField::hl2){
+		return (c.h() + c.l()) / 2;
+	}else if constexpr(F == PriceField::oc2){
+		return (c.o() + c.c()) / 2;
+	}else if constexpr(F == PriceField::hlc3){
+		return (c.h() + c.l() + c.c()) / 3;
+	}else if constexpr(F == PriceField::ohlc4){
+		return (c.o() + c.h() + c.l() + c.c()) / 4;
+	}else if constexpr(F == PriceField::volume){
+		return c.v();
+	}else if constexpr(F == PriceField::bid){
+		return c.b();
+	}else{
+		return c.a();
+	}
+}
+
+template <typename Fn>
+decltype(auto) price_field::visit(PriceField pf, Fn&& f){
+	switch(pf){
+		case PriceField::open: return f(std::integral_constant<PriceField, PriceField::open>{});
+		case PriceField::high: return f(std::integral_constant<PriceField, PriceField::high>{});
+		case PriceField::low: return f(std::integral_constant<PriceField, PriceField::low>{});
+		case PriceField::close: return f(std::integral_constant<PriceField, PriceField::close>{});
+		case PriceField::hl2: return f(std::integral_constant<PriceField, PriceField::hl2>{});
+		case PriceField::oc2: return f(std::integral_constant<PriceField, PriceField::oc2>{});
+		case PriceField::hlc3: return f(std::integral_constant<PriceField, PriceField::hlc3>{});
+		case PriceField::ohlc4: return f(std::integral_constant<PriceField, PriceField::ohlc4>{});
+		case PriceField::volume: return f(std::integral_constant<PriceField, PriceField::volume>{});
+		case PriceField::bid: return f(std::integral_constant<PriceField, PriceField::bid>{});
+		default: return f(std::integral_constant<PriceField, PriceField::ask>{});
+	}
+}
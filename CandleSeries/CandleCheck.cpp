@@ -0,0 +1,103 @@
+#include "CandleCheck.h"
+#include <algorithm>
+#include <bit>
+#include <iostream>
+#include <stdexcept>
+
+std::string candle_check::rule_name(Rule r){
+	switch(r){
+		case high: return "high";
+		case low: return "low";
+		case volume: return "volume";
+		case spread: return "spread";
+		case order: return "order";
+	}
+	throw std::invalid_argument("rule_name: Unknown rule");
+}
+
+bool candle_check::Report::ok() const{
+	return n_bad == 0;
+}
+std::size_t candle_check::Report::count(Rule r) const{
+	return counts[std::countr_zero(unsigned(r))];
+}
+void candle_check::Report::display() const{
+	std::cout << "Checked " << n << " candles, " << n_bad << " invalid" << std::endl;
+	for(std::size_t k = 0; k < n_rules; k++){
+		if(counts[k] > 0){
+			std::cout << " " << rule_name(Rule(1 << k)) << ": " << counts[k] << std::endl;
+		}
+	}
+	for(const auto& [i, mask] : examples){
+		std::cout << " candle " << i << ":";
+		for(std::size_t k = 0; k < n_rules; k++){
+			if(mask & (1 << k)){
+				std::cout << " " << rule_name(Rule(1 << k));
+			}
+		}
+		std::cout << std::endl;
+	}
+}
+
+candle_check::Report candle_check::validate(const CandleColumns& cols, std::uint8_t rules, std::size_t max_examples){
+	return validate(cols.dt(), cols.o(), cols.h(), cols.l(), cols.c(), cols.v(), cols.b(), cols.a(), rules, max_examples);
+}
+
+candle_check::Report candle_check::validate(std::span<const std::int64_t> dt, std::span<const double> o, std::span<const double> h, 
+		std::span<const double> l, std::span<const double> c, std::span<const double> v, std::span<const double> b, std::span<const double> a, 
+		std::uint8_t rules, std::size_t max_examples){
+	std::size_t n = dt.size();
+	if(o.size() != n || h.size() != n || l.size() != n || c.size() != n || v.size() != n || b.size() != n || a.size() != n){
+		throw std::invalid_argument("validate: the columns must have the same size");
+	}
+	Report rep;
+	rep.n = n;
+	constexpr std::size_t chunk = 1024;
+	std::uint8_t mask[chunk];
+	for(std::size_t s = 0; s < n; s += chunk){
+		std::size_t m = std::min(chunk, n - s);
+		const double* po = o.data() + s;
+		const double* ph = h.data() + s;
+		const double* pl = l.data() + s;
+		const double* pc = c.data() + s;
+		const double* pv = v.data() + s;
+		const double* pb = b.data() + s;
+		const double* pa = a.data() + s;
+		const std::int64_t* pd = dt.data() + s;
+		//branch free: every comparison is evaluated & the results are combined with bit operations (the loop vectorizes)
+		std::uint8_t any = 0;
+		for(std::size_t i = 0; i < m; i++){
+			std::uint8_t r = std::uint8_t(!(ph[i] >= po[i] && ph[i] >= pc[i] && ph[i] >= pl[i])) * high
+				| std::uint8_t(!(pl[i] <= po[i] && pl[i] <= pc[i])) * low
+				| std::uint8_t(!(pv[i] >= 0)) * volume
+				| std::uint8_t(!(pb[i] <= pa[i])) * spread;
+			mask[i] = r & rules;
+			any |= mask[i];
+		}
+		if(rules & order){
+			//the first candle of the chunk is compared with the last candle of the previous chunk
+			std::size_t i0 = s == 0 ? 1 : 0;
+			for(std::size_t i = i0; i < m; i++){
+				std::uint8_t r = std::uint8_t(pd[i] <= pd[i - 1]) * order;
+				mask[i] |= r;
+				any |= r;
+			}
+		}
+		if(any == 0){
+			continue;
+		}
+		for(std::size_t i = 0; i < m; i++){
+			if(mask[i] == 0){
+				continue;
+			}
+			rep.n_bad++;
+			for(std::size_t k = 0; k < n_rules; k++){
+				rep.counts[k] += (mask[i] >> k) & 1;
+			}
+			if(rep.examples.size() < max_examples){
+				rep.examples.emplace_back(s + i, mask[i]);
+			}
+		}
+	}
+	return rep;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "CandleColumns.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+//Bulk validation of the candle invariants over whole columns (replaces checking the candles one object at a time)
+//the columns are checked in fixed size chunks with branch free loops which compute a bit mask of the broken rules for every candle,
+//positions are only recorded for the (rare) chunks which contain a violation
+namespace candle_check{
+	//rules (bit flags) (a comparison with a NaN counts as a violation)
+	enum Rule : std::uint8_t{
+		//h >= max(o, c) & h >= l
+		high = 1, 
+		//l <= min(o, c)
+		low = 2, 
+		//v >= 0
+		volume = 4, 
+		//b <= a
+		spread = 8, 
+		//dt is strictly increasing
+		order = 16
+	};
+	inline constexpr std::size_t n_rules = 5;
+	std::string rule_name(Rule r);
+
+	//compact summary of a validation pass
+	struct Report{
+		//number of candles checked
+		std::size_t n = 0;
+		//number of candles which break each rule (indexed by the bit position of the rule)
+		std::array<std::size_t, n_rules> counts{};
+		//number of candles which break at least one rule
+		std::size_t n_bad = 0;
+		//the first violations (position & mask of the broken rules), at most max_examples are kept
+		std::vector<std::pair<std::size_t, std::uint8_t>> examples;
+		bool ok() const;
+		std::size_t count(Rule r) const;
+		void display() const;
+	};
+
+	//check every candle in cols (rules is a mask of the rules to check)
+	Report validate(const CandleColumns& cols, std::uint8_t rules = 31, std::size_t max_examples = 16);
+	Report validate(std::span<const std::int64_t> dt, std::span<const double> o, std::span<const double> h, std::span<const double> l, 
+			std::span<const double> c, std::span<const double> v, std::span<const double> b, std::span<const double> a, 
+			std::uint8_t rules = 31, std::size_t max_examples = 16);
+}
@@ -0,0 +1,179 @@
+#include "CandleCodec.h"
+#include <algorithm>
+#include <bit>
+
+namespace{
+	std::uint64_t mask(unsigned n){
+		return n >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << n) - 1;
+	}
+}
+
+//BitWriter
+void candle_codec::BitWriter::put(std::uint64_t v, unsigned n){
+	if(n == 0){
+		return;
+	}
+	if(n > 32){
+		put(v >> 32, n - 32);
+		n = 32;
+	}
+	//acc_ holds at most 7 + 32 live bits
+	acc_ = (acc_ << n) | (v & mask(n));
+	n_acc_ += n;
+	while(n_acc_ >= 8){
+		n_acc_ -= 8;
+		buf_.push_back(static_cast<unsigned char>(acc_ >> n_acc_));
+	}
+}
+std::vector<unsigned char> candle_codec::BitWriter::finish(){
+	if(n_acc_ > 0){
+		buf_.push_back(static_cast<unsigned char>(acc_ << (8 - n_acc_)));
+		n_acc_ = 0;
+	}
+	acc_ = 0;
+	return std::move(buf_);
+}
+
+//BitReader
+candle_codec::BitReader::BitReader(std::span<const unsigned char> data) : data_{data} {};
+std::uint64_t candle_codec::BitReader::get(unsigned n){
+	if(n == 0){
+		return 0;
+	}
+	if(n > 32){
+		std::uint64_t hi = get(n - 32);
+		return (hi << 32) | get(32);
+	}
+	while(n_acc_ < n){
+		unsigned char byte = 0;
+		if(pos_ < data_.size()){
+			byte = data_[pos_];
+		}else{
+			overrun_ = true;
+		}
+		pos_++;
+		acc_ = (acc_ << 8) | byte;
+		n_acc_ += 8;
+	}
+	n_acc_ -= n;
+	return (acc_ >> n_acc_) & mask(n);
+}
+bool candle_codec::BitReader::overrun() const{
+	return overrun_;
+}
+
+//datetimes
+void candle_codec::encode_dt(std::span<const std::int64_t> dt, BitWriter& w){
+	if(dt.empty()){
+		return;
+	}
+	w.put(static_cast<std::uint64_t>(dt[0]), 64);
+	if(dt.size() == 1){
+		return;
+	}
+	std::int64_t prev_delta = dt[1] - dt[0];
+	w.put(static_cast<std::uint64_t>(prev_delta), 64);
+	for(std::size_t i = 2; i < dt.size(); i++){
+		std::int64_t delta = dt[i] - dt[i - 1];
+		std::int64_t dod = delta - prev_delta;
+		prev_delta = delta;
+		if(dod == 0){
+			w.put(0, 1);
+		}else if(dod >= -63 && dod <= 64){
+			w.put(0b10, 2);
+			w.put(static_cast<std::uint64_t>(dod + 63), 7);
+		}else if(dod >= -255 && dod <= 256){
+			w.put(0b110, 3);
+			w.put(static_cast<std::uint64_t>(dod + 255), 9);
+		}else if(dod >= -2047 && dod <= 2048){
+			w.put(0b1110, 4);
+			w.put(static_cast<std::uint64_t>(dod + 2047), 12);
+		}else{
+			w.put(0b1111, 4);
+			w.put(static_cast<std::uint64_t>(dod), 64);
+		}
+	}
+}
+void candle_codec::decode_dt(BitReader& r, std::size_t n, std::int64_t* out){
+	if(n == 0){
+		return;
+	}
+	out[0] = static_cast<std::int64_t>(r.get(64));
+	if(n == 1){
+		return;
+	}
+	std::int64_t delta = static_cast<std::int64_t>(r.get(64));
+	out[1] = out[0] + delta;
+	for(std::size_t i = 2; i < n; i++){
+		std::int64_t dod = 0;
+		if(r.get(1) == 0){
+			dod = 0;
+		}else if(r.get(1) == 0){
+			dod = static_cast<std::int64_t>(r.get(7)) - 63;
+		}else if(r.get(1) == 0){
+			dod = static_cast<std::int64_t>(r.get(9)) - 255;
+		}else if(r.get(1) == 0){
+			dod = static_cast<std::int64_t>(r.get(12)) - 2047;
+		}else{
+			dod = static_cast<std::int64_t>(r.get(64));
+		}
+		delta += dod;
+		out[i] = out[i - 1] + delta;
+	}
+}
+
+//doubles
+void candle_codec::encode_xor(std::span<const double> x, BitWriter& w){
+	if(x.empty()){
+		return;
+	}
+	std::uint64_t prev = std::bit_cast<std::uint64_t>(x[0]);
+	w.put(prev, 64);
+	//window of meaningful bits of the previous XOR (lead > 64 ==> no window yet)
+	unsigned lead = 65;
+	unsigned trail = 0;
+	for(std::size_t i = 1; i < x.size(); i++){
+		std::uint64_t cur = std::bit_cast<std::uint64_t>(x[i]);
+		std::uint64_t d = cur ^ prev;
+		prev = cur;
+		if(d == 0){
+			w.put(0, 1);
+			continue;
+		}
+		unsigned l = std::min(31u, static_cast<unsigned>(std::countl_zero(d)));
+		unsigned t = static_cast<unsigned>(std::countr_zero(d));
+		if(lead <= 64 && l >= lead && t >= trail){
+			//the meaningful bits fit in the previous window
+			w.put(0b10, 2);
+			w.put(d >> trail, 64 - lead - trail);
+		}else{
+			unsigned sig = 64 - l - t;
+			w.put(0b11, 2);
+			w.put(l, 5);
+			w.put(sig - 1, 6);
+			w.put(d >> t, sig);
+			lead = l;
+			trail = t;
+		}
+	}
+}
+void candle_codec::decode_xor(BitReader& r, std::size_t n, double* out){
+	if(n == 0){
+		return;
+	}
+	std::uint64_t prev = r.get(64);
+	out[0] = std::bit_cast<double>(prev);
+	unsigned lead = 0;
+	unsigned trail = 0;
+	for(std::size_t i = 1; i < n; i++){
+		if(r.get(1) == 1){
+			if(r.get(1) == 1){
+				lead = static_cast<unsigned>(r.get(5));
+				unsigned sig = static_cast<unsigned>(r.get(6)) + 1;
+				trail = 64 - lead - sig;
+			}
+			prev ^= r.get(64 - lead - trail) << trail;
+		}
+		out[i] = std::bit_cast<double>(prev);
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+//Lossless bit level codecs for the candle columns (used by CompressedCandleFile)
+//datetimes: the first value & first delta are stored in full, then the delta of delta of each datetime in a variable length
+//code (a regular grid costs one bit per candle)
+//doubles: XOR with the previous value (Gorilla), only the meaningful bits of the XOR are stored (a repeated value costs one bit)
+namespace candle_codec{
+	//appends bits (most significant bit first) to a byte buffer
+	class BitWriter{
+		public:
+			//append the n (<= 64) low bits of v
+			void put(std::uint64_t v, unsigned n);
+			//pad the last byte with zeros & return the buffer
+			std::vector<unsigned char> finish();
+		private:
+			std::vector<unsigned char> buf_;
+			std::uint64_t acc_ = 0;
+			unsigned n_acc_ = 0;
+	};
+	//reads the bits written by a BitWriter
+	class BitReader{
+		public:
+			BitReader(std::span<const unsigned char> data);
+			//read n (<= 64) bits
+			std::uint64_t get(unsigned n);
+			//true if more bits were read than the buffer holds
+			bool overrun() const;
+		private:
+			std::span<const unsigned char> data_;
+			std::size_t pos_ = 0;
+			std::uint64_t acc_ = 0;
+			unsigned n_acc_ = 0;
+			bool overrun_ = false;
+	};
+	void encode_dt(std::span<const std::int64_t> dt, BitWriter& w);
+	//decode n datetimes to out[0, n)
+	void decode_dt(BitReader& r, std::size_t n, std::int64_t* out);
+	void encode_xor(std::span<const double> x, BitWriter& w);
+	void decode_xor(BitReader& r, std::size_t n, double* out);
+}
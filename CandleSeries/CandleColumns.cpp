@@ -0,0 +1,185 @@
+#include "CandleColumns.h"
+#include "CandleFile.h"
+
+//CandleColumns
+CandleColumns::CandleColumns(const std::vector<Candle>& cs){
+	reserve(cs.size());
+	if(!cs.empty()){
+		//use the time zone of the candles
+		set_tmz(cs.front().dt().zt().get_time_zone());
+	}
+	for(const Candle& c : cs){
+		push_back(c);
+	}
+}
+
+CandleColumns::CandleColumns(std::shared_ptr<const CandleFile> file) : file_{std::move(file)} {
+	tmz_ = tmz_cache::zone(file_->tz()); 
+	ptrs_ = CandleColumnPtrs{file_->dt().data(), file_->o().data(), file_->h().data(), file_->l().data(), file_->c().data(), 
+		file_->v().data(), file_->b().data(), file_->a().data(), tmz_};
+	n_ = file_->dt().size();
+}
+CandleColumns::CandleColumns(std::vector<std::int64_t> dt, std::vector<double> o, std::vector<double> h, std::vector<double> l, std::vector<double> c, 
+		std::vector<double> v, std::vector<double> b, std::vector<double> a, const std::chrono::time_zone* tmz) : tmz_{tmz}, 
+	dt_{std::move(dt)}, o_{std::move(o)}, h_{std::move(h)}, l_{std::move(l)}, c_{std::move(c)}, v_{std::move(v)}, b_{std::move(b)}, a_{std::move(a)} {
+	std::size_t n = dt_.size();
+	if(o_.size() != n || h_.size() != n || l_.size() != n || c_.size() != n || v_.size() != n || b_.size() != n || a_.size() != n){
+		throw std::invalid_argument("CandleColumns: the columns must have the same size");
+	}
+	sync_();
+}
+CandleColumns::CandleColumns(const CandleColumns& cols) : tmz_{cols.tmz_}, file_{cols.file_}, 
+	dt_{cols.dt_}, o_{cols.o_}, h_{cols.h_}, l_{cols.l_}, c_{cols.c_}, v_{cols.v_}, b_{cols.b_}, a_{cols.a_} {
+	if(file_){
+		//both objects share the (read only) mapping
+		ptrs_ = cols.ptrs_;
+		n_ = cols.n_;
+	}else{
+		sync_();
+	}
+}
+CandleColumns& CandleColumns::operator=(const CandleColumns& cols){
+	if(this != &cols){
+		CandleColumns tmp(cols);
+		*this = std::move(tmp);
+	}
+	return *this;
+}
+CandleColumns::CandleColumns(CandleColumns&& cols){
+	*this = std::move(cols);
+}
+CandleColumns& CandleColumns::operator=(CandleColumns&& cols){
+	if(this != &cols){
+		tmz_ = cols.tmz_;
+		file_ = std::move(cols.file_);
+		//moving the vectors keeps their buffers so the pointers stay valid
+		dt_ = std::move(cols.dt_); o_ = std::move(cols.o_); h_ = std::move(cols.h_); l_ = std::move(cols.l_);
+		c_ = std::move(cols.c_); v_ = std::move(cols.v_); b_ = std::move(cols.b_); a_ = std::move(cols.a_);
+		ptrs_ = cols.ptrs_;
+		n_ = cols.n_;
+		//leave cols empty
+		cols.clear();
+	}
+	return *this;
+}
+
+void CandleColumns::sync_(){
+	ptrs_ = CandleColumnPtrs{dt_.data(), o_.data(), h_.data(), l_.data(), c_.data(), v_.data(), b_.data(), a_.data(), tmz_};
+	n_ = dt_.size();
+}
+void CandleColumns::own_(){
+	if(!file_){
+		return;
+	}
+	dt_.assign(ptrs_.dt, ptrs_.dt + n_);
+	o_.assign(ptrs_.o, ptrs_.o + n_);
+	h_.assign(ptrs_.h, ptrs_.h + n_);
+	l_.assign(ptrs_.l, ptrs_.l + n_);
+	c_.assign(ptrs_.c, ptrs_.c + n_);
+	v_.assign(ptrs_.v, ptrs_.v + n_);
+	b_.assign(ptrs_.b, ptrs_.b + n_);
+	a_.assign(ptrs_.a, ptrs_.a + n_);
+	file_.reset();
+	sync_();
+}
+
+void CandleColumns::reserve(std::size_t n){
+	own_();
+	dt_.reserve(n);
+	o_.reserve(n);
+	h_.reserve(n);
+	l_.reserve(n);
+	c_.reserve(n);
+	v_.reserve(n);
+	b_.reserve(n);
+	a_.reserve(n);
+	sync_();
+}
+void CandleColumns::push_back(const Candle& c){
+	push_back(c.dt().epoch(), c.o(), c.h(), c.l(), c.c(), c.v(), c.b(), c.a());
+}
+void CandleColumns::push_back(std::int64_t dt, double o, double h, double l, double c, double v, double b, double a){
+	own_();
+	dt_.push_back(dt);
+	o_.push_back(o);
+	h_.push_back(h);
+	l_.push_back(l);
+	c_.push_back(c);
+	v_.push_back(v);
+	b_.push_back(b);
+	a_.push_back(a);
+	n_++;
+	//the pointers only change when a column was reallocated
+	if(ptrs_.dt != dt_.data() || ptrs_.o != o_.data() || ptrs_.h != h_.data() || ptrs_.l != l_.data() || 
+			ptrs_.c != c_.data() || ptrs_.v != v_.data() || ptrs_.b != b_.data() || ptrs_.a != a_.data()){
+		sync_();
+	}
+}
+void CandleColumns::clear(){
+	file_.reset();
+	dt_.clear();
+	o_.clear();
+	h_.clear();
+	l_.clear();
+	c_.clear();
+	v_.clear();
+	b_.clear();
+	a_.clear();
+	sync_();
+}
+void CandleColumns::set_tmz(const std::chrono::time_zone* tmz){
+	tmz_ = tmz;
+	ptrs_.tmz = tmz;
+}
+const std::chrono::time_zone* CandleColumns::tmz() const{
+	return tmz_;
+}
+std::size_t CandleColumns::size() const{
+	return n_;
+}
+bool CandleColumns::empty() const{
+	return n_ == 0;
+}
+bool CandleColumns::mapped() const{
+	return static_cast<bool>(file_);
+}
+
+//column accessors
+std::span<const std::int64_t> CandleColumns::dt() const{
+	return {ptrs_.dt, n_};
+}
+std::span<const double> CandleColumns::o() const{
+	return {ptrs_.o, n_};
+}
+std::span<const double> CandleColumns::h() const{
+	return {ptrs_.h, n_};
+}
+std::span<const double> CandleColumns::l() const{
+	return {ptrs_.l, n_};
+}
+std::span<const double> CandleColumns::c() const{
+	return {ptrs_.c, n_};
+}
+std::span<const double> CandleColumns::v() const{
+	return {ptrs_.v, n_};
+}
+std::span<const double> CandleColumns::b() const{
+	return {ptrs_.b, n_};
+}
+std::span<const double> CandleColumns::a() const{
+	return {ptrs_.a, n_};
+}
+
+CandleColumns::CandleRef CandleColumns::operator[](std::size_t i) const{
+	return CandleRef(&ptrs_, i);
+}
+CandleColumns::const_iterator CandleColumns::begin() const{
+	return const_iterator(&ptrs_, 0);
+}
+CandleColumns::const_iterator CandleColumns::end() const{
+	return const_iterator(&ptrs_, n_);
+}
+Candle CandleColumns::candle(std::size_t i) const{
+	return Candle(Datetime(std::chrono::sys_seconds{std::chrono::seconds{ptrs_.dt[i]}}, tmz_),
+			double(ptrs_.o[i]), double(ptrs_.h[i]), double(ptrs_.l[i]), double(ptrs_.c[i]), double(ptrs_.v[i]), double(ptrs_.b[i]), double(ptrs_.a[i]));
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include "../Candle/Candle.h"
+#include "../Candle/CandleView.h"
+#include "../Candle/PriceField.h"
+#include <vector>
+#include <algorithm>
+#include <span>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+
+class CandleFile;
+
+//Structure of arrays storage for a candle series. Each price field is stored in its own contiguous array of doubles
+//and the datetimes are stored in one contiguous array of seconds since the unix epoch (utc).
+//Datetime objects are only constructed (in the time zone tmz_) when a datetime is requested through a CandleView
+//The columns are either owned (std::vectors) or served directly from a memory mapped binary candle file (see CandleFile.h).
+//Mapped columns are read only, modifying them first copies the columns into owned storage
+class CandleColumns{
+	public:
+		//non-owning view of one candle & iterator over the candles (see Candle/CandleView.h)
+		using CandleRef = CandleView;
+		using const_iterator = CandleViewIterator;
+
+		CandleColumns() = default;
+		//construct the columns from a vector of candles
+		CandleColumns(const std::vector<Candle>& cs);
+		//serve the columns from a mapped candle file (no copies are made)
+		CandleColumns(std::shared_ptr<const CandleFile> file);
+		//take ownership of decoded columns (throws if the columns have different sizes)
+		CandleColumns(std::vector<std::int64_t> dt, std::vector<double> o, std::vector<double> h, std::vector<double> l, std::vector<double> c, 
+				std::vector<double> v, std::vector<double> b, std::vector<double> a, const std::chrono::time_zone* tmz);
+		//copy constructor & assignment (the views must point at the new object's storage)
+		CandleColumns(const CandleColumns& cols);
+		CandleColumns& operator=(const CandleColumns& cols);
+		CandleColumns(CandleColumns&& cols);
+		CandleColumns& operator=(CandleColumns&& cols);
+		//modifiers
+		void reserve(std::size_t n);
+		void push_back(const Candle& c);
+		void push_back(std::int64_t dt, double o, double h, double l, double c, double v, double b, double a);
+		void clear();
+		//time zone used when constructing Datetime objects from the epoch column
+		void set_tmz(const std::chrono::time_zone* tmz);
+		const std::chrono::time_zone* tmz() const;
+		std::size_t size() const;
+		bool empty() const;
+		//true if the columns are served from a mapped file
+		bool mapped() const;
+		//contiguous columns (for kernels which can operate directly on spans)
+		std::span<const std::int64_t> dt() const;
+		std::span<const double> o() const;
+		std::span<const double> h() const;
+		std::span<const double> l() const;
+		std::span<const double> c() const;
+		std::span<const double> v() const;
+		std::span<const double> b() const;
+		std::span<const double> a() const;
+		//element access & iterators
+		CandleRef operator[](std::size_t i) const;
+		const_iterator begin() const;
+		const_iterator end() const;
+		//materialize the candle at position i
+		Candle candle(std::size_t i) const;
+		//write the price field F of every candle to out (out.size() must be size()), works on the raw columns so the loop vectorizes
+		template <PriceField F>
+		void project(std::span<double> out) const;
+	private:
+		const std::chrono::time_zone* tmz_ = std::chrono::current_zone();
+		//keeps the mapping alive while the columns refer to it
+		std::shared_ptr<const CandleFile> file_;
+		//raw column pointers (either the owned vectors or the mapped file) shared by the views & iterators handed out by this object
+		CandleColumnPtrs ptrs_;
+		//number of candles in the columns
+		std::size_t n_ = 0;
+		//point ptrs_ at the owned vectors (only needed when a vector was reallocated)
+		void sync_();
+		//copy mapped columns into the owned vectors
+		void own_();
+		//owned storage
+		std::vector<std::int64_t> dt_;
+		std::vector<double> o_;
+		std::vector<double> h_;
+		std::vector<double> l_;
+		std::vector<double> c_;
+		std::vector<double> v_;
+		std::vector<double> b_;
+		std::vector<double> a_;
+};
+
+template <PriceField F>
+void CandleColumns::project(std::span<double> out) const{
+	//inline accessors over the raw columns (CandleView's accessors are out of line)
+	struct Row{
+		const CandleColumnPtrs& p;
+		std::size_t i;
+		double o() const{ return p.o[i]; }
+		double h() const{ return p.h[i]; }
+		double l() const{ return p.l[i]; }
+		double c() const{ return p.c[i]; }
+		double v() const{ return p.v[i]; }
+		double b() const{ return p.b[i]; }
+		double a() const{ return p.a[i]; }
+	};
+	std::size_t n = std::min(out.size(), size());
+	for(std::size_t i = 0; i < n; i++){
+		out[i] = price_field::project<F>(Row{ptrs_, i});
+	}
+}
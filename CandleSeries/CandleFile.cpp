@@ -0,0 +1,240 @@
+#include "CandleFile.h"
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <filesystem>
+
+CandleFile::CandleFile(const std::string& fn) : map_{fn} {
+	if(map_.size() < header_size_){
+		throw std::runtime_error("CandleFile: " + fn + " is too small to be a candle file");
+	}
+	hdr_ = reinterpret_cast<const CandleFileHeader*>(map_.data());
+	validate_(fn);
+	//the columns are read sequentially by most consumers
+	map_.advise_sequential();
+}
+
+void CandleFile::validate_(const std::string& fn) const{
+	if(std::memcmp(hdr_->magic, magic_, sizeof(magic_)) != 0){
+		throw std::runtime_error("CandleFile: " + fn + " is not a candle file");
+	}
+	if(hdr_->version != version_){
+		throw std::runtime_error("CandleFile: " + fn + " has an unsupported version");
+	}
+	if(hdr_->endian != endian_){
+		throw std::runtime_error("CandleFile: " + fn + " was written on a machine with a different byte order");
+	}
+	if(hdr_->n > hdr_->capacity || hdr_->header_size < header_size_ || hdr_->header_size % alignof(double) != 0){
+		throw std::runtime_error("CandleFile: " + fn + " has a corrupt header");
+	}
+	std::uint64_t gap_bytes = hdr_->flags & flag_gaps_ ? gap_words_(hdr_->capacity) * sizeof(std::uint64_t) : 0;
+	if(map_.size() < hdr_->header_size + n_cols_ * hdr_->capacity * sizeof(double) + gap_bytes){
+		throw std::runtime_error("CandleFile: " + fn + " is truncated");
+	}
+}
+
+const CandleFileHeader& CandleFile::header() const{
+	return *hdr_;
+}
+std::string CandleFile::symbol() const{
+	return std::string(hdr_->symbol, strnlen(hdr_->symbol, sizeof(hdr_->symbol)));
+}
+std::string CandleFile::tz() const{
+	return std::string(hdr_->tz, strnlen(hdr_->tz, sizeof(hdr_->tz)));
+}
+
+const char* CandleFile::col_(std::size_t k) const{
+	return map_.data() + hdr_->header_size + k * hdr_->capacity * sizeof(double);
+}
+std::span<const std::int64_t> CandleFile::dt() const{
+	return std::span<const std::int64_t>(reinterpret_cast<const std::int64_t*>(col_(0)), hdr_->n);
+}
+std::span<const double> CandleFile::o() const{
+	return std::span<const double>(reinterpret_cast<const double*>(col_(1)), hdr_->n);
+}
+std::span<const double> CandleFile::h() const{
+	return std::span<const double>(reinterpret_cast<const double*>(col_(2)), hdr_->n);
+}
+std::span<const double> CandleFile::l() const{
+	return std::span<const double>(reinterpret_cast<const double*>(col_(3)), hdr_->n);
+}
+std::span<const double> CandleFile::c() const{
+	return std::span<const double>(reinterpret_cast<const double*>(col_(4)), hdr_->n);
+}
+std::span<const double> CandleFile::v() const{
+	return std::span<const double>(reinterpret_cast<const double*>(col_(5)), hdr_->n);
+}
+std::span<const double> CandleFile::b() const{
+	return std::span<const double>(reinterpret_cast<const double*>(col_(6)), hdr_->n);
+}
+std::span<const double> CandleFile::a() const{
+	return std::span<const double>(reinterpret_cast<const double*>(col_(7)), hdr_->n);
+}
+
+std::uint64_t CandleFile::gap_words_(std::uint64_t capacity){
+	return (capacity + 63) / 64;
+}
+bool CandleFile::has_gaps() const{
+	return hdr_->flags & flag_gaps_;
+}
+GapMap CandleFile::gaps() const{
+	if(!has_gaps()){
+		return GapMap();
+	}
+	const std::uint64_t* w = reinterpret_cast<const std::uint64_t*>(col_(n_cols_));
+	return GapMap(std::vector<std::uint64_t>(w, w + gap_words_(hdr_->n)), hdr_->n);
+}
+
+bool CandleFile::validated() const{
+	return hdr_->flags & flag_validated_;
+}
+
+bool CandleFile::is_candle_file(const std::string& fn){
+	std::ifstream file(fn, std::ios::binary);
+	char magic[sizeof(magic_)] = {};
+	if(!file.read(magic, sizeof(magic))){
+		return false;
+	}
+	return std::memcmp(magic, magic_, sizeof(magic_)) == 0;
+}
+
+void CandleFile::write(const std::string& fn, const CandleColumns& cols, int tf, double fidelity, std::uint64_t n_real,
+		const std::string& symbol, std::uint64_t capacity, const GapMap* gaps){
+	std::uint64_t n = cols.size();
+	if(capacity == 0){
+		capacity = n;
+	}
+	if(capacity < n){
+		throw std::invalid_argument("CandleFile::write: capacity must be at least the number of candles");
+	}
+	std::string tz(cols.tmz()->name());
+	if(symbol.size() >= sizeof(CandleFileHeader::symbol) || tz.size() >= sizeof(CandleFileHeader::tz)){
+		throw std::invalid_argument("CandleFile::write: symbol or time zone name is too long");
+	}
+	if(gaps != nullptr && gaps->size() != n){
+		throw std::invalid_argument("CandleFile::write: gaps must have one flag for each candle");
+	}
+	CandleFileHeader hdr;
+	std::memset(&hdr, 0, sizeof(hdr));
+	std::memcpy(hdr.magic, magic_, sizeof(magic_));
+	hdr.version = version_;
+	hdr.endian = endian_;
+	hdr.header_size = header_size_;
+	hdr.n = n;
+	hdr.capacity = capacity;
+	hdr.n_real = n_real;
+	hdr.fidelity = fidelity;
+	hdr.tf = tf;
+	hdr.flags = (gaps != nullptr ? flag_gaps_ : 0) | (candle_check::validate(cols, 31, 0).ok() ? flag_validated_ : 0);
+	std::memcpy(hdr.symbol, symbol.data(), symbol.size());
+	std::memcpy(hdr.tz, tz.data(), tz.size());
+
+	std::ofstream file_out(fn, std::ios::binary | std::ios::trunc);
+	if(!file_out.is_open()){
+		throw std::invalid_argument("CandleFile::write: Unable to open the output file");
+	}
+	file_out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+	//the unused part of each block is zero filled
+	std::vector<char> pad((capacity - n) * sizeof(double), 0);
+	auto write_col = [&](const auto& col){
+		file_out.write(reinterpret_cast<const char*>(col.data()), col.size_bytes());
+		file_out.write(pad.data(), pad.size());
+	};
+	write_col(cols.dt());
+	write_col(cols.o());
+	write_col(cols.h());
+	write_col(cols.l());
+	write_col(cols.c());
+	write_col(cols.v());
+	write_col(cols.b());
+	write_col(cols.a());
+	if(gaps != nullptr){
+		std::vector<std::uint64_t> words(gap_words_(capacity), 0);
+		std::copy(gaps->words().begin(), gaps->words().end(), words.begin());
+		file_out.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(std::uint64_t));
+	}
+	if(!file_out){
+		throw std::runtime_error("CandleFile::write: Error writing " + fn);
+	}
+}
+
+void CandleFile::append(const std::string& fn, const CandleColumns& tail, std::uint64_t n_real, double fidelity, const GapMap* tail_gaps){
+	CandleFileHeader hdr;
+	std::string symbol;
+	GapMap gaps;
+	bool validated = false;
+	{
+		//validates the file
+		CandleFile file(fn);
+		hdr = file.header();
+		symbol = file.symbol();
+		gaps = file.gaps();
+		validated = file.validated() && candle_check::validate(tail, 31, 0).ok() 
+			&& (hdr.n == 0 || tail.empty() || tail.dt()[0] > file.dt()[hdr.n - 1]);
+	}
+	if(tail.empty()){
+		return;
+	}
+	if(tail_gaps != nullptr && tail_gaps->size() != tail.size()){
+		throw std::invalid_argument("CandleFile::append: tail_gaps must have one flag for each candle");
+	}
+	bool has_gaps = hdr.flags & flag_gaps_;
+	if(has_gaps){
+		if(tail_gaps != nullptr){
+			gaps.append(*tail_gaps);
+		}else{
+			for(std::size_t i = 0; i < tail.size(); i++){
+				gaps.push_back(true);
+			}
+		}
+	}
+	std::uint64_t n = hdr.n + tail.size();
+	if(n > hdr.capacity){
+		//not enough room, rewrite the file with a larger capacity (the new file replaces fn once it is complete)
+		CandleColumns cols(std::make_shared<const CandleFile>(fn));
+		cols.reserve(n);
+		for(std::size_t i = 0; i < tail.size(); i++){
+			cols.push_back(tail.dt()[i], tail.o()[i], tail.h()[i], tail.l()[i], tail.c()[i], tail.v()[i], tail.b()[i], tail.a()[i]);
+		}
+		std::string tmp = fn + ".tmp";
+		//(write validates the whole series again)
+		write(tmp, cols, hdr.tf, fidelity, n_real, symbol, std::max(2 * hdr.capacity, n), has_gaps ? &gaps : nullptr);
+		std::filesystem::rename(tmp, fn);
+		return;
+	}
+	std::fstream file(fn, std::ios::in | std::ios::out | std::ios::binary);
+	if(!file.is_open()){
+		throw std::runtime_error("CandleFile::append: Unable to open " + fn);
+	}
+	std::size_t k = 0;
+	auto append_col = [&](const auto& col){
+		file.seekp(hdr.header_size + (k * hdr.capacity + hdr.n) * sizeof(double));
+		file.write(reinterpret_cast<const char*>(col.data()), col.size_bytes());
+		k++;
+	};
+	append_col(tail.dt());
+	append_col(tail.o());
+	append_col(tail.h());
+	append_col(tail.l());
+	append_col(tail.c());
+	append_col(tail.v());
+	append_col(tail.b());
+	append_col(tail.a());
+	if(has_gaps){
+		//rewrite the words from the one holding the first new flag
+		std::size_t w = hdr.n / 64;
+		file.seekp(hdr.header_size + n_cols_ * hdr.capacity * sizeof(double) + w * sizeof(std::uint64_t));
+		file.write(reinterpret_cast<const char*>(gaps.words().data() + w), (gaps.words().size() - w) * sizeof(std::uint64_t));
+	}
+	file.flush();
+	//the header is written last so that an interrupted append leaves the stored candles unchanged
+	hdr.n = n;
+	hdr.n_real = n_real;
+	hdr.fidelity = fidelity;
+	hdr.flags = validated ? hdr.flags | flag_validated_ : hdr.flags & ~flag_validated_;
+	file.seekp(0);
+	file.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+	if(!file){
+		throw std::runtime_error("CandleFile::append: Error writing " + fn);
+	}
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include "CandleColumns.h"
+#include "GapMap.h"
+#include "CandleCheck.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <fstream>
+#include <stdexcept>
+
+/*
+	Versioned binary file format for cleaned candle series
+	Layout: a 256 byte header followed by 8 fixed width column blocks (datetime as int64 seconds since the unix epoch (utc),
+	then open, high, low, close, volume, bid & ask as doubles). Each block holds capacity elements of which the first n are used
+	(capacity >= n leaves room for appending candles in place). Block k starts at header_size + k * capacity * 8 bytes.
+	The flag validated is set if the candles passed every check in candle_check (see CandleCheck.h) when they were written.
+	If the flag gaps is set the column blocks are followed by the provenance of the candles (see GapMap.h): (capacity + 63) / 64
+	words where bit i % 64 of word i / 64 is set if candle i is real.
+	Values are stored in the native byte order of the machine that wrote the file (the endian field is checked when loading).
+*/
+struct CandleFileHeader{
+	char magic[8];
+	std::uint32_t version;
+	//0x01020304 written in native byte order
+	std::uint32_t endian;
+	std::uint64_t header_size;
+	//number of candles stored
+	std::uint64_t n;
+	//number of candles each column block has room for
+	std::uint64_t capacity;
+	//number of candles which came from the raw data (the rest were gap filled)
+	std::uint64_t n_real;
+	double fidelity;
+	//timeframe in minutes
+	std::int32_t tf;
+	//bit flags (CandleFile::flag_gaps_ & CandleFile::flag_validated_)
+	std::uint32_t flags;
+	//null terminated symbol (e.g. EURUSD) & time zone name (e.g. America/New_York)
+	char symbol[32];
+	char tz[64];
+	char reserved[96];
+};
+static_assert(sizeof(CandleFileHeader) == 256, "CandleFileHeader must be 256 bytes");
+
+//read only memory mapping of a binary candle file (the mapping is released when the object is destroyed)
+class CandleFile{
+	public:
+		static constexpr char magic_[8] = {'C', 'N', 'D', 'L', 'B', 'I', 'N', '\0'};
+		static constexpr std::uint32_t version_ = 1;
+		static constexpr std::uint32_t endian_ = 0x01020304;
+		static constexpr std::uint64_t header_size_ = sizeof(CandleFileHeader);
+		static constexpr std::size_t n_cols_ = 8;
+		//the file stores the provenance of the candles
+		static constexpr std::uint32_t flag_gaps_ = 1;
+		//the candles passed the bulk validation when they were written (readers may skip checking them again)
+		static constexpr std::uint32_t flag_validated_ = 2;
+
+		//map the file fn (throws if the file can not be mapped or is not a valid candle file)
+		CandleFile(const std::string& fn);
+		CandleFile(const CandleFile&) = delete;
+		CandleFile& operator=(const CandleFile&) = delete;
+		//accessors
+		const CandleFileHeader& header() const;
+		std::string symbol() const;
+		std::string tz() const;
+		//columns (views into the mapped memory)
+		std::span<const std::int64_t> dt() const;
+		std::span<const double> o() const;
+		std::span<const double> h() const;
+		std::span<const double> l() const;
+		std::span<const double> c() const;
+		std::span<const double> v() const;
+		std::span<const double> b() const;
+		std::span<const double> a() const;
+		//provenance of the candles (empty if the file does not store it)
+		bool has_gaps() const;
+		GapMap gaps() const;
+		bool validated() const;
+
+		//returns true if fn starts with the candle file magic bytes
+		static bool is_candle_file(const std::string& fn);
+		//write cols to fn (capacity = 0 ==> capacity = cols.size()) (gaps is the provenance of the candles, nullptr if it is unknown)
+		//the candles are validated (see CandleCheck.h) & the flag validated is set if they pass
+		static void write(const std::string& fn, const CandleColumns& cols, int tf, double fidelity, std::uint64_t n_real,
+				const std::string& symbol = "", std::uint64_t capacity = 0, const GapMap* gaps = nullptr);
+		//append the candles in tail to fn & store the new totals n_real & fidelity in the header
+		//the candles are written in place if the blocks have enough capacity, otherwise the file is rewritten with double the capacity
+		//the flag validated is kept if tail passes the validation & starts after the last stored candle
+		//tail_gaps is the provenance of tail (ignored if the file does not store provenance, nullptr ==> every candle is real)
+		static void append(const std::string& fn, const CandleColumns& tail, std::uint64_t n_real, double fidelity, 
+				const GapMap* tail_gaps = nullptr);
+	private:
+		MappedFile map_;
+		const CandleFileHeader* hdr_ = nullptr;
+		//pointer to the start of column block k
+		const char* col_(std::size_t k) const;
+		//number of words in the provenance section of a file with room for capacity candles
+		static std::uint64_t gap_words_(std::uint64_t capacity);
+		//check that the header describes a file which can be read
+		void validate_(const std::string& fn) const;
+};
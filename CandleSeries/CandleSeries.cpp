@@ -2,101 +2,301 @@
 
 
 //function to clean the data in the txt files f_in
-//write data to the json file f_out
-void CandleSeries::clean(std::string f_in, std::string f_out, std::string tf, std::string asset_c, std::string tmz_i){
-	std::ifstream file(f_in); 
-	if(!file.is_open()){
-		throw std::runtime_error("File was not opened"); 
+//write data to the json (or binary / compressed binary) file f_out
+void CandleSeries::clean(std::string f_in, std::string f_out, std::string tf, std::string asset_c, std::string tmz_i, 
+		std::string fmt, std::string symbol, std::string parser){
+	if(fmt != "json" && fmt != "bin" && fmt != "zbin"){
+		throw std::invalid_argument("clean: fmt must be json, bin or zbin"); 
 	}
-	//first line has header info (no need to store it)
-	std::string line; 
-	std::getline(file, line);
-	file.seekg(0, std::ios::end); 
-	std::streamsize size = file.tellg(); 
-	file.seekg(0, std::ios::beg); 
-	std::string buffer(size, '\0');
-	file.read(buffer.data(), size); 
-	file.close(); 
-
-	auto find_chars = [](const std::string& s, char c, std::vector<int>& positions){
-		positions.push_back(0);
-		int i = 1; 
-		while(s.find(c, positions[i - 1] + 1) != std::string::npos){
-			positions.push_back(s.find(c, positions[i - 1] + 1));
-			i++; 
-		}
-	}; 
-	std::vector<int> positions; 
-	find_chars(buffer, '\n', positions); 
-	//we create a vector of the valid datetimes 
-	std::vector<Datetime> valid_dt;
-	valid_dt.reserve(positions.size()); 
-	//get the first and last datetimes
+	//parse the raw data into candles sorted by datetime 
+	std::vector<RawCandle> raw; 
+	parse_raw_(f_in, tmz_i, parser, raw); 
+	if(raw.empty()){
+		throw std::runtime_error("clean: No candles were found in f_in"); 
+	}
+	//get the first and last datetimes (in the current zone)
 	auto c_tmz = std::chrono::current_zone();
-	auto c_tmz_string = std::string(c_tmz->name()); 
-	Datetime sdt = Datetime(buffer.substr(positions[1] + 1, positions[2] - positions[1]).substr(0, 19), c_tmz);
-	Datetime edt = Datetime(buffer.substr(positions[positions.size() - 2] + 1).substr(0, 19), c_tmz);  
-	Datetime dt = sdt; 	
+	Datetime sdt = Datetime(std::chrono::sys_seconds{std::chrono::seconds{raw.front().dt}}, c_tmz);
+	Datetime edt = Datetime(std::chrono::sys_seconds{std::chrono::seconds{raw.back().dt}}, c_tmz);
 	//generate the valid datetimes
+	std::vector<std::int64_t> valid_dt;
 	gen_valid_dt(asset_c, tf, sdt, edt, valid_dt); 
-	//store the datetimes & json objects in an undordered map 
-	std::unordered_map<Datetime, nlohmann::json, DatetimeHash> um; 
-	
-	auto parse_line = [&](const int &i){
-		int line_n = std::distance(&(*positions.cbegin()), &i); 
-		auto posit = std::next(positions.cbegin(), line_n);
-		auto positp = std::prev(posit);
-		std::string line = buffer.substr(*positp + 1, *posit - *positp);
-		std::vector<int> commas;
-		commas.reserve(8); 
-		find_chars(line, ',', commas);
-		Datetime dt = Datetime(line.substr(commas[0], commas[1] - commas[0] - 1), std::chrono::locate_zone(tmz_i)).change_tmz(c_tmz_string);
-
-	
-		um.insert(std::make_pair(
-					dt, 
-				nlohmann::json{
-					{"Datetime", std::format("{:%Y.%m.%d %H:%M:%S}", dt.zt())}, 
-					{"Open", std::stod(line.substr(commas[1] + 1, commas[2] - commas[1] - 1))}, 
-					{"High", std::stod(line.substr(commas[2] + 1, commas[3] - commas[2] - 1))}, 
-					{"Low", std::stod(line.substr(commas[3] + 1, commas[4] - commas[3] - 1))}, 
-					{"Close", std::stod(line.substr(commas[4] + 1, commas[5] - commas[4] - 1))},
-					{"Volume", std::stod(line.substr(commas[5] + 1, commas[6] - commas[5] - 1))}, 
-					{"Bid", std::stod(line.substr(commas[6] + 1, commas[7] - commas[6] - 1))}, 
-					{"Ask", std::stod(line.substr(commas[7] + 1))}
-				} 
-			)
-		); 
-	};
+	//fill the gaps in the raw data 
+	std::vector<RawCandle> filled; 
+	GapMap gaps; 
+	std::size_t n_real = gap_fill_(raw, valid_dt, filled, gaps); 
+	write_clean_(f_out, fmt, filled, gaps, tf_min(tf), fidelity_of_(filled.size(), n_real), n_real, symbol); 
+}
 
+void CandleSeries::append_clean(std::string f_in, std::string clean_fn, std::string asset_c, std::string tmz_i, std::string parser){
+	auto c_tmz = std::chrono::current_zone();
+	//read the metadata & the last candle of the stored series 
+	bool bin = CandleFile::is_candle_file(clean_fn); 
+	bool zbin = !bin && CompressedCandleFile::is_compressed_file(clean_fn); 
+	CleanCandleSeriesJson cs_json;
+	int tf = 0; 
+	double fidelity = 0; 
+	std::size_t n = 0; 
+	std::size_t n_real = 0; 
+	RawCandle last; 
+	if(bin){
+		CandleFile file(clean_fn); 
+		const CandleFileHeader& hdr = file.header(); 
+		n = hdr.n; 
+		if(n == 0){
+			throw std::runtime_error("append_clean: The stored series is empty"); 
+		}
+		tf = hdr.tf; 
+		fidelity = hdr.fidelity; 
+		n_real = hdr.n_real; 
+		last = RawCandle{file.dt()[n - 1], file.o()[n - 1], file.h()[n - 1], file.l()[n - 1], file.c()[n - 1], 
+			file.v()[n - 1], file.b()[n - 1], file.a()[n - 1]}; 
+	}else if(zbin){
+		CompressedCandleFile file(clean_fn); 
+		const CompressedCandleHeader& hdr = file.header(); 
+		n = hdr.n; 
+		if(n == 0){
+			throw std::runtime_error("append_clean: The stored series is empty"); 
+		}
+		tf = hdr.tf; 
+		fidelity = hdr.fidelity; 
+		n_real = hdr.n_real; 
+		//only the last block is decoded
+		CandleColumns lc = file.decode(n - 1, n); 
+		last = RawCandle{lc.dt()[0], lc.o()[0], lc.h()[0], lc.l()[0], lc.c()[0], lc.v()[0], lc.b()[0], lc.a()[0]}; 
+	}else{
+		auto ec = glz::read_file_json(cs_json, clean_fn, std::string{});
+		if(ec){
+			throw std::runtime_error("append_clean: The json file was not read properly"); 
+		}
+		n = cs_json.candle_vec_.size(); 
+		if(n == 0){
+			throw std::runtime_error("append_clean: The stored series is empty"); 
+		}
+		tf = cs_json.tf_; 
+		fidelity = cs_json.fidelity_; 
+		n_real = n_real_of_(n, fidelity); 
+		const CandleJson& cj = cs_json.candle_vec_.back(); 
+		last = RawCandle{Datetime(std::string(cj.Datetime), c_tmz).epoch(), cj.Open, cj.High, cj.Low, cj.Close, cj.Volume, cj.Bid, cj.Ask}; 
+	}
 
-	//execution has to be sequention since we are inserting elements into m
-	std::for_each(std::execution::seq, std::next(positions.begin(), 3), positions.end(), parse_line);
+	//parse the raw data which comes after the last stored candle 
+	if(parser != "serial" && parser != "parallel"){
+		throw std::invalid_argument("append_clean: parser must be serial or parallel"); 
+	}
+	MappedFile file(f_in); 
+	std::string_view data = raw_parse::skip_header(file.view()); 
+	auto tmz = tmz_cache::zone(tmz_i); 
+	//the raw file is sorted in local time, starting a day early covers dst transitions
+	std::int64_t last_local = last.dt + tmz->get_info(std::chrono::sys_seconds{std::chrono::seconds{last.dt}}).offset.count(); 
+	data = raw_parse::seek_local(data, last_local - 86400); 
+	std::vector<RawCandle> raw; 
+	if(parser == "parallel"){
+		raw_parse::parse_parallel(data, tmz, raw); 
+	}else{
+		raw_parse::parse_serial(data, tmz, raw); 
+	}
+	raw_parse::sort_unique(raw); 
+	//drop the candles which are already stored 
+	raw.erase(raw.begin(), std::upper_bound(raw.begin(), raw.end(), last.dt, [](std::int64_t dt, const RawCandle& rc){return dt < rc.dt;})); 
+	if(raw.empty()){
+		return; 
+	}
 
-	nlohmann::json::array_t json_vec(valid_dt.size()); 
+	//the valid datetimes from the last stored candle to the end of the new data 
+	std::vector<std::int64_t> valid_dt;
+	gen_valid_dt(asset_c, tf_str_(tf), Datetime(std::chrono::sys_seconds{std::chrono::seconds{last.dt}}, c_tmz), 
+			Datetime(std::chrono::sys_seconds{std::chrono::seconds{raw.back().dt}}, c_tmz), valid_dt); 
+	if(valid_dt.empty() || valid_dt.front() != last.dt){
+		throw std::runtime_error("append_clean: The stored series does not end on a valid datetime (check asset_c)"); 
+	}
+	valid_dt.erase(valid_dt.begin()); 
+	//fill the gaps (including the gap between the stored & new candles) 
+	std::vector<RawCandle> filled; 
+	GapMap gaps; 
+	std::size_t n_real_add = gap_fill_(raw, valid_dt, filled, gaps, &last); 
+	if(filled.empty()){
+		return; 
+	}
+	n_real += n_real_add; 
+	//htf files (fidelity -1) have no fidelity to update
+	if(fidelity >= 0){
+		fidelity = fidelity_of_(n + filled.size(), n_real); 
+	}
 
-	auto make_candle_json2 = [&](const Datetime& dt){
-		int i = std::distance(&*(valid_dt.cbegin()), &dt);
-		auto dt_it = std::next(valid_dt.cbegin(), i);
-		auto json_it = std::next(json_vec.begin(), i);
-		//look for the valid datetime in the map
-		if(um.find(dt) == um.end()){
-			//if we cant find the valid datetime in the map we copy the previous candle & change the datetime
-			*json_it = *std::prev(json_it); 	
-			(*json_it)["Datetime"] = std::format("{:%Y.%m.%d %H:%M:%S}", dt.zt());  
+	if(bin || zbin){
+		CandleColumns tail; 
+		tail.reserve(filled.size()); 
+		for(const RawCandle& rc : filled){
+			tail.push_back(rc.dt, rc.o, rc.h, rc.l, rc.c, rc.v, rc.b, rc.a); 
+		}
+		if(bin){
+			CandleFile::append(clean_fn, tail, n_real, fidelity, &gaps); 
 		}else{
-			*json_it = um.at(dt); 
+			CompressedCandleFile::append(clean_fn, tail, n_real, fidelity, &gaps); 
 		}
-	};
+	}else{
+		//json files can not be extended in place so the whole file is rewritten (use the bin format for large series)
+		cs_json.candle_vec_.reserve(n + filled.size()); 
+		raw_parse::SysToLocal to_local(c_tmz); 
+		for(const RawCandle& rc : filled){
+			cs_json.candle_vec_.push_back(CandleJson{dt_format::format(to_local(rc.dt)), rc.o, rc.h, rc.l, rc.c, rc.v, rc.b, rc.a}); 
+		}
+		cs_json.fidelity_ = fidelity; 
+		if(cs_json.gaps_){
+			//extend the gap runs (a run at the end of the stored series continues into the new candles) 
+			for(auto [b, e] : gaps.gaps(0, gaps.size())){
+				if(b == 0 && !cs_json.gaps_->empty() && cs_json.gaps_->back()[1] == n){
+					cs_json.gaps_->back()[1] = n + e; 
+				}else{
+					cs_json.gaps_->push_back({n + b, n + e}); 
+				}
+			}
+		}
+		auto ec = glz::write_file_json(cs_json, clean_fn, std::string{}); 
+		if(ec){
+			throw std::runtime_error("append_clean: The json file was not written properly"); 
+		}
+	}
+}
+
+void CandleSeries::clean_ticks(std::string f_in, std::vector<std::string> f_outs, std::vector<std::string> tfs, std::string asset_c, 
+		std::string tmz_i, std::string fmt, std::string symbol, std::string price){
+	if(fmt != "json" && fmt != "bin" && fmt != "zbin"){
+		throw std::invalid_argument("clean_ticks: fmt must be json, bin or zbin"); 
+	}
+	if(tfs.empty() || f_outs.size() != tfs.size()){
+		throw std::invalid_argument("clean_ticks: Enter one output file for each timeframe"); 
+	}
+	std::vector<unsigned short int> tf_mins; 
+	tf_mins.reserve(tfs.size()); 
+	for(const std::string& tf : tfs){
+		tf_mins.push_back(tf_min(tf)); 
+	}
+	//one pass over the ticks builds the bars of every timeframe 
+	auto c_tmz = std::chrono::current_zone();
+	TickAggregator agg(tf_mins, asset_c, c_tmz, price); 
+	agg.push_file(f_in, tmz_i); 
+	agg.flush(); 
+	for(std::size_t k = 0; k < tfs.size(); k++){
+		const std::vector<RawCandle>& raw = agg.bars(tf_mins[k]); 
+		if(raw.empty()){
+			throw std::runtime_error("clean_ticks: No ticks were found in f_in during trading hours"); 
+		}
+		Datetime sdt = Datetime(std::chrono::sys_seconds{std::chrono::seconds{raw.front().dt}}, c_tmz);
+		Datetime edt = Datetime(std::chrono::sys_seconds{std::chrono::seconds{raw.back().dt}}, c_tmz);
+		std::vector<std::int64_t> valid_dt;
+		gen_valid_dt(asset_c, tfs[k], sdt, edt, valid_dt); 
+		std::vector<RawCandle> filled; 
+		GapMap gaps; 
+		std::size_t n_real = gap_fill_(raw, valid_dt, filled, gaps); 
+		write_clean_(f_outs[k], fmt, filled, gaps, tf_mins[k], fidelity_of_(filled.size(), n_real), n_real, symbol); 
+	}
+}
+
+//parse the raw data file f_in (times in tmz_i) into candles sorted by datetime 
+void CandleSeries::parse_raw_(const std::string& f_in, const std::string& tmz_i, const std::string& parser, std::vector<RawCandle>& raw) const{
+	if(parser != "serial" && parser != "parallel"){
+		throw std::invalid_argument("clean: parser must be serial or parallel"); 
+	}
+	MappedFile file(f_in); 
+	//first line has header info (no need to store it)
+	std::string_view data = raw_parse::skip_header(file.view()); 
+	auto tmz = tmz_cache::zone(tmz_i); 
+	if(parser == "parallel"){
+		file.advise_sequential(); 
+		raw_parse::parse_parallel(data, tmz, raw); 
+	}else{
+		raw_parse::parse_serial(data, tmz, raw); 
+	}
+	raw_parse::sort_unique(raw); 
+}
 
+//fill filled with a candle for each valid datetime (missing candles are copies of the previous candle) 
+//returns the number of valid datetimes which were found in raw 
+//prev is the candle before valid_dt[0] (if there is one) 
+std::size_t CandleSeries::gap_fill_(const std::vector<RawCandle>& raw, const std::vector<std::int64_t>& valid_dt, std::vector<RawCandle>& filled, 
+		GapMap& gaps, const RawCandle* prev) const{
+	filled.resize(valid_dt.size()); 
+	gaps.clear(); 
+	gaps.reserve(valid_dt.size()); 
+	std::size_t n_real = 0; 
+	std::size_t j = 0; 
+	//raw & valid_dt are both sorted so we walk through them together
+	for(std::size_t i = 0; i < valid_dt.size(); i++){
+		std::int64_t e = valid_dt[i]; 
+		while(j < raw.size() && raw[j].dt < e){
+			j++; 
+		}
+		if(j < raw.size() && raw[j].dt == e){
+			filled[i] = raw[j]; 
+			gaps.push_back(true); 
+			n_real++; 
+		}else{
+			//copy the previous candle (or the next real candle if there is no previous candle) & change the datetime
+			if(i > 0){
+				filled[i] = filled[i - 1]; 
+			}else if(prev != nullptr){
+				filled[i] = *prev; 
+			}else{
+				filled[i] = raw[std::min(j, raw.size() - 1)]; 
+			}
+			filled[i].dt = e; 
+			gaps.push_back(false); 
+		}
+	}
+	return n_real; 
+}
+
+//write the cleaned candles to f_out (the datetimes are written in the current zone) 
+void CandleSeries::write_clean_(const std::string& f_out, const std::string& fmt, const std::vector<RawCandle>& rcs, const GapMap& gaps, 
+		int tf, double fidelity, std::size_t n_real, const std::string& symbol) const{
+	auto c_tmz = std::chrono::current_zone();
+	if(fmt == "bin" || fmt == "zbin"){
+		CandleColumns cols; 
+		cols.set_tmz(c_tmz); 
+		cols.reserve(rcs.size()); 
+		for(const RawCandle& rc : rcs){
+			cols.push_back(rc.dt, rc.o, rc.h, rc.l, rc.c, rc.v, rc.b, rc.a); 
+		}
+		if(fmt == "bin"){
+			CandleFile::write(f_out, cols, tf, fidelity, n_real, symbol, 0, &gaps); 
+		}else{
+			CompressedCandleFile::write(f_out, cols, tf, fidelity, n_real, symbol, CompressedCandleFile::default_block_size_, &gaps); 
+		}
+		return; 
+	}
+	nlohmann::json::array_t json_vec(rcs.size()); 
+	//convert the datetimes to local time in one batch so the (parallel) formatting does not touch the time zone database 
+	std::vector<std::int64_t> local(rcs.size()); 
+	std::transform(rcs.begin(), rcs.end(), local.begin(), [](const RawCandle& rc){return rc.dt;}); 
+	tmz_cache::to_local(c_tmz, local, local); 
+	auto make_candle_json = [](const RawCandle& rc, std::int64_t local_s){
+		return nlohmann::json{
+			{"Datetime", dt_format::format(local_s)}, 
+			{"Open", rc.o}, 
+			{"High", rc.h}, 
+			{"Low", rc.l}, 
+			{"Close", rc.c},
+			{"Volume", rc.v}, 
+			{"Bid", rc.b}, 
+			{"Ask", rc.a}
+		}; 
+	};
 	//fill the json array 
-	std::for_each(std::execution::par_unseq, valid_dt.begin(), valid_dt.end(), make_candle_json2); 
+	std::transform(std::execution::par_unseq, rcs.begin(), rcs.end(), local.begin(), json_vec.begin(), make_candle_json); 
+
+	//the gap filled candles are recorded as runs [begin, end) 
+	nlohmann::json::array_t gap_runs; 
+	for(auto [b, e] : gaps.gaps(0, gaps.size())){
+		gap_runs.push_back(nlohmann::json::array({b, e})); 
+	}
 
 	nlohmann::json json_w_meta = {
-		//fidelity is the percentage of real candles in the candle vector
-		{"fidelity_", 1 - ((json_vec.size() - um.size()) / (double)um.size())},
+		{"fidelity_", fidelity},
 		{"candle_vec_", json_vec},
-		{"tf_", tf_min(tf)},
+		{"tf_", tf},
+		{"gaps_", gap_runs},
 	}; 
 
 	std::ofstream file_out(f_out);
@@ -104,48 +304,126 @@ void CandleSeries::clean(std::string f_in, std::string f_out, std::string tf, st
 		throw std::invalid_argument("clean: Unable to open the output file"); 
 	}
 	file_out << json_w_meta; 
-	file.close(); 
 }
 
 
 //Function to read the cleaned json file  
 //Note: clean changes times to the current zone & read_clean uses the current zone 
-void CandleSeries::read_clean(std::string fn){
+void CandleSeries::read_clean(std::string fn, std::string storage){
+	if(storage != "rows" && storage != "columns" && storage != "both"){
+		throw std::invalid_argument("read_clean: storage must be one of rows, columns or both"); 
+	}
+	if(CandleFile::is_candle_file(fn)){
+		//binary candle file: the columns are served directly from the mapping (nothing is parsed)
+		auto file = std::make_shared<const CandleFile>(fn); 
+		cols_ = CandleColumns(file); 
+		gaps_ = file->gaps(); 
+		finish_read_(file->header().fidelity, file->header().tf, file->symbol(), file->validated(), storage); 
+		return; 
+	}
+	if(CompressedCandleFile::is_compressed_file(fn)){
+		//compressed candle file: every block is decoded into owned columns
+		CompressedCandleFile file(fn); 
+		cols_ = file.decode_all(&gaps_); 
+		finish_read_(file.header().fidelity, file.header().tf, file.symbol(), file.validated(), storage); 
+		return; 
+	}
 	CleanCandleSeriesJson cs_json;
 	//choose a large reserve size
 	auto ec = glz::read_file_json(cs_json, fn, std::string{});
 	if(ec){
 		throw std::runtime_error("read_clean: The json file was not read properly"); 
 	}
+	//rebuild the provenance from the gap runs 
+	std::size_t n = cs_json.candle_vec_.size(); 
+	gaps_.clear(); 
+	if(cs_json.gaps_){
+		gaps_.reserve(n); 
+		std::size_t i = 0; 
+		for(const auto& [b, e] : *cs_json.gaps_){
+			if(b < i || e < b || e > n){
+				throw std::runtime_error("read_clean: The gap runs in the json file are corrupt"); 
+			}
+			for(; i < b; i++){
+				gaps_.push_back(true); 
+			}
+			for(; i < e; i++){
+				gaps_.push_back(false); 
+			}
+		}
+		for(; i < n; i++){
+			gaps_.push_back(true); 
+		}
+	}
 	auto tmz = std::chrono::current_zone(); 
-	auto create_candles = [tmz](CandleJson& cj){
-		return std::move(Candle{
-				std::move(Datetime(cj.Datetime, tmz)), 
-				std::move(cj.Open), 
-				std::move(cj.High), 
-				std::move(cj.Low), 
-				std::move(cj.Close), 
-				std::move(cj.Volume), 
-				std::move(cj.Bid), 
-				std::move(cj.Ask) 
-				});
-	};
-	//populate the vector of candle objects
-	Candle c(Datetime(), -1.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0); 
-	cs_.resize(cs_json.candle_vec_.size(), c); 
-	std::transform(std::execution::seq, cs_json.candle_vec_.begin(), cs_json.candle_vec_.end(), cs_.begin(), create_candles); 
+	//the storage which is not requested is emptied so build_index_ never reads the candles of a previous read
+	if(storage == "rows"){
+		cols_.clear(); 
+	}else if(storage == "columns"){
+		cs_.clear(); 
+	}
+	if(storage == "columns" || storage == "both"){
+		//fill the columns directly from the json objects (no Candle objects are constructed)
+		cols_.clear(); 
+		cols_.set_tmz(tmz); 
+		cols_.reserve(cs_json.candle_vec_.size()); 
+		raw_parse::LocalToSys to_sys(tmz); 
+		for(CandleJson& cj : cs_json.candle_vec_){
+			//the cleaned layout is decoded directly (other layouts go through Datetime) 
+			std::int64_t local_s = 0; 
+			std::int64_t e = cj.Datetime.size() == dt_format::width && dt_format::decode(cj.Datetime, local_s) ? to_sys(local_s) 
+				: Datetime(cj.Datetime, tmz).epoch(); 
+			cols_.push_back(e, cj.Open, cj.High, cj.Low, cj.Close, cj.Volume, cj.Bid, cj.Ask); 
+		}
+	}
+	if(storage == "rows" || storage == "both"){
+		auto create_candles = [tmz](CandleJson& cj){
+			return std::move(Candle{
+					std::move(Datetime(cj.Datetime, tmz)), 
+					std::move(cj.Open), 
+					std::move(cj.High), 
+					std::move(cj.Low), 
+					std::move(cj.Close), 
+					std::move(cj.Volume), 
+					std::move(cj.Bid), 
+					std::move(cj.Ask) 
+					});
+		};
+		//populate the vector of candle objects
+		Candle c(Datetime(), -1.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0); 
+		cs_.resize(cs_json.candle_vec_.size(), c); 
+		std::transform(std::execution::seq, cs_json.candle_vec_.begin(), cs_json.candle_vec_.end(), cs_.begin(), create_candles); 
+	}
 	//store the fidelity 
 	fidelity_ = cs_json.fidelity_;
+	//json files do not record a validation (see validate) 
+	validated_ = false; 
 	tf_ = cs_json.tf_; 
+	reset_htf_(); 
+	build_index_(); 
 }
-void CandleSeries::make_clean_htf(std::string clean_ltf_fn, std::string clean_htf_fn, std::string htf, Datetime st){
+void CandleSeries::make_clean_htf(std::string clean_ltf_fn, std::string clean_htf_fn, std::string htf, Datetime st, 
+		std::string fmt, std::string symbol){
+	if(fmt != "json" && fmt != "bin" && fmt != "zbin"){
+		throw std::invalid_argument("make_clean_htf: fmt must be json, bin or zbin"); 
+	}
 	this->read_clean(clean_ltf_fn);
 	this->comp_htf(htf, st);
+	if(fmt == "bin"){
+		//the higher timeframe is already stored as columns 
+		CandleFile::write(clean_htf_fn, *htf_cs_, tf_min(htf), -1, 0, symbol.empty() ? symbol_ : symbol); 
+		return; 
+	}
+	if(fmt == "zbin"){
+		CompressedCandleFile::write(clean_htf_fn, *htf_cs_, tf_min(htf), -1, 0, symbol.empty() ? symbol_ : symbol); 
+		return; 
+	}
 	nlohmann::json::array_t json_vec;
-	json_vec.reserve(htf_cs_.size()); 
-	for(auto it = this->htf_cs_.cbegin(); it != this->htf_cs_.cend(); it++){
+	json_vec.reserve(htf_cs_->size()); 
+	raw_parse::SysToLocal to_local(htf_cs_->tmz()); 
+	for(auto it = this->htf_cs_->begin(); it != this->htf_cs_->end(); it++){
 		json_vec.push_back(nlohmann::json{
-			{"Datetime", std::format("{:%Y.%m.%d %H:%M:%S}", (it->dt())->zt())}, 
+			{"Datetime", dt_format::format(to_local(it->epoch()))}, 
 			{"Open", it->o()}, 
 			{"High", it->h()}, 
 			{"Low", it->l()}, 
@@ -170,6 +448,151 @@ void CandleSeries::make_clean_htf(std::string clean_ltf_fn, std::string clean_ht
 	file_out.close(); 
 }
 
+void CandleSeries::read_clean_range(std::string fn, Datetime st, Datetime end, std::string storage){
+	if(storage != "rows" && storage != "columns" && storage != "both"){
+		throw std::invalid_argument("read_clean_range: storage must be one of rows, columns or both"); 
+	}
+	if(CompressedCandleFile::is_compressed_file(fn)){
+		//only the blocks which overlap [st, end] are decoded
+		CompressedCandleFile file(fn); 
+		cols_ = file.decode_range(st.epoch(), end.epoch(), &gaps_); 
+		finish_read_(file.header().fidelity, file.header().tf, file.symbol(), file.validated(), storage); 
+		return; 
+	}
+	if(!CandleFile::is_candle_file(fn)){
+		throw std::invalid_argument("read_clean_range: fn must be a binary or compressed candle file (use read_clean for json files)"); 
+	}
+	//binary candle file: copy the candles in the range out of the mapping 
+	CandleFile file(fn); 
+	auto dt = file.dt(); 
+	std::size_t first = std::lower_bound(dt.begin(), dt.end(), st.epoch()) - dt.begin(); 
+	std::size_t last = std::max(first, std::size_t(std::upper_bound(dt.begin(), dt.end(), end.epoch()) - dt.begin())); 
+	auto slice = [first, last](std::span<const double> x){ return std::vector<double>(x.begin() + first, x.begin() + last); }; 
+	cols_ = CandleColumns(std::vector<std::int64_t>(dt.begin() + first, dt.begin() + last), slice(file.o()), slice(file.h()), slice(file.l()), 
+			slice(file.c()), slice(file.v()), slice(file.b()), slice(file.a()), tmz_cache::zone(file.tz())); 
+	gaps_ = file.gaps().slice(first, last); 
+	finish_read_(file.header().fidelity, file.header().tf, file.symbol(), file.validated(), storage); 
+}
+
+//cols_ holds the decoded candles: build the rows if they were requested & store the metadata 
+void CandleSeries::finish_read_(double fidelity, int tf, const std::string& symbol, bool validated, const std::string& storage){
+	if(storage == "rows" || storage == "both"){
+		cs_.clear(); 
+		cs_.reserve(cols_.size()); 
+		for(std::size_t i = 0; i < cols_.size(); i++){
+			cs_.push_back(cols_.candle(i)); 
+		}
+		if(storage == "rows"){
+			//release the columns (or the mapping of a binary file)
+			cols_.clear(); 
+		}
+	}else{
+		//rows of a previous read are not kept
+		cs_.clear(); 
+	}
+	fidelity_ = fidelity; 
+	validated_ = validated; 
+	tf_ = tf; 
+	symbol_ = symbol; 
+	reset_htf_(); 
+	build_index_(); 
+}
+
+void CandleSeries::convert_clean(std::string json_fn, std::string bin_fn, std::string symbol, std::string fmt){
+	if(fmt != "bin" && fmt != "zbin"){
+		throw std::invalid_argument("convert_clean: fmt must be bin or zbin"); 
+	}
+	CandleSeries cs; 
+	cs.read_clean(json_fn, "columns"); 
+	//count the real candles if the provenance is recorded, otherwise recover the number from the fidelity written by clean 
+	const GapMap* gaps = cs.gaps_.size() == cs.cols_.size() ? &cs.gaps_ : nullptr; 
+	std::size_t n_real = gaps != nullptr ? gaps->n_real() : n_real_of_(cs.cols_.size(), cs.fidelity_); 
+	if(fmt == "bin"){
+		CandleFile::write(bin_fn, cs.cols_, cs.tf_, cs.fidelity_, n_real, symbol, 0, gaps); 
+	}else{
+		CompressedCandleFile::write(bin_fn, cs.cols_, cs.tf_, cs.fidelity_, n_real, symbol, CompressedCandleFile::default_block_size_, gaps); 
+	}
+}
+
+//fidelity as defined by clean (1 ==> every candle is real) 
+double CandleSeries::fidelity_of_(std::size_t n, std::size_t n_real){
+	if(n_real == 0){
+		return 0; 
+	}
+	return 1 - ((double(n) - double(n_real)) / (double)n_real); 
+}
+std::size_t CandleSeries::n_real_of_(std::size_t n, double fidelity){
+	//htf files have a fidelity of -1 
+	if(fidelity <= 0){
+		return 0; 
+	}
+	return static_cast<std::size_t>(std::llround(n / (2 - fidelity))); 
+}
+
+//grid index functions 
+void CandleSeries::build_index_(){
+	if(!cols_.empty()){
+		idx_ = GridIndex(cols_.dt(), 60 * static_cast<std::int64_t>(tf_)); 
+		dt_axis_ = std::make_shared<const DatetimeAxis>(cols_.dt(), cols_.tmz()); 
+	}else{
+		std::vector<std::int64_t> dt(cs_.size()); 
+		std::transform(cs_.cbegin(), cs_.cend(), dt.begin(), [](const Candle& c){return c.dt().epoch();}); 
+		idx_ = GridIndex(dt, 60 * static_cast<std::int64_t>(tf_)); 
+		auto tmz = cs_.empty() ? std::chrono::current_zone() : cs_.front().dt().zt().get_time_zone(); 
+		dt_axis_ = std::make_shared<const DatetimeAxis>(std::move(dt), tmz); 
+	}
+}
+std::shared_ptr<const DatetimeAxis> CandleSeries::dt_axis() const{
+	return dt_axis_; 
+}
+std::size_t CandleSeries::index_of(const Datetime& dt) const{
+	std::size_t i = idx_.find(dt.epoch()); 
+	if(i == GridIndex::npos){
+		throw std::runtime_error("index_of: Datetime dt is not in the candle series"); 
+	}
+	return i; 
+}
+std::pair<std::size_t, std::size_t> CandleSeries::index_range(const Datetime& st, const Datetime& end) const{
+	std::size_t first = idx_.lower_bound(st.epoch()); 
+	//one past the last candle with datetime <= end 
+	std::size_t last = idx_.lower_bound(end.epoch() + 1); 
+	return std::make_pair(first, std::max(first, last)); 
+}
+candle_check::Report CandleSeries::validate(std::size_t max_examples){
+	candle_check::Report rep = cols_.size() == std::size_t(cs_size()) ? candle_check::validate(cols_, 31, max_examples) 
+		: candle_check::validate(CandleColumns(cs_), 31, max_examples); 
+	validated_ = rep.ok(); 
+	return rep; 
+}
+bool CandleSeries::validated() const{
+	return validated_; 
+}
+const GapMap& CandleSeries::gaps() const{
+	return gaps_; 
+}
+std::size_t CandleSeries::n_real(const Datetime& st, const Datetime& end) const{
+	if(gaps_.size() != std::size_t(cs_size())){
+		throw std::runtime_error("n_real: The cleaned file does not record which candles were gap filled"); 
+	}
+	auto [first, last] = index_range(st, end); 
+	return gaps_.n_real(first, last); 
+}
+double CandleSeries::fidelity(const Datetime& st, const Datetime& end) const{
+	auto [first, last] = index_range(st, end); 
+	return fidelity_of_(last - first, n_real(st, end)); 
+}
+std::pair<std::vector<Candle>::const_iterator, std::vector<Candle>::const_iterator> CandleSeries::cs_slice(const Datetime& st, const Datetime& end) const{
+	auto [first, last] = index_range(st, end); 
+	return std::make_pair(std::next(cs_.cbegin(), first), std::next(cs_.cbegin(), last)); 
+}
+std::pair<CandleColumns::const_iterator, CandleColumns::const_iterator> CandleSeries::cols_slice(const Datetime& st, const Datetime& end) const{
+	auto [first, last] = index_range(st, end); 
+	return std::make_pair(std::next(cols_.begin(), first), std::next(cols_.begin(), last)); 
+}
+const GridIndex& CandleSeries::grid_index() const{
+	return idx_; 
+}
+
 //functions returning iterators
 
 std::vector<Candle>::const_iterator CandleSeries::cs_it_b() const{
@@ -178,16 +601,32 @@ std::vector<Candle>::const_iterator CandleSeries::cs_it_b() const{
 std::vector<Candle>::const_iterator CandleSeries::cs_it_e() const{
 	return cs_.cend();
 }
-std::vector<CandlePtr>::const_iterator CandleSeries::htf_it_b() const{
-	if(!htf_cs_.empty()){
-		return htf_cs_.cbegin();
+CandleColumns::const_iterator CandleSeries::cols_it_b() const{
+	return cols_.begin(); 
+}
+CandleColumns::const_iterator CandleSeries::cols_it_e() const{
+	return cols_.end(); 
+}
+const CandleColumns& CandleSeries::cols() const{
+	return cols_; 
+}
+void CandleSeries::make_columnar(bool release_rows){
+	cols_ = CandleColumns(cs_); 
+	if(release_rows){
+		//release the memory held by the row storage
+		std::vector<Candle>().swap(cs_); 
+	}
+}
+CandleColumns::const_iterator CandleSeries::htf_it_b() const{
+	if(htf_cs_ && !htf_cs_->empty()){
+		return htf_cs_->begin();
 	}else{
 		throw std::runtime_error("Cannot Return Iterator: htf_cs_ is empty."); 
 	}
 }
-std::vector<CandlePtr>::const_iterator CandleSeries::htf_it_e() const{
-	if(!htf_cs_.empty()){
-		return htf_cs_.cend();
+CandleColumns::const_iterator CandleSeries::htf_it_e() const{
+	if(htf_cs_ && !htf_cs_->empty()){
+		return htf_cs_->end();
 	}else{
 		throw std::runtime_error("Cannot Return Iterator: htf_cs_ is empty.");
 	}
@@ -198,16 +637,16 @@ std::vector<Candle>::const_reverse_iterator CandleSeries::cs_it_rb() const{
 std::vector<Candle>::const_reverse_iterator CandleSeries::cs_it_re() const{
 	return cs_.crend();
 }
-std::vector<CandlePtr>::const_reverse_iterator CandleSeries::htf_it_rb() const{
-	if(!htf_cs_.empty()){
-		return htf_cs_.crbegin();
+std::reverse_iterator<CandleColumns::const_iterator> CandleSeries::htf_it_rb() const{
+	if(htf_cs_ && !htf_cs_->empty()){
+		return std::reverse_iterator<CandleColumns::const_iterator>(htf_cs_->end());
 	}else{
 		throw std::runtime_error("Cannot Return Iterator: htf_cs_ is empty.");
 	}
 }
-std::vector<CandlePtr>::const_reverse_iterator CandleSeries::htf_it_re() const{
-	if(!htf_cs_.empty()){
-		return htf_cs_.crend();
+std::reverse_iterator<CandleColumns::const_iterator> CandleSeries::htf_it_re() const{
+	if(htf_cs_ && !htf_cs_->empty()){
+		return std::reverse_iterator<CandleColumns::const_iterator>(htf_cs_->begin());
 	}else{
 		throw std::runtime_error("Cannot Return Iterator: htf_cs_ is empty.");
 	}
@@ -219,13 +658,18 @@ unsigned short int CandleSeries::tf() const{
 unsigned short int CandleSeries::htf() const{
 	return htf_; 
 }
+const std::string& CandleSeries::symbol() const{
+	return symbol_; 
+}
 
 //compute a vector of CandlePtrs from the base timeframe 
 void CandleSeries::extract_c_ptrs(std::vector<CandlePtr>& c_ptr_v){
 	c_ptr_v.reserve(this->cs_.size());
+	//the per object check is skipped if the whole series passed the bulk validation 
+	bool check = !validated_; 
 	auto fcn = [&](const Candle& c){
 		double v = c.v(); 
-		CandlePtr c_ptr = CandlePtr(c.dt(), c.o(), c.h(), c.l(), c.c(), std::move(v), c.b(), c.a());
+		CandlePtr c_ptr = CandlePtr(c.dt(), c.o(), c.h(), c.l(), c.c(), std::move(v), c.b(), c.a(), check);
 		return c_ptr; 
 	}; 
 	std::transform(cs_it_b(), cs_it_e(), std::back_inserter(c_ptr_v), fcn);  
@@ -237,115 +681,128 @@ void CandleSeries::extract_ts(std::vector<Timestamp<double>>& ts, const std::str
 	/*Note: this is definitely not the best way to do this as I am making copies of all of 
 	the values when creating the Timestamp objects
 	*/
-
-	auto c_ptr_ext = [&](const CandlePtr& c){
-		double val = 0.0; 
-		if(pt == "open"){
-			val = c.o(); 
-		}else if(pt == "high"){
-			val = c.h();  
-		}else if(pt == "low"){
-			val = c.l();  
-		}else if(pt == "close"){
-			val = c.c();  
-		}else if(pt == "hl2"){
-			val = c.hl2(); 
-		}else if(pt == "oc2"){
-			val = c.oc2(); 
-		}else if(pt == "hlc3"){
-			val = c.hlc3(); 
-		}else if(pt == "ohlc4"){
-			val = c.ohlc4(); 
+	//the price type is resolved once & the copy loops are instantiated for each price field 
+	PriceField pf = price_field::from_string(pt); 
+	auto extract = [&](auto field){
+		constexpr PriceField F = decltype(field)::value; 
+		if(tf_min(tf) == tf_){
+			ts.reserve(this->cs_.size()); 
+			std::transform(cs_it_b(), cs_it_e(), std::back_inserter(ts), [&pt](const Candle& c){
+				return Timestamp<double>(c.dt(), price_field::project<F>(c), pt);
+			}); 	 
 		}else{
-			throw std::invalid_argument("simple_ma: Enter a valid price type."); 
+			//the higher timeframe is either cached or computed
+			comp_htf(tf, st);
+			std::vector<double> vals(htf_cs_->size()); 
+			htf_cs_->project<F>(vals); 
+			ts.reserve(vals.size()); 
+			for(std::size_t i = 0; i < vals.size(); i++){
+				ts.push_back(Timestamp<double>((*htf_cs_)[i].dt(), vals[i], pt)); 
+			}
 		}
-		return Timestamp<double>(*c.dt(), std::move(val), pt);
-
 	};
+	price_field::visit(pf, extract); 
+}
 
-	auto c_ext = [&](const Candle& c){
-		double val = 0.0; 
-		if(pt == "open"){
-			val = c.o(); 
-		}else if(pt == "high"){
-			val = c.h();  
-		}else if(pt == "low"){
-			val = c.l();  
-		}else if(pt == "close"){
-			val = c.c();  
-		}else if(pt == "hl2"){
-			val = c.hl2(); 
-		}else if(pt == "oc2"){
-			val = c.oc2(); 
-		}else if(pt == "hlc3"){
-			val = c.hlc3(); 
-		}else if(pt == "ohlc4"){
-			val = c.ohlc4(); 
+void CandleSeries::extract_ts(TimeSeries<double>& ts, const std::string& pt, std::string tf, Datetime st){
+	PriceField pf = price_field::from_string(pt); 
+	std::vector<double> vals; 
+	std::shared_ptr<const DatetimeAxis> axis; 
+	auto extract = [&](auto field){
+		constexpr PriceField F = decltype(field)::value; 
+		if(tf_min(tf) == tf_){
+			axis = dt_axis_; 
+			if(!cs_.empty()){
+				vals.resize(cs_.size()); 
+				std::transform(cs_.cbegin(), cs_.cend(), vals.begin(), [](const Candle& c){return price_field::project<F>(c);}); 
+			}else{
+				vals.resize(cols_.size()); 
+				cols_.project<F>(vals); 
+			}
 		}else{
-			throw std::invalid_argument("simple_ma: Enter a valid price type."); 
-		}
-		return Timestamp<double>(c.dt(), std::move(val), pt);
-
-	}; 
-
-	if(tf_min(tf) == tf_){
-		ts.reserve(this->cs_.size()); 
-		std::transform(cs_it_b(), cs_it_e(), std::back_inserter(ts), c_ext); 	 
-	}else{
-		//Either the higher timeframe has been computed or needs to be computed 	
-		if(tf_min(tf) != htf_){
+			//the higher timeframe is either cached or computed
 			comp_htf(tf, st);
+			axis = std::make_shared<const DatetimeAxis>(htf_cs_->dt(), htf_cs_->tmz()); 
+			vals.resize(htf_cs_->size()); 
+			htf_cs_->project<F>(vals); 
 		}
-		ts.reserve(this->htf_cs_.size()); 
-		std::transform(htf_it_b(), htf_it_e(), std::back_inserter(ts), c_ptr_ext); 
-	}
+	};
+	price_field::visit(pf, extract); 
+	ts = TimeSeries<double>(axis, 0, std::move(vals), pt); 
 }
 
-//version of comp_htf which uses 
 void CandleSeries::comp_htf(std::string htf, Datetime st){
+	htf_cs_ = htf_series(htf, st); 
+	htf_ = tf_min(htf); 
+}
+
+std::shared_ptr<const CandleColumns> CandleSeries::htf_series(std::string htf, Datetime st){
 	unsigned short int htf_i = tf_min(htf); 
-	if(htf_i == htf_ && !htf_cs_.empty()){
+	bool calendar = htf_agg::is_calendar(htf_i); 
+	//check if we can compute the higher timeframe
+	if(!calendar && (htf_i <= tf_ || htf_i % tf_ != 0)){
+		throw std::invalid_argument("comp_htf: htf must be a multiple of the base timeframe"); 
+	}
+	if(calendar && tf_ > 1440){
+		throw std::invalid_argument("comp_htf: calendar timeframes need a base timeframe of at most D1"); 
+	}
+	std::int64_t anchor = st.epoch(); 
+	if(auto cached = htf_cache_.get(htf_i, anchor)){
 		//nothing to do if the timeframe we are looking to compute is already computed 
-		return; 
+		return cached; 
+	}
+	auto out = std::make_shared<CandleColumns>(); 
+	//calendar blocks do not line up with the blocks of other cached timeframes so they are always built from the base timeframe 
+	auto [div_tf, div_cs] = calendar ? std::make_pair<unsigned short int, std::shared_ptr<const CandleColumns>>(0, nullptr) 
+		: htf_cache_.best_divisor(htf_i, anchor); 
+	if(div_cs){
+		out->set_tmz(div_cs->tmz()); 
+		//aggregate the cached timeframe which divides htf (same anchor ==> the blocks line up) 
+		std::vector<std::size_t> bounds = htf_agg::fixed_bounds(0, div_cs->size(), htf_i / div_tf); 
+		htf_agg::reduce(*div_cs, bounds, *out); 
 	}else{
-		if(!htf_cs_.empty()){
-			//if we have a higher timeframe computed but need a different one we erase htf_cs
-			htf_cs_.erase(htf_cs_.begin(), htf_cs_.end()); 
-		}
-		//check if we can compute the higher timeframe
-		if(htf_i % tf_ == 0){
-			//if we can store the higher time frame
-			htf_ = htf_i; 
-		}
 		//check if the start datetime is present in the lower timeframe
-		auto st_it =  std::find_if(cs_.begin(), cs_.end(), [st](const Candle& c){return c.dt() == st;});  
-		if(st_it == cs_.end()){
+		std::size_t n = cs_size(); 
+		std::size_t st_i = idx_.find(anchor); 
+		if(st_i == GridIndex::npos || st_i >= n){
 			throw std::runtime_error("comp_htf: Datetime st not found in cs_"); 
 		}
-		int step = htf_ / tf_;
-		int size = (cs_.size() - std::distance(cs_.begin(), st_it)) / (htf_ / tf_); 
-		htf_cs_.reserve(size);
-		auto end_it = std::next(st_it, size * step); 
-		for(auto it = st_it; it != end_it; std::advance(it, step)){
-			//iterator to the end of the block
-			auto bei = std::next(it, step - 1);
-			auto bei_oa = std::next(bei); //iterator one after the block end
-			//iterators to the candles with the highest high & lowest low in the block
-			auto h_it = std::max_element(it, bei_oa,  [](const Candle& c1, const Candle& c2){return c1.h() < c2.h();});
-			auto l_it = std::min_element(it, bei_oa , [](const Candle& c1, const Candle& c2){return c1.l() < c2.l();});
-			double v = std::accumulate(it, bei_oa, 0.0, [](double val, const Candle& c){return val + c.v();}); 	
-			//bid, ask & close are taken from last candle in the block 
-			//Datetime and open are taken from the first candle in the block 
-			CandlePtr c_ptr = CandlePtr(it->dt(), it->o(), h_it->h(), l_it->l(), bei->c(),
-										std::move(v), bei->b(), bei->a()); 
-			
-			//push the CandlePtr object onto the higher timeframe candle series
-			htf_cs_.push_back(c_ptr); 	
+		//the kernels run on contiguous columns, row storage is copied into columns once
+		CandleColumns rows; 
+		if(cols_.empty()){
+			rows.set_tmz(cs_[st_i].dt().zt().get_time_zone()); 
+			rows.reserve(n - st_i); 
+			for(std::size_t i = st_i; i < n; i++){
+				rows.push_back(cs_[i]); 
+			}
+		}
+		const CandleColumns& src = cols_.empty() ? rows : cols_; 
+		std::size_t first = cols_.empty() ? 0 : st_i; 
+		out->set_tmz(src.tmz()); 
+		std::vector<std::size_t> bounds; 
+		if(calendar){
+			htf_agg::Calendar cal = htf_i == htf_agg::week_tf ? htf_agg::Calendar::week : htf_agg::Calendar::month; 
+			bounds = htf_agg::calendar_bounds(src.dt(), first, src.tmz(), cal); 
+		}else{
+			bounds = htf_agg::fixed_bounds(first, src.size() - first, htf_i / tf_); 
 		}
-		
+		htf_agg::reduce(src, bounds, *out); 
 	}
+	htf_cache_.put(htf_i, anchor, out); 
+	return out; 
 }
 
+void CandleSeries::reset_htf_(){
+	//the cached series were aggregated from the candles which were replaced 
+	htf_cache_.clear(); 
+	htf_cs_.reset(); 
+}
+void CandleSeries::set_htf_cache_cap(std::size_t cap){
+	htf_cache_.set_cap(cap); 
+}
+const HtfCache& CandleSeries::htf_cache() const{
+	return htf_cache_; 
+}
 
 bool CandleSeries::comp_htf_help(std::string tf, Datetime st){
 	bool base_tf = true; 
@@ -353,17 +810,21 @@ bool CandleSeries::comp_htf_help(std::string tf, Datetime st){
 		base_tf = false; 
 		if(this->tf_min(tf) != this->htf()){
 			//if the higher timeframe needs to be computed
-			this->comp_htf(tf, st, "serial"); 
+			this->comp_htf(tf, st); 
 		}
 	}
 	return base_tf; 
 }
 int CandleSeries::cs_size() const{
+	if(cs_.empty()){
+		//the series may only be held in columnar storage
+		return cols_.size(); 
+	}
 	return cs_.size();   
 }
 //return the number of candles in the higher timeframe 
 int CandleSeries::htf_cs_size() const{
-	return htf_cs_.size();   
+	return htf_cs_ ? htf_cs_->size() : 0;   
 }
 //display functions
 
@@ -373,10 +834,10 @@ void CandleSeries::display_cs() const{
 	}
 }
 void CandleSeries::display_htf_cs() const{
-	if(cs_.size() == 0){
+	if(htf_cs_size() == 0){
 		throw std::runtime_error("display_htf_cs: htf_cs_ is empty."); 
 	}
-	for(CandlePtr c : htf_cs_){
+	for(CandleView c : *htf_cs_){
 		c.display(); 
 	}
 }
@@ -389,12 +850,12 @@ void CandleSeries::cs_head(int n) const{
 }
 void CandleSeries::htf_cs_head(int n) const{
 	int u; //head size
-	(htf_cs_.size() >= n)?(u = n):(u = htf_cs_.size());
+	(htf_cs_size() >= n)?(u = n):(u = htf_cs_size());
 	if(u == 0){
 		throw std::runtime_error("diplay_htf_cs: htf_cs_ is empty."); 
 	}
 	for(int i = 0; i < u; i++){
-		htf_cs_[i].display(); 
+		(*htf_cs_)[i].display(); 
 	}
 }
 
@@ -404,111 +865,79 @@ void CandleSeries::display_fid() const{
 }
 //set timeframe function 
 unsigned short int CandleSeries::tf_min(std::string tf) const{
-	if(tf == "M1"){
-		return 1; 
-	}else if(tf == "M5"){
-		return 5; 
-	}else if(tf == "M15"){
-		return 15; 
-	}else if(tf == "M30"){
-		return 30; 
-	}else if(tf == "H1"){
-		return 60; 
-	}else if(tf == "H4"){
-		return 240; 
-	}else if(tf == "D1"){
-		return 1440;   
-	}else{
+	if(tf == "W1"){
+		return htf_agg::week_tf; 
+	}else if(tf == "MN1"){
+		return htf_agg::month_tf; 
+	}
+	//M<n>, H<n> or D<n> with n > 0
+	int mult = 0; 
+	if(tf.size() >= 2){
+		if(tf[0] == 'M'){
+			mult = 1; 
+		}else if(tf[0] == 'H'){
+			mult = 60; 
+		}else if(tf[0] == 'D'){
+			mult = 1440; 
+		}
+	}
+	unsigned long n = 0; 
+	auto [ptr, ec] = std::from_chars(tf.data() + std::min<std::size_t>(tf.size(), 1), tf.data() + tf.size(), n); 
+	if(mult == 0 || ec != std::errc() || ptr != tf.data() + tf.size() || n == 0 || n * mult > 65535){
 		throw std::runtime_error("set_tf: Enter a valid timeframe string."); 
 	}
+	unsigned short int m = static_cast<unsigned short int>(n * mult); 
+	if(htf_agg::is_calendar(m)){
+		//D7 & D30 would clash with the codes of W1 & MN1
+		throw std::runtime_error("set_tf: " + tf + " is reserved, use W1 or MN1 for calendar weeks & months."); 
+	}
+	return m; 
+}
+
+std::string CandleSeries::tf_str_(int tf_in_min) const{
+	if(tf_in_min == htf_agg::week_tf){
+		return "W1"; 
+	}else if(tf_in_min == htf_agg::month_tf){
+		return "MN1"; 
+	}else if(tf_in_min % 1440 == 0){
+		return "D" + std::to_string(tf_in_min / 1440); 
+	}else if(tf_in_min % 60 == 0){
+		return "H" + std::to_string(tf_in_min / 60); 
+	}else{
+		return "M" + std::to_string(tf_in_min); 
+	}
 }
 
 //generate the trading hours vector 
 void CandleSeries::gen_trading_hours(std::string asset_c, int tf_in_min, std::string tmz_o, 
 		std::vector<std::pair<std::chrono::hh_mm_ss<std::chrono::seconds>, std::chrono::hh_mm_ss<std::chrono::seconds>>>& v){
 	using namespace std::chrono; 
-	//get the current day (used to create Eastern timezone open and closing local_times)
-	year_month_day ymd{year_month_day(floor<days>(system_clock::now()))};
-
-	auto est_tmz = std::chrono::locate_zone("America/New_York"); 
-
-	//h, m, s are hour minutes and seconds in eastern time
-	auto conv_to_tmz = [&](int h, int m, int s){
-
-		//get local time of h:m:s for ymd 
-		zoned_time<seconds> est_time{est_tmz, local_days(ymd) + hours{h} + minutes{m} + seconds{s}};
-		zoned_time<seconds> tmz_time{tmz_o, est_time}; 
-		//return the hh_mm_ss of the h:m:s time in tmz 
-		return std::chrono::hh_mm_ss(tmz_time.get_local_time() - std::chrono::floor<std::chrono::days>(tmz_time.get_local_time()));
-	}; 
-
-	if(asset_c == "FX"){
-		//midnight 
-		hh_mm_ss<seconds> midnight{hours{0}};
-		hh_mm_ss<seconds> one_period_before_midnight{hours{24} - minutes{tf_in_min}}; 
-		//sunday trading hours (open 5PM et) 
-		v.push_back(std::make_pair(conv_to_tmz(17, 0, 0), one_period_before_midnight));
-		//monday through friday thursday hours 
-		v.push_back(std::make_pair(midnight, one_period_before_midnight));
-		v.push_back(std::make_pair(midnight, one_period_before_midnight));
-		v.push_back(std::make_pair(midnight, one_period_before_midnight));
-		v.push_back(std::make_pair(midnight, one_period_before_midnight));
-		//friday trading hours (close 5PM et) 
-		v.push_back(std::make_pair(midnight, conv_to_tmz(17, -1*tf_in_min, 0)));
-		//saturday trading hours (not open ==> make open after close) 
-		v.push_back(std::make_pair(one_period_before_midnight, midnight));
-
-	}else if(asset_c == "EQUITIES" || asset_c == "BONDS"){
-		//complete later
-	}else{
+	if(!session_grid::valid_asset(asset_c)){
 		throw std::invalid_argument("gen_trading_hours: Enter a valid asset class"); 
 	}
+	//the hours are computed by SessionHours (the table gen_valid_dt steps the bars with) 
+	SessionHours hours(asset_c, tf_in_min, tmz_cache::zone(tmz_o)); 
+	for(int wd = 0; wd < 7; wd++){
+		auto [open, close] = hours.hours(wd); 
+		v.push_back(std::make_pair(hh_mm_ss<seconds>(seconds{open}), hh_mm_ss<seconds>(seconds{close}))); 
+	}
 }
 
 //generate valid Datetimes for an asset class, timeframe between start and end dates
 void CandleSeries::gen_valid_dt(std::string asset_c, std::string tf, Datetime st, Datetime end, std::vector<Datetime>& valid_dt){
-	int tf_in_min = tf_min(tf);
-
-	//return the number of seconds in an hh_mm_ss object 
-	auto nsec = [](std::chrono::hh_mm_ss<std::chrono::seconds>& hms){
-		return ((360*hms.hours()) + (60*hms.minutes()) + hms.seconds()); 
-	}; 
-
-	//get the timezone of st 
-	auto tmz = std::chrono::locate_zone(st.tmz()); 	
-	if(asset_c == "FX"){
-		//get the trading hours for each day of the week 
-		std::vector<std::pair<std::chrono::hh_mm_ss<std::chrono::seconds>, std::chrono::hh_mm_ss<std::chrono::seconds>>> v; 
-		gen_trading_hours(asset_c, tf_in_min, std::string(st.zt().get_time_zone()->name()), v);
-		//copy the start datetime 
-		Datetime trading_period = st;
-		int i = 0; 
-		while(trading_period <= end){
-			std::chrono::hh_mm_ss<std::chrono::seconds> hms; 
-			trading_period.get_hms(hms);
-			auto hms_in_sec = nsec(hms);
-			auto open_in_sec = nsec(v[trading_period.dn()].first); 
-			auto close_in_sec = nsec(v[trading_period.dn()].second); 
-			if(hms_in_sec < open_in_sec && hms_in_sec < close_in_sec){
-				//if we are before the open and before the close we move the trading period to the open
-				trading_period.roll_time(v[trading_period.dn()].first); 
-			}else if(hms_in_sec > open_in_sec && hms_in_sec > close_in_sec){
-				//if we are after the open and after the close we move to the open on the next day
-				trading_period.roll_time(v[(trading_period.dn() + 1) %  7].first);
-				trading_period.add_days(1); 
-			}
-			//check if we rolled from friday to saturday (if so roll to sunday)
-			if(trading_period.is_sat()){
-				trading_period.roll_time(v[(trading_period.dn() + 1) %  7].first);
-				trading_period.add_days(1); 
-			}
-			valid_dt.push_back(trading_period);
-			i++; 
-			trading_period.add_mins(std::move(tf_in_min));
-		}
-
-	}else if(asset_c == "EQUITIES" || asset_c == "BONDS"){
-		//complete later
+	std::vector<std::int64_t> valid; 
+	gen_valid_dt(asset_c, tf, st, end, valid); 
+	auto tmz = st.zt().get_time_zone(); 
+	valid_dt.reserve(valid_dt.size() + valid.size()); 
+	for(std::int64_t e : valid){
+		valid_dt.push_back(Datetime(std::chrono::sys_seconds{std::chrono::seconds{e}}, tmz)); 
 	}
 }
-
+void CandleSeries::gen_valid_dt(std::string asset_c, std::string tf, Datetime st, Datetime end, std::vector<std::int64_t>& valid){
+	if(!session_grid::valid_asset(asset_c)){
+		throw std::invalid_argument("gen_valid_dt: Enter a valid asset class"); 
+	}
+	//the grid is in the time zone of st 
+	std::vector<std::int64_t> g = session_grid::valid_epochs(asset_c, tf_min(tf), st.zt().get_time_zone(), st.epoch(), end.epoch()); 
+	valid.insert(valid.end(), g.begin(), g.end()); 
+}
@@ -1,8 +1,22 @@
 #pragma once
 #include "../Candle/Candle.h" 
 #include "../Candle/CandlePtr.h"
+#include "../Candle/PriceField.h"
+#include "CandleColumns.h"
+#include "CandleFile.h"
+#include "CompressedCandleFile.h"
+#include "GapMap.h"
+#include "CandleCheck.h"
+#include "MappedFile.h"
+#include "GridIndex.h"
+#include "HtfCache.h"
+#include "HtfAggregate.h"
+#include "RawParser.h"
+#include "TickAggregator.h"
+#include "SessionGrid.h"
 #include "CleanCandleSeriesJson.h"
 #include "../Timestamp/Timestamp.h"
+#include "../Timestamp/TimeSeries.h"
 #include <nlohmann/json.hpp>
 #include <glaze/glaze.hpp>
 #include <fstream>
@@ -11,41 +25,102 @@
 #include <algorithm>
 #include <ranges> 
 #include <execution> 
+#include <cmath>
+#include <charconv>
 
 class CandleSeries{
 	public:
 		//default constructor is used when we wish to perform cleaning & reading separately
 		CandleSeries() = default;
-		//cleaning function (writes to a json file to be read later)
-		void clean(std::string f_in, std::string f_out, std::string tf, std::string asset_c, std::string tmz_i);
+		//cleaning function (writes to a file to be read later) (fmt is "json", "bin" (binary candle file, see CandleFile.h) 
+		//or "zbin" (compressed binary candle file, see CompressedCandleFile.h))
+		//parser is "serial" or "parallel" (the raw file is split into chunks which are parsed on separate threads)
+		void clean(std::string f_in, std::string f_out, std::string tf, std::string asset_c, std::string tmz_i, 
+				std::string fmt = "json", std::string symbol = "", std::string parser = "serial");
+		//append mode: clean only the raw data in f_in which comes after the last candle stored in the cleaned file clean_fn 
+		//& extend clean_fn (f_in may be the full raw history or just the new data) (the gap between the stored & new candles is filled)
+		void append_clean(std::string f_in, std::string clean_fn, std::string asset_c, std::string tmz_i, std::string parser = "serial"); 
+		//clean a raw tick file (dt,bid,ask[,volume[,volume]] with times in tmz_i): the ticks are aggregated into bars for every 
+		//timeframe in tfs in a single pass (see TickAggregator) & the bars for tfs[k] are gap filled & written to f_outs[k]
+		//price (bid, ask or mid) is the tick price used for the open, high, low & close
+		void clean_ticks(std::string f_in, std::vector<std::string> f_outs, std::vector<std::string> tfs, std::string asset_c, 
+				std::string tmz_i, std::string fmt = "json", std::string symbol = "", std::string price = "bid"); 
 		//file name is the cleaned candleseries 
-		void make_clean_htf(std::string clean_ltf_fn, std::string clean_htf_fn, std::string htf, Datetime st); 
-		//reading cleaning data function 
-		void read_clean(std::string fn); 
+		void make_clean_htf(std::string clean_ltf_fn, std::string clean_htf_fn, std::string htf, Datetime st, 
+				std::string fmt = "json", std::string symbol = ""); 
+		//reading cleaning data function (storage is one of "rows" (vector of Candles), "columns" (CandleColumns) or "both")
+		//binary candle files are detected automatically, with storage = "columns" they are memory mapped & not parsed
+		//compressed candle files are detected automatically & decoded into owned storage
+		void read_clean(std::string fn, std::string storage = "rows"); 
+		//read only the candles with st <= datetime <= end from a binary or compressed candle file (throws for json files)
+		//for compressed files only the blocks which overlap the range are decoded 
+		void read_clean_range(std::string fn, Datetime st, Datetime end, std::string storage = "columns"); 
+		//convert a cleaned json file into a binary candle file (fmt is "bin" or "zbin")
+		static void convert_clean(std::string json_fn, std::string bin_fn, std::string symbol = "", std::string fmt = "bin"); 
 		void read_clean2(std::string fn); 
 
 		//accessors to the begin and end iterators for cs_
 		std::vector<Candle>::const_iterator cs_it_b() const; 
 		std::vector<Candle>::const_iterator cs_it_e() const; 
+		//accessors to the begin and end iterators for the columnar storage (iterators dereference to CandleColumns::CandleRef)
+		CandleColumns::const_iterator cols_it_b() const; 
+		CandleColumns::const_iterator cols_it_e() const; 
+		//accessor to the columnar storage (exposes std::span columns)
+		const CandleColumns& cols() const; 
+		//build the columnar storage from cs_ (if release_rows is true cs_ is cleared afterwards)
+		void make_columnar(bool release_rows = false); 
+		//position of the candle with datetime dt in the base timeframe (throws if there is no such candle) 
+		//uses the grid index so the lookup does not scan the series
+		std::size_t index_of(const Datetime& dt) const; 
+		//positions [first, last) of the candles in the base timeframe with st <= datetime <= end 
+		std::pair<std::size_t, std::size_t> index_range(const Datetime& st, const Datetime& end) const; 
+		//iterators to the candles with st <= datetime <= end (row & columnar storage) 
+		std::pair<std::vector<Candle>::const_iterator, std::vector<Candle>::const_iterator> cs_slice(const Datetime& st, const Datetime& end) const; 
+		std::pair<CandleColumns::const_iterator, CandleColumns::const_iterator> cols_slice(const Datetime& st, const Datetime& end) const; 
+		//check the invariants of every candle in the base timeframe in one bulk pass (see CandleCheck.h) 
+		//if the series passes it is marked as validated & the per object checks (e.g. in extract_c_ptrs) are skipped 
+		candle_check::Report validate(std::size_t max_examples = 16); 
+		//true if the series passed validate or was read from a binary or compressed file with the flag validated 
+		bool validated() const; 
+		//provenance of the candles in the base timeframe (bit i is set if candle i is real, see GapMap.h) 
+		//empty if the cleaned file does not record it (files written before the provenance was stored & htf files) 
+		const GapMap& gaps() const; 
+		//number of real (not gap filled) candles & fidelity of the candles with st <= datetime <= end (O(1), throws if gaps() is empty) 
+		std::size_t n_real(const Datetime& st, const Datetime& end) const; 
+		double fidelity(const Datetime& st, const Datetime& end) const; 
+		//accessor to the grid index of the base timeframe (built by read_clean) 
+		const GridIndex& grid_index() const; 
+		//datetimes of the base timeframe shared with the TimeSeries computed from it (built by read_clean) 
+		std::shared_ptr<const DatetimeAxis> dt_axis() const; 
 		//accessors to the begin and end iterators for htf
-		std::vector<CandlePtr>::const_iterator htf_it_b() const;
-		std::vector<CandlePtr>::const_iterator htf_it_e() const; 
+		CandleColumns::const_iterator htf_it_b() const;
+		CandleColumns::const_iterator htf_it_e() const; 
 		//accessors to the begin and end reverse iterators for cs_
 		std::vector<Candle>::const_reverse_iterator cs_it_rb() const; 
 		std::vector<Candle>::const_reverse_iterator cs_it_re() const; 
 		//accessors to the begin and end reverse iterators for htf
-		std::vector<CandlePtr>::const_reverse_iterator htf_it_rb() const;
-		std::vector<CandlePtr>::const_reverse_iterator htf_it_re() const; 
+		std::reverse_iterator<CandleColumns::const_iterator> htf_it_rb() const;
+		std::reverse_iterator<CandleColumns::const_iterator> htf_it_re() const; 
 		//accessors for the timeframes in mins 
 		unsigned short int tf() const; 
 		unsigned short int htf() const; 
+		//accessor for the symbol (only set when reading a binary candle file)
+		const std::string& symbol() const; 
 		//extract a series of CandlePtrs from the base timeframe 
 		void extract_c_ptrs(std::vector<CandlePtr>& c_ptr_v); 
 		//accessor to extract a range view (pt = price type) (tf = timeframe to use) (st = start date is using a higher tf) 
 		void extract_ts(std::vector<Timestamp<double>>& ts, const std::string& pt, std::string tf, Datetime dt = Datetime()); 
-		//Compute the higher tf starting from st
+		//columnar version (ts refers to the datetime axis of the timeframe instead of copying the datetimes) 
+		void extract_ts(TimeSeries<double>& ts, const std::string& pt, std::string tf, Datetime dt = Datetime()); 
+		//Compute the higher tf starting from st & make it the active higher timeframe (htf_it_b etc.)
+		//higher timeframes are cached (keyed by timeframe & st) and are derived from the largest cached timeframe which divides htf 
 		void comp_htf(std::string htf, Datetime st);
 		void comp_htf(std::string htf, Datetime st, std::string x);
+		//returns the higher timeframe series htf starting from st (computed if it is not cached) without changing the active higher timeframe 
+		std::shared_ptr<const CandleColumns> htf_series(std::string htf, Datetime st); 
+		//set the memory cap (in bytes) of the higher timeframe cache & accessor to the cache 
+		void set_htf_cache_cap(std::size_t cap); 
+		const HtfCache& htf_cache() const; 
 		//comp_htf helper takes in tf string and if tf is the base timeframe it returns true, if not it computes htf and returns false
 		bool comp_htf_help(std::string tf, Datetime st); 
 		//return the number of candles in the base timeframe 
@@ -67,16 +142,49 @@ class CandleSeries{
 		void gen_trading_hours(std::string asset_c, int tf_in_min, std::string tmz_o, 
 			std::vector<std::pair<std::chrono::hh_mm_ss<std::chrono::seconds>, std::chrono::hh_mm_ss<std::chrono::seconds>>>& v); 
 
-		//Generate valid datetimes 
+		//Generate valid datetimes (bars of tf stepped from st in the time zone of st & anchored at the session opens, see SessionGrid.h)
 		void gen_valid_dt(std::string asset_c, std::string tf, Datetime st, Datetime end, std::vector<Datetime>& valid_dt); 
+		//same grid as seconds since the unix epoch (no Datetime objects are constructed)
+		void gen_valid_dt(std::string asset_c, std::string tf, Datetime st, Datetime end, std::vector<std::int64_t>& valid); 
 	private:
+		//helpers for clean (parse the raw file, fill the gaps & write the cleaned file)
+		void parse_raw_(const std::string& f_in, const std::string& tmz_i, const std::string& parser, std::vector<RawCandle>& raw) const; 
+		//gaps is set to the provenance of the filled candles
+		std::size_t gap_fill_(const std::vector<RawCandle>& raw, const std::vector<std::int64_t>& valid_dt, std::vector<RawCandle>& filled, 
+				GapMap& gaps, const RawCandle* prev = nullptr) const; 
+		void write_clean_(const std::string& f_out, const std::string& fmt, const std::vector<RawCandle>& rcs, const GapMap& gaps, 
+				int tf, double fidelity, std::size_t n_real, const std::string& symbol) const; 
+		//fidelity of a series of n candles of which n_real are real & the inverse (recover n_real from the fidelity)
+		static double fidelity_of_(std::size_t n, std::size_t n_real); 
+		static std::size_t n_real_of_(std::size_t n, double fidelity); 
+		//inverse of tf_min 
+		std::string tf_str_(int tf_in_min) const; 
+		//build idx_ & dt_axis_ from the datetimes of the base timeframe 
+		void build_index_(); 
+		//drop the cached higher timeframes & htf_cs_ (called whenever the base timeframe is reloaded) 
+		void reset_htf_(); 
+		//finish reading a series decoded into cols_ (builds the rows for storage "rows" or "both", stores the metadata & builds the index) 
+		void finish_read_(double fidelity, int tf, const std::string& symbol, bool validated, const std::string& storage); 
 		//store the timeframe and higher timeframe in minutes 
 		unsigned short int tf_;
 		unsigned short int htf_ = 0;
 		//fidelity is the percentage of real data 
 		double fidelity_ = 1;
+		//the base timeframe passed the bulk validation 
+		bool validated_ = false; 
+		//symbol of the series
+		std::string symbol_; 
 		//candlestick series
 		std::vector<Candle> cs_;
-		//where to store the higher timeframe candle series
-		std::vector<CandlePtr> htf_cs_; 
+		//columnar (structure of arrays) copy of the candlestick series
+		CandleColumns cols_; 
+		//provenance of the candles (empty if unknown) 
+		GapMap gaps_; 
+		//maps datetimes to positions in the base timeframe 
+		GridIndex idx_;
+		std::shared_ptr<const DatetimeAxis> dt_axis_;  
+		//the active higher timeframe candle series
+		std::shared_ptr<const CandleColumns> htf_cs_; 
+		//cache of the computed higher timeframes
+		HtfCache htf_cache_; 
 };
@@ -1,9 +1,14 @@
 #pragma once 
 #include <vector> 
+#include <array> 
+#include <optional> 
+#include <cstdint> 
 #include "../Candle/CandleJson.h"
 //struct to be populated when glaze reads in the file containing the cleaned candle series 
 struct CleanCandleSeriesJson{
 	int tf_; 
 	double fidelity_;
 	std::vector<CandleJson> candle_vec_; 
+	//runs [begin, end) of gap filled candles (missing in files written before the provenance was recorded) 
+	std::optional<std::vector<std::array<std::uint64_t, 2>>> gaps_; 
 }; 
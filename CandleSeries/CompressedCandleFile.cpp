@@ -0,0 +1,364 @@
+#include "CompressedCandleFile.h"
+#include "../Datetime/TmzCache.h"
+#include <vector>
+#include <array>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+
+namespace{
+	//compress the candles of cols into blocks of block_size candles & write them to file_out at byte offset pos
+	//first is the position of cols[0] in the series, the index entries of the new blocks are appended to idx
+	//if gaps (the provenance of cols) is not nullptr the gap filled candles other than the first of each block are not stored
+	void write_blocks(std::ofstream& file_out, const CandleColumns& cols, const GapMap* gaps, std::uint64_t first, std::uint32_t block_size,
+			std::uint64_t& pos, std::vector<CompressedBlock>& idx){
+		const std::array<std::span<const double>, 7> xs = {cols.o(), cols.h(), cols.l(), cols.c(), cols.v(), cols.b(), cols.a()};
+		std::vector<double> stored;
+		for(std::size_t i = 0; i < cols.size(); i += block_size){
+			std::size_t n = std::min<std::size_t>(block_size, cols.size() - i);
+			CompressedBlock blk;
+			std::memset(&blk, 0, sizeof(blk));
+			blk.first_dt = cols.dt()[i];
+			blk.last_dt = cols.dt()[i + n - 1];
+			blk.first = first + i;
+			blk.n = n;
+			auto put = [&](std::size_t k, const std::vector<unsigned char>& bytes){
+				blk.off[k] = pos;
+				file_out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+				pos += bytes.size();
+			};
+			candle_codec::BitWriter w;
+			candle_codec::encode_dt(cols.dt().subspan(i, n), w);
+			put(0, w.finish());
+			if(gaps != nullptr){
+				for(std::size_t j = i; j < i + n; j++){
+					w.put(gaps->real(j), 1);
+				}
+			}
+			put(1, w.finish());
+			for(std::size_t k = 0; k < xs.size(); k++){
+				std::span<const double> x = xs[k].subspan(i, n);
+				if(gaps != nullptr){
+					stored.clear();
+					for(std::size_t j = 0; j < n; j++){
+						if(j == 0 || gaps->real(i + j)){
+							stored.push_back(x[j]);
+						}else if(std::memcmp(&x[j], &x[j - 1], sizeof(double)) != 0){
+							throw std::invalid_argument("CompressedCandleFile::write: gap filled candles must repeat the previous candle");
+						}
+					}
+					x = stored;
+				}
+				candle_codec::encode_xor(x, w);
+				put(k + 2, w.finish());
+			}
+			blk.off[CompressedCandleFile::n_streams_] = pos;
+			idx.push_back(blk);
+		}
+	}
+	//pad the file to a multiple of 8 bytes & write the block index followed by the header (written last so an
+	//incomplete file is never mistaken for a valid one)
+	void write_index(std::ofstream& file_out, CompressedCandleHeader& hdr, std::uint64_t& pos, const std::vector<CompressedBlock>& idx){
+		std::vector<char> pad((8 - pos % 8) % 8, 0);
+		file_out.write(pad.data(), pad.size());
+		pos += pad.size();
+		hdr.n_blocks = idx.size();
+		hdr.index_offset = pos;
+		file_out.write(reinterpret_cast<const char*>(idx.data()), idx.size() * sizeof(CompressedBlock));
+		file_out.seekp(0);
+		file_out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+	}
+}
+
+CompressedCandleFile::CompressedCandleFile(const std::string& fn) : map_{fn} {
+	if(map_.size() < header_size_){
+		throw std::runtime_error("CompressedCandleFile: " + fn + " is too small to be a compressed candle file");
+	}
+	hdr_ = reinterpret_cast<const CompressedCandleHeader*>(map_.data());
+	validate_(fn);
+	idx_ = reinterpret_cast<const CompressedBlock*>(map_.data() + hdr_->index_offset);
+}
+
+void CompressedCandleFile::validate_(const std::string& fn) const{
+	if(std::memcmp(hdr_->magic, magic_, sizeof(magic_)) != 0){
+		throw std::runtime_error("CompressedCandleFile: " + fn + " is not a compressed candle file");
+	}
+	if(hdr_->version != version_){
+		throw std::runtime_error("CompressedCandleFile: " + fn + " has an unsupported version");
+	}
+	if(hdr_->endian != endian_){
+		throw std::runtime_error("CompressedCandleFile: " + fn + " was written on a machine with a different byte order");
+	}
+	if(hdr_->header_size < header_size_ || hdr_->block_size == 0 || hdr_->index_offset < hdr_->header_size 
+			|| hdr_->index_offset % alignof(CompressedBlock) != 0){
+		throw std::runtime_error("CompressedCandleFile: " + fn + " has a corrupt header");
+	}
+	if(map_.size() < hdr_->index_offset || (map_.size() - hdr_->index_offset) / sizeof(CompressedBlock) < hdr_->n_blocks){
+		throw std::runtime_error("CompressedCandleFile: " + fn + " is truncated");
+	}
+	//the blocks must cover [0, n) in order & their streams must lie between the header & the index
+	//(decode_range binary searches the datetime bounds of the blocks so each block needs first_dt <= last_dt)
+	const CompressedBlock* idx = reinterpret_cast<const CompressedBlock*>(map_.data() + hdr_->index_offset);
+	std::uint64_t next = 0, pos = hdr_->header_size;
+	for(std::size_t k = 0; k < hdr_->n_blocks; k++){
+		const CompressedBlock& blk = idx[k];
+		//every block except the last holds exactly block_size candles
+		bool full = k + 1 == hdr_->n_blocks || blk.n == hdr_->block_size;
+		bool ok = blk.first == next && blk.n > 0 && blk.n <= hdr_->block_size && full && blk.first_dt <= blk.last_dt;
+		for(std::size_t c = 0; c <= n_streams_ && ok; c++){
+			ok = blk.off[c] >= pos && blk.off[c] <= hdr_->index_offset;
+			pos = blk.off[c];
+		}
+		if(!ok){
+			throw std::runtime_error("CompressedCandleFile: " + fn + " has a corrupt block index");
+		}
+		next += blk.n;
+	}
+	if(next != hdr_->n){
+		throw std::runtime_error("CompressedCandleFile: " + fn + " has a corrupt block index");
+	}
+}
+
+const CompressedCandleHeader& CompressedCandleFile::header() const{
+	return *hdr_;
+}
+std::string CompressedCandleFile::symbol() const{
+	return std::string(hdr_->symbol, strnlen(hdr_->symbol, sizeof(hdr_->symbol)));
+}
+std::string CompressedCandleFile::tz() const{
+	return std::string(hdr_->tz, strnlen(hdr_->tz, sizeof(hdr_->tz)));
+}
+std::size_t CompressedCandleFile::size() const{
+	return hdr_->n;
+}
+std::size_t CompressedCandleFile::n_blocks() const{
+	return hdr_->n_blocks;
+}
+const CompressedBlock& CompressedCandleFile::block(std::size_t k) const{
+	return idx_[k];
+}
+bool CompressedCandleFile::has_gaps() const{
+	return hdr_->flags & flag_gaps_;
+}
+bool CompressedCandleFile::validated() const{
+	return hdr_->flags & flag_validated_;
+}
+
+std::span<const unsigned char> CompressedCandleFile::stream_(std::size_t k, std::size_t c) const{
+	const CompressedBlock& blk = idx_[k];
+	return std::span<const unsigned char>(reinterpret_cast<const unsigned char*>(map_.data()) + blk.off[c], blk.off[c + 1] - blk.off[c]);
+}
+
+void CompressedCandleFile::decode_block_(std::size_t k, std::vector<std::int64_t>& dt, std::vector<double>* cols, GapMap* gaps) const{
+	std::size_t n = idx_[k].n, at = dt.size();
+	dt.resize(at + n);
+	candle_codec::BitReader r(stream_(k, 0));
+	candle_codec::decode_dt(r, n, dt.data() + at);
+	bool overrun = r.overrun();
+	//stored[j] is true if the values of candle j are stored (every candle if the file has no provenance)
+	std::vector<char> stored(n, 1);
+	std::size_t m = n;
+	if(has_gaps()){
+		candle_codec::BitReader rg(stream_(k, 1));
+		m = 0;
+		for(std::size_t j = 0; j < n; j++){
+			bool real = rg.get(1);
+			if(gaps != nullptr){
+				gaps->push_back(real);
+			}
+			stored[j] = j == 0 || real;
+			m += stored[j];
+		}
+		overrun = overrun || rg.overrun();
+	}
+	for(std::size_t c = 0; c < n_cols_ - 1; c++){
+		cols[c].resize(at + n);
+		double* x = cols[c].data() + at;
+		candle_codec::BitReader rc(stream_(k, c + 2));
+		candle_codec::decode_xor(rc, m, x);
+		overrun = overrun || rc.overrun();
+		if(m < n){
+			//spread the stored values to their positions (back to front so nothing is overwritten before it is moved)
+			//& fill each gap filled candle with the previous candle's value
+			std::size_t s = m;
+			for(std::size_t j = n; j-- > 0;){
+				if(stored[j]){
+					x[j] = x[--s];
+				}
+			}
+			for(std::size_t j = 1; j < n; j++){
+				if(!stored[j]){
+					x[j] = x[j - 1];
+				}
+			}
+		}
+	}
+	if(overrun){
+		throw std::runtime_error("CompressedCandleFile: block " + std::to_string(k) + " is corrupt");
+	}
+}
+
+CandleColumns CompressedCandleFile::decode(std::size_t first, std::size_t last, GapMap* gaps) const{
+	last = std::min<std::size_t>(last, hdr_->n);
+	std::vector<std::int64_t> dt;
+	std::vector<double> cols[n_cols_ - 1];
+	GapMap block_gaps;
+	if(first < last){
+		//blocks [kb, ke) overlap [first, last) (all blocks but the last are full)
+		std::size_t kb = first / hdr_->block_size, ke = (last - 1) / hdr_->block_size + 1;
+		std::size_t n = last - first, skip = first - idx_[kb].first;
+		dt.reserve(n + skip);
+		for(std::vector<double>& col : cols){
+			col.reserve(n + skip);
+		}
+		for(std::size_t k = kb; k < ke; k++){
+			decode_block_(k, dt, cols, gaps != nullptr ? &block_gaps : nullptr);
+		}
+		//trim to [first, last)
+		dt.erase(dt.begin(), dt.begin() + skip);
+		dt.resize(n);
+		for(std::vector<double>& col : cols){
+			col.erase(col.begin(), col.begin() + skip);
+			col.resize(n);
+		}
+		block_gaps = block_gaps.slice(skip, skip + n);
+	}
+	if(gaps != nullptr){
+		*gaps = std::move(block_gaps);
+	}
+	return CandleColumns(std::move(dt), std::move(cols[0]), std::move(cols[1]), std::move(cols[2]), std::move(cols[3]), 
+			std::move(cols[4]), std::move(cols[5]), std::move(cols[6]), tmz_cache::zone(tz()));
+}
+
+CandleColumns CompressedCandleFile::decode_range(std::int64_t st, std::int64_t end, GapMap* gaps) const{
+	const CompressedBlock* b = idx_;
+	const CompressedBlock* e = idx_ + hdr_->n_blocks;
+	//first block which ends at or after st & first block which starts after end
+	const CompressedBlock* kb = std::partition_point(b, e, [st](const CompressedBlock& blk){ return blk.last_dt < st; });
+	const CompressedBlock* ke = std::partition_point(kb, e, [end](const CompressedBlock& blk){ return blk.first_dt <= end; });
+	if(kb == ke || st > end){
+		return decode(0, 0, gaps);
+	}
+	//only the datetimes of the boundary blocks are needed to find the exact positions
+	auto locate = [&](const CompressedBlock& blk, auto pred){
+		std::vector<std::int64_t> dt(blk.n);
+		candle_codec::BitReader r(stream_(&blk - idx_, 0));
+		candle_codec::decode_dt(r, blk.n, dt.data());
+		return blk.first + (std::partition_point(dt.begin(), dt.end(), pred) - dt.begin());
+	};
+	std::size_t first = locate(*kb, [st](std::int64_t x){ return x < st; });
+	std::size_t last = locate(*(ke - 1), [end](std::int64_t x){ return x <= end; });
+	return decode(first, last, gaps);
+}
+
+CandleColumns CompressedCandleFile::decode_all(GapMap* gaps) const{
+	return decode(0, hdr_->n, gaps);
+}
+
+bool CompressedCandleFile::is_compressed_file(const std::string& fn){
+	std::ifstream file(fn, std::ios::binary);
+	char magic[sizeof(magic_)] = {};
+	if(!file.read(magic, sizeof(magic))){
+		return false;
+	}
+	return std::memcmp(magic, magic_, sizeof(magic_)) == 0;
+}
+
+void CompressedCandleFile::write(const std::string& fn, const CandleColumns& cols, int tf, double fidelity, std::uint64_t n_real,
+		const std::string& symbol, std::uint32_t block_size, const GapMap* gaps){
+	if(block_size == 0){
+		throw std::invalid_argument("CompressedCandleFile::write: block size must be positive");
+	}
+	std::string tz(cols.tmz()->name());
+	if(symbol.size() >= sizeof(CompressedCandleHeader::symbol) || tz.size() >= sizeof(CompressedCandleHeader::tz)){
+		throw std::invalid_argument("CompressedCandleFile::write: symbol or time zone name is too long");
+	}
+	if(gaps != nullptr && gaps->size() != cols.size()){
+		throw std::invalid_argument("CompressedCandleFile::write: gaps must have one flag for each candle");
+	}
+	CompressedCandleHeader hdr;
+	std::memset(&hdr, 0, sizeof(hdr));
+	std::memcpy(hdr.magic, magic_, sizeof(magic_));
+	hdr.version = version_;
+	hdr.endian = endian_;
+	hdr.header_size = header_size_;
+	hdr.n = cols.size();
+	hdr.n_real = n_real;
+	hdr.fidelity = fidelity;
+	hdr.tf = tf;
+	hdr.block_size = block_size;
+	hdr.flags = (gaps != nullptr ? flag_gaps_ : 0) | (candle_check::validate(cols, 31, 0).ok() ? flag_validated_ : 0);
+	std::memcpy(hdr.symbol, symbol.data(), symbol.size());
+	std::memcpy(hdr.tz, tz.data(), tz.size());
+
+	std::ofstream file_out(fn, std::ios::binary | std::ios::trunc);
+	if(!file_out.is_open()){
+		throw std::invalid_argument("CompressedCandleFile::write: Unable to open the output file");
+	}
+	//placeholder for the header
+	std::vector<char> blank(sizeof(hdr), 0);
+	file_out.write(blank.data(), blank.size());
+	std::uint64_t pos = sizeof(hdr);
+	std::vector<CompressedBlock> idx;
+	write_blocks(file_out, cols, gaps, 0, block_size, pos, idx);
+	write_index(file_out, hdr, pos, idx);
+	if(!file_out){
+		throw std::runtime_error("CompressedCandleFile::write: Error writing " + fn);
+	}
+}
+
+void CompressedCandleFile::append(const std::string& fn, const CandleColumns& tail, std::uint64_t n_real, double fidelity, 
+		const GapMap* tail_gaps){
+	std::string tmp = fn + ".tmp";
+	{
+		//validates the file
+		CompressedCandleFile file(fn);
+		if(tail.empty()){
+			return;
+		}
+		if(tail_gaps != nullptr && tail_gaps->size() != tail.size()){
+			throw std::invalid_argument("CompressedCandleFile::append: tail_gaps must have one flag for each candle");
+		}
+		CompressedCandleHeader hdr = file.header();
+		//complete blocks are kept as they are, a partial last block is merged with tail
+		std::size_t kept = file.n_blocks();
+		if(kept > 0 && file.block(kept - 1).n < hdr.block_size){
+			kept--;
+		}
+		//end of the streams of the kept blocks & position of the first candle which is compressed again
+		std::uint64_t kept_end = kept > 0 ? file.block(kept - 1).off[n_streams_] : hdr.header_size;
+		std::uint64_t first = kept * std::uint64_t(hdr.block_size);
+		GapMap gaps;
+		CandleColumns rest = file.decode(first, hdr.n, &gaps);
+		rest.reserve(rest.size() + tail.size());
+		for(std::size_t i = 0; i < tail.size(); i++){
+			rest.push_back(tail.dt()[i], tail.o()[i], tail.h()[i], tail.l()[i], tail.c()[i], tail.v()[i], tail.b()[i], tail.a()[i]);
+			if(file.has_gaps()){
+				gaps.push_back(tail_gaps == nullptr || tail_gaps->real(i));
+			}
+		}
+
+		std::ofstream file_out(tmp, std::ios::binary | std::ios::trunc);
+		if(!file_out.is_open()){
+			throw std::runtime_error("CompressedCandleFile::append: Unable to open " + tmp);
+		}
+		std::vector<char> blank(hdr.header_size, 0);
+		file_out.write(blank.data(), blank.size());
+		file_out.write(file.map_.data() + hdr.header_size, kept_end - hdr.header_size);
+		std::uint64_t pos = kept_end;
+		std::vector<CompressedBlock> idx(file.idx_, file.idx_ + kept);
+		write_blocks(file_out, rest, file.has_gaps() ? &gaps : nullptr, first, hdr.block_size, pos, idx);
+		//rest holds the candles of the partial block so only its boundary with the kept blocks is checked separately
+		bool validated = file.validated() && candle_check::validate(rest, 31, 0).ok() && (kept == 0 || rest.dt()[0] > file.block(kept - 1).last_dt);
+		hdr.n = first + rest.size();
+		hdr.n_real = n_real;
+		hdr.fidelity = fidelity;
+		hdr.flags = validated ? hdr.flags | flag_validated_ : hdr.flags & ~flag_validated_;
+		write_index(file_out, hdr, pos, idx);
+		if(!file_out){
+			throw std::runtime_error("CompressedCandleFile::append: Error writing " + tmp);
+		}
+	}
+	//the new file replaces fn once it is complete (& the mapping of fn is released)
+	std::filesystem::rename(tmp, fn);
+}
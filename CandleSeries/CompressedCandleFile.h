@@ -0,0 +1,121 @@
+#pragma once
+#include "CandleColumns.h"
+#include "CandleCodec.h"
+#include "GapMap.h"
+#include "CandleCheck.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <stdexcept>
+
+/*
+	Compressed binary file format for cleaned candle series
+	Layout: a 256 byte header, the compressed blocks & a block index (at header.index_offset). Each block holds up to
+	block_size consecutive candles & each of its 8 columns is a separate bit stream (datetimes: delta of delta,
+	prices & volume: XOR (Gorilla), see CandleCodec.h) so a range of candles is decoded from the blocks which overlap it
+	without touching the rest of the file. Values are stored in the native byte order of the machine that wrote the file.
+	The flag validated is set if the candles passed every check in candle_check (see CandleCheck.h) when they were written.
+	If the flag gaps is set each block also stores the provenance of its candles (one bit per candle, set if the candle is
+	real, see GapMap.h) & the prices & volume of the gap filled candles are not stored (they repeat the previous candle & are
+	filled in when the block is decoded) so only the datetime grid & the real candles take up space.
+*/
+struct CompressedCandleHeader{
+	char magic[8];
+	std::uint32_t version;
+	//0x01020304 written in native byte order
+	std::uint32_t endian;
+	std::uint64_t header_size;
+	//number of candles stored
+	std::uint64_t n;
+	//number of candles which came from the raw data (the rest were gap filled)
+	std::uint64_t n_real;
+	double fidelity;
+	//timeframe in minutes
+	std::int32_t tf;
+	//number of candles per block (the last block may hold fewer)
+	std::uint32_t block_size;
+	std::uint64_t n_blocks;
+	//byte offset of the block index
+	std::uint64_t index_offset;
+	//bit flags (CompressedCandleFile::flag_gaps_ & CompressedCandleFile::flag_validated_)
+	std::uint64_t flags;
+	//null terminated symbol & time zone name
+	char symbol[32];
+	char tz[64];
+	char reserved[80];
+};
+static_assert(sizeof(CompressedCandleHeader) == 256, "CompressedCandleHeader must be 256 bytes");
+
+//block index entry
+struct CompressedBlock{
+	//datetimes of the first & last candle in the block
+	std::int64_t first_dt;
+	std::int64_t last_dt;
+	//position of the first candle in the series & number of candles in the block
+	std::uint64_t first;
+	std::uint64_t n;
+	//stream k is stored in the bytes [off[k], off[k + 1]) of the file
+	//streams: datetimes, provenance (empty if the file does not store it), open, high, low, close, volume, bid & ask
+	std::uint64_t off[10];
+};
+
+//read only memory mapping of a compressed candle file
+class CompressedCandleFile{
+	public:
+		static constexpr char magic_[8] = {'C', 'N', 'D', 'L', 'Z', 'I', 'P', '\0'};
+		static constexpr std::uint32_t version_ = 2;
+		static constexpr std::uint32_t endian_ = 0x01020304;
+		static constexpr std::uint64_t header_size_ = sizeof(CompressedCandleHeader);
+		static constexpr std::size_t n_cols_ = 8;
+		static constexpr std::size_t n_streams_ = n_cols_ + 1;
+		//the file stores the provenance of the candles
+		static constexpr std::uint64_t flag_gaps_ = 1;
+		//the candles passed the bulk validation when they were written
+		static constexpr std::uint64_t flag_validated_ = 2;
+		static constexpr std::uint32_t default_block_size_ = 4096;
+
+		//map the file fn (throws if the file can not be mapped or is not a valid compressed candle file)
+		CompressedCandleFile(const std::string& fn);
+		CompressedCandleFile(const CompressedCandleFile&) = delete;
+		CompressedCandleFile& operator=(const CompressedCandleFile&) = delete;
+		//accessors
+		const CompressedCandleHeader& header() const;
+		std::string symbol() const;
+		std::string tz() const;
+		std::size_t size() const;
+		std::size_t n_blocks() const;
+		const CompressedBlock& block(std::size_t k) const;
+		bool has_gaps() const;
+		bool validated() const;
+		//decode the candles [first, last) (only the blocks which overlap the range are decoded)
+		//if gaps is not nullptr it is set to the provenance of the decoded candles (empty if the file does not store it)
+		CandleColumns decode(std::size_t first, std::size_t last, GapMap* gaps = nullptr) const;
+		//decode the candles with st <= datetime <= end (seconds since the unix epoch)
+		CandleColumns decode_range(std::int64_t st, std::int64_t end, GapMap* gaps = nullptr) const;
+		CandleColumns decode_all(GapMap* gaps = nullptr) const;
+
+		//returns true if fn starts with the compressed candle file magic bytes
+		static bool is_compressed_file(const std::string& fn);
+		//compress cols to fn (gaps is the provenance of the candles, nullptr if it is unknown)
+		//throws if a gap filled candle does not repeat the prices & volume of the previous candle
+		//the candles are validated (see CandleCheck.h) & the flag validated is set if they pass
+		static void write(const std::string& fn, const CandleColumns& cols, int tf, double fidelity, std::uint64_t n_real,
+				const std::string& symbol = "", std::uint32_t block_size = default_block_size_, const GapMap* gaps = nullptr);
+		//append the candles in tail to fn & store the new totals n_real & fidelity in the header
+		//the complete blocks are copied as they are, only the last (partial) block is decoded & compressed again with tail
+		//tail_gaps is the provenance of tail (ignored if the file does not store provenance, nullptr ==> every candle is real)
+		//the flag validated is kept if tail passes the validation & starts after the last stored candle
+		static void append(const std::string& fn, const CandleColumns& tail, std::uint64_t n_real, double fidelity, 
+				const GapMap* tail_gaps = nullptr);
+	private:
+		MappedFile map_;
+		const CompressedCandleHeader* hdr_ = nullptr;
+		const CompressedBlock* idx_ = nullptr;
+		//bit stream of column c of block k
+		std::span<const unsigned char> stream_(std::size_t k, std::size_t c) const;
+		//decode block k & append its candles to the column vectors (& its provenance to gaps)
+		void decode_block_(std::size_t k, std::vector<std::int64_t>& dt, std::vector<double>* cols, GapMap* gaps) const;
+		void validate_(const std::string& fn) const;
+};
@@ -0,0 +1,146 @@
+#include "GapMap.h"
+#include <bit>
+#include <algorithm>
+#include <stdexcept>
+
+GapMap::GapMap(std::vector<std::uint64_t> words, std::size_t n) : n_{n}, words_{std::move(words)} {
+	if(words_.size() < (n_ + 63) / 64){
+		throw std::invalid_argument("GapMap: not enough words for n flags");
+	}
+	words_.resize((n_ + 63) / 64);
+	build_ranks_();
+}
+
+void GapMap::build_ranks_(){
+	if(n_ % 64 != 0){
+		words_.back() &= (std::uint64_t(1) << (n_ % 64)) - 1;
+	}
+	ranks_.clear();
+	ranks_.reserve(words_.size() / words_per_block_ + 1);
+	n_real_ = 0;
+	for(std::size_t w = 0; w < words_.size(); w++){
+		if(w % words_per_block_ == 0){
+			ranks_.push_back(n_real_);
+		}
+		n_real_ += std::popcount(words_[w]);
+	}
+}
+
+void GapMap::reserve(std::size_t n){
+	words_.reserve((n + 63) / 64);
+	ranks_.reserve((n + 64 * words_per_block_ - 1) / (64 * words_per_block_));
+}
+void GapMap::push_back(bool real){
+	if(n_ % 64 == 0){
+		if(words_.size() % words_per_block_ == 0){
+			ranks_.push_back(n_real_);
+		}
+		words_.push_back(0);
+	}
+	if(real){
+		words_.back() |= std::uint64_t(1) << (n_ % 64);
+		n_real_++;
+	}
+	n_++;
+}
+void GapMap::append(const GapMap& g){
+	if(n_ % 64 == 0){
+		//word aligned: the words are copied as they are
+		words_.insert(words_.end(), g.words_.begin(), g.words_.end());
+		n_ += g.n_;
+		build_ranks_();
+		return;
+	}
+	reserve(n_ + g.n_);
+	for(std::size_t i = 0; i < g.n_; i++){
+		push_back(g.real(i));
+	}
+}
+void GapMap::clear(){
+	n_ = 0;
+	n_real_ = 0;
+	words_.clear();
+	ranks_.clear();
+}
+
+std::size_t GapMap::size() const{
+	return n_;
+}
+bool GapMap::empty() const{
+	return n_ == 0;
+}
+bool GapMap::real(std::size_t i) const{
+	return (words_[i / 64] >> (i % 64)) & 1;
+}
+std::size_t GapMap::rank(std::size_t i) const{
+	if(i >= n_){
+		return n_real_;
+	}
+	std::size_t w = i / 64;
+	std::size_t r = ranks_[w / words_per_block_];
+	for(std::size_t k = w - w % words_per_block_; k < w; k++){
+		r += std::popcount(words_[k]);
+	}
+	return r + std::popcount(words_[w] & ((std::uint64_t(1) << (i % 64)) - 1));
+}
+std::size_t GapMap::n_real() const{
+	return n_real_;
+}
+std::size_t GapMap::n_real(std::size_t first, std::size_t last) const{
+	if(first >= last){
+		return 0;
+	}
+	return rank(last) - rank(first);
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> GapMap::gaps(std::size_t first, std::size_t last) const{
+	std::vector<std::pair<std::size_t, std::size_t>> runs;
+	last = std::min(last, n_);
+	std::size_t i = first;
+	//next position in [i, last) with the flag real (last if there is none), whole words are skipped
+	auto next = [this, last](std::size_t i, bool real){
+		while(i < last){
+			std::uint64_t w = real ? words_[i / 64] : ~words_[i / 64];
+			w >>= i % 64;
+			if(w != 0){
+				return std::min(last, i + std::countr_zero(w));
+			}
+			i += 64 - i % 64;
+		}
+		return last;
+	};
+	while(i < last){
+		std::size_t b = next(i, false);
+		if(b == last){
+			break;
+		}
+		std::size_t e = next(b, true);
+		runs.emplace_back(b, e);
+		i = e;
+	}
+	return runs;
+}
+
+GapMap GapMap::slice(std::size_t first, std::size_t last) const{
+	GapMap g;
+	last = std::min(last, n_);
+	if(first >= last){
+		return g;
+	}
+	g.words_.resize((last - first + 63) / 64);
+	for(std::size_t w = 0; w < g.words_.size(); w++){
+		std::size_t i = first + 64 * w;
+		std::uint64_t lo = words_[i / 64] >> (i % 64);
+		if(i % 64 != 0 && i / 64 + 1 < words_.size()){
+			lo |= words_[i / 64 + 1] << (64 - i % 64);
+		}
+		g.words_[w] = lo;
+	}
+	g.n_ = last - first;
+	g.build_ranks_();
+	return g;
+}
+
+std::span<const std::uint64_t> GapMap::words() const{
+	return words_;
+}
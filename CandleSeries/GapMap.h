@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+//Provenance of the candles of a gap filled series: bit i is set if candle i came from the raw data & clear if it was
+//gap filled (a copy of the previous candle, see CandleSeries::gap_fill_). The bits are packed 64 to a word & a rank
+//directory (number of real candles before every 512 bit superblock) answers the count over any range in O(1)
+class GapMap{
+	public:
+		GapMap() = default;
+		//n flags packed in words (flag i is bit i % 64 of words[i / 64], the unused bits of the last word are ignored)
+		GapMap(std::vector<std::uint64_t> words, std::size_t n);
+		//modifiers
+		void reserve(std::size_t n);
+		void push_back(bool real);
+		void append(const GapMap& g);
+		void clear();
+		std::size_t size() const;
+		bool empty() const;
+		//true if candle i is real
+		bool real(std::size_t i) const;
+		//number of real candles in [0, i)
+		std::size_t rank(std::size_t i) const;
+		//number of real candles in the whole map & in [first, last)
+		std::size_t n_real() const;
+		std::size_t n_real(std::size_t first, std::size_t last) const;
+		//runs [begin, end) of gap filled candles in [first, last) (runs which cross the ends of the range are clipped)
+		std::vector<std::pair<std::size_t, std::size_t>> gaps(std::size_t first, std::size_t last) const;
+		//the flags [first, last) as a new map
+		GapMap slice(std::size_t first, std::size_t last) const;
+		//packed flags (for writing the map to a file)
+		std::span<const std::uint64_t> words() const;
+	private:
+		static constexpr std::size_t words_per_block_ = 8;
+		std::size_t n_ = 0;
+		std::size_t n_real_ = 0;
+		std::vector<std::uint64_t> words_;
+		//ranks_[k] = number of real candles before superblock k (words [8k, 8k + 8))
+		std::vector<std::uint64_t> ranks_;
+		//clear the unused bits of the last word & rebuild the rank directory
+		void build_ranks_();
+};
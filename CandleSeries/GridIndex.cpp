@@ -0,0 +1,89 @@
+#include "GridIndex.h"
+#include <stdexcept>
+
+GridIndex::GridIndex(std::span<const std::int64_t> dt, std::int64_t step) : step_{step}, size_{dt.size()} {
+	if(step <= 0){
+		throw std::invalid_argument("GridIndex Constructor: step must be positive");
+	}
+	//split the series into runs of evenly spaced datetimes
+	for(std::size_t i = 0; i < dt.size(); i++){
+		if(i == 0 || dt[i] - dt[i - 1] != step){
+			if(i > 0 && dt[i] <= dt[i - 1]){
+				throw std::invalid_argument("GridIndex Constructor: dt must be strictly increasing");
+			}
+			runs_.push_back(Run{dt[i], i, 0});
+		}
+		runs_.back().n++;
+	}
+	if(runs_.empty()){
+		return;
+	}
+	//build the day table
+	constexpr std::int64_t day = 86400;
+	origin_ = dt.front();
+	std::size_t n_days = static_cast<std::size_t>((dt.back() - origin_) / day) + 1;
+	day_run_.resize(n_days);
+	std::size_t r = 0;
+	for(std::size_t d = 0; d < n_days; d++){
+		while(run_end_(r) <= origin_ + static_cast<std::int64_t>(d) * day){
+			r++;
+		}
+		day_run_[d] = static_cast<std::uint32_t>(r);
+	}
+}
+
+std::int64_t GridIndex::run_end_(std::size_t r) const{
+	return runs_[r].start + static_cast<std::int64_t>(runs_[r].n) * step_;
+}
+std::size_t GridIndex::run_at_(std::int64_t epoch) const{
+	if(runs_.empty() || epoch < origin_){
+		return 0;
+	}
+	std::size_t d = static_cast<std::size_t>((epoch - origin_) / 86400);
+	if(d >= day_run_.size()){
+		return runs_.size();
+	}
+	std::size_t r = day_run_[d];
+	//there are only a few runs in a day
+	while(r < runs_.size() && run_end_(r) <= epoch){
+		r++;
+	}
+	return r;
+}
+
+std::size_t GridIndex::find(std::int64_t epoch) const{
+	std::size_t r = run_at_(epoch);
+	if(r == runs_.size() || epoch < runs_[r].start){
+		return npos;
+	}
+	std::int64_t offset = epoch - runs_[r].start;
+	if(offset % step_ != 0){
+		return npos;
+	}
+	return runs_[r].first + static_cast<std::size_t>(offset / step_);
+}
+std::size_t GridIndex::lower_bound(std::int64_t epoch) const{
+	std::size_t r = run_at_(epoch);
+	if(r == runs_.size()){
+		return size_;
+	}
+	if(epoch <= runs_[r].start){
+		return runs_[r].first;
+	}
+	//round up to the next grid point
+	std::int64_t offset = epoch - runs_[r].start;
+	return runs_[r].first + static_cast<std::size_t>((offset + step_ - 1) / step_);
+}
+
+std::size_t GridIndex::size() const{
+	return size_;
+}
+bool GridIndex::empty() const{
+	return size_ == 0;
+}
+std::size_t GridIndex::n_runs() const{
+	return runs_.size();
+}
+std::int64_t GridIndex::step() const{
+	return step_;
+}
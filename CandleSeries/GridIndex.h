@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+//Maps datetimes (seconds since the unix epoch) to positions in a sorted series which lies on a regular grid (e.g. the output of
+//CandleSeries::clean). The series is stored as runs of evenly spaced datetimes (a new run starts after every closed period) and
+//a table giving the first run for each day so that a lookup is the run table lookup followed by grid arithmetic.
+class GridIndex{
+	public:
+		//returned by find when the datetime is not in the series
+		static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+		GridIndex() = default;
+		//dt must be strictly increasing, step is the grid spacing in seconds
+		GridIndex(std::span<const std::int64_t> dt, std::int64_t step);
+		//position of the datetime epoch in the series (npos if it is not in the series)
+		std::size_t find(std::int64_t epoch) const;
+		//position of the first datetime >= epoch (size() if there is none)
+		std::size_t lower_bound(std::int64_t epoch) const;
+		//accessors
+		std::size_t size() const;
+		bool empty() const;
+		std::size_t n_runs() const;
+		std::int64_t step() const;
+	private:
+		//a run of n evenly spaced datetimes starting at start (first is the position of start in the series)
+		struct Run{
+			std::int64_t start;
+			std::size_t first;
+			std::size_t n;
+		};
+		std::int64_t step_ = 60;
+		std::size_t size_ = 0;
+		std::vector<Run> runs_;
+		//start of day 0 of the day table 
+		std::int64_t origin_ = 0;
+		//day_run_[d] is the first run which ends after origin_ + d days
+		std::vector<std::uint32_t> day_run_;
+		//datetime one step after the last datetime in run r
+		std::int64_t run_end_(std::size_t r) const;
+		//the run containing epoch or the first run after epoch (runs_.size() if there is none)
+		std::size_t run_at_(std::int64_t epoch) const;
+};
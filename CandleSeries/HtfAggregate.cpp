@@ -0,0 +1,93 @@
+#include "HtfAggregate.h"
+#include "RawParser.h"
+#include <algorithm>
+#include <limits>
+
+void htf_agg::reduce(const CandleColumns& src, std::span<const std::size_t> bounds, CandleColumns& out){
+	if(bounds.size() < 2){
+		return;
+	}
+	const double* o = src.o().data();
+	const double* h = src.h().data();
+	const double* l = src.l().data();
+	const double* c = src.c().data();
+	const double* v = src.v().data();
+	const double* b = src.b().data();
+	const double* a = src.a().data();
+	const std::int64_t* dt = src.dt().data();
+	out.reserve(out.size() + bounds.size() - 1);
+	for(std::size_t k = 0; k + 1 < bounds.size(); k++){
+		std::size_t s = bounds[k];
+		std::size_t e = bounds[k + 1];
+		//four independent accumulators so that the reductions map onto vector registers
+		double h0 = h[s], h1 = h[s], h2 = h[s], h3 = h[s];
+		double l0 = l[s], l1 = l[s], l2 = l[s], l3 = l[s];
+		double v0 = 0, v1 = 0, v2 = 0, v3 = 0;
+		std::size_t i = s;
+		for(; i + 4 <= e; i += 4){
+			h0 = std::max(h0, h[i]);
+			h1 = std::max(h1, h[i + 1]);
+			h2 = std::max(h2, h[i + 2]);
+			h3 = std::max(h3, h[i + 3]);
+			l0 = std::min(l0, l[i]);
+			l1 = std::min(l1, l[i + 1]);
+			l2 = std::min(l2, l[i + 2]);
+			l3 = std::min(l3, l[i + 3]);
+			v0 += v[i];
+			v1 += v[i + 1];
+			v2 += v[i + 2];
+			v3 += v[i + 3];
+		}
+		for(; i < e; i++){
+			h0 = std::max(h0, h[i]);
+			l0 = std::min(l0, l[i]);
+			v0 += v[i];
+		}
+		double hi = std::max(std::max(h0, h1), std::max(h2, h3));
+		double lo = std::min(std::min(l0, l1), std::min(l2, l3));
+		//datetime & open come from the first candle, close, bid & ask from the last candle
+		out.push_back(dt[s], o[s], hi, lo, c[e - 1], (v0 + v1) + (v2 + v3), b[e - 1], a[e - 1]);
+	}
+}
+
+std::vector<std::size_t> htf_agg::fixed_bounds(std::size_t first, std::size_t n, std::size_t step){
+	std::vector<std::size_t> bounds;
+	if(step == 0){
+		return bounds;
+	}
+	std::size_t n_blocks = n / step;
+	bounds.reserve(n_blocks + 1);
+	for(std::size_t k = 0; k <= n_blocks && n_blocks > 0; k++){
+		bounds.push_back(first + k * step);
+	}
+	return bounds;
+}
+
+std::vector<std::size_t> htf_agg::calendar_bounds(std::span<const std::int64_t> dt, std::size_t first, const std::chrono::time_zone* tmz, Calendar cal){
+	std::vector<std::size_t> bounds;
+	if(first >= dt.size()){
+		return bounds;
+	}
+	raw_parse::SysToLocal to_local(tmz);
+	//the key of a candle is its local week (counted from sunday 1970.01.04) or its local month
+	auto key = [&](std::int64_t sys_s){
+		std::int64_t local_s = to_local(sys_s);
+		std::int64_t d = local_s >= 0 ? local_s / 86400 : (local_s - 86399) / 86400;
+		if(cal == Calendar::week){
+			std::int64_t w = d - 3;
+			return w >= 0 ? w / 7 : (w - 6) / 7;
+		}
+		std::chrono::year_month_day ymd{std::chrono::sys_days{std::chrono::days{d}}};
+		return static_cast<std::int64_t>(int(ymd.year())) * 12 + static_cast<std::int64_t>(unsigned(ymd.month()));
+	};
+	std::int64_t cur = std::numeric_limits<std::int64_t>::min();
+	for(std::size_t i = first; i < dt.size(); i++){
+		std::int64_t k = key(dt[i]);
+		if(k != cur){
+			bounds.push_back(i);
+			cur = k;
+		}
+	}
+	bounds.push_back(dt.size());
+	return bounds;
+}
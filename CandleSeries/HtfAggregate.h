@@ -0,0 +1,27 @@
+#pragma once
+#include "CandleColumns.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+//Higher timeframe aggregation engine. Blocks of consecutive candles are described by their start positions (bounds) &
+//each block is reduced to one candle in a single pass over the contiguous columns (open of the first candle, highest high,
+//lowest low, summed volume & the close, bid & ask of the last candle)
+namespace htf_agg{
+	//calendar anchored timeframes
+	enum class Calendar{week, month};
+	//timeframe codes (in the minutes of CandleSeries::tf_min) reserved for the calendar timeframes W1 & MN1
+	inline constexpr unsigned short int week_tf = 10080;
+	inline constexpr unsigned short int month_tf = 43200;
+	//true if tf is the code of a calendar timeframe
+	constexpr bool is_calendar(unsigned short int tf){ return tf == week_tf || tf == month_tf; }
+	//block k is [bounds[k], bounds[k + 1]) (the last element of bounds is the end of the last block)
+	void reduce(const CandleColumns& src, std::span<const std::size_t> bounds, CandleColumns& out);
+	//bounds of the complete blocks of step candles in [first, first + n) (a partial final block is dropped)
+	std::vector<std::size_t> fixed_bounds(std::size_t first, std::size_t n, std::size_t step);
+	//bounds of the blocks of [first, dt.size()) which fall in the same local week (weeks start on sunday) or month of tmz
+	//(the final block is kept even if the week or month is not over yet)
+	std::vector<std::size_t> calendar_bounds(std::span<const std::int64_t> dt, std::size_t first, const std::chrono::time_zone* tmz, Calendar cal);
+}
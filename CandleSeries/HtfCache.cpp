@@ -0,0 +1,74 @@
+#include "HtfCache.h"
+#include "CandleFile.h"
+#include "HtfAggregate.h"
+
+HtfCache::HtfCache(std::size_t cap) : cap_{cap} {};
+
+std::shared_ptr<const HtfCache::Series> HtfCache::get(unsigned short int tf, std::int64_t anchor){
+	auto it = map_.find(std::make_pair(tf, anchor));
+	if(it == map_.end()){
+		return nullptr;
+	}
+	//move the entry to the front
+	lru_.splice(lru_.begin(), lru_, it->second);
+	return it->second->cs;
+}
+
+void HtfCache::put(unsigned short int tf, std::int64_t anchor, std::shared_ptr<const Series> cs){
+	auto key = std::make_pair(tf, anchor);
+	auto it = map_.find(key);
+	if(it != map_.end()){
+		bytes_ -= it->second->bytes;
+		lru_.erase(it->second);
+		map_.erase(it);
+	}
+	std::size_t b = bytes_of(*cs);
+	lru_.push_front(Entry{tf, anchor, std::move(cs), b});
+	map_[key] = lru_.begin();
+	bytes_ += b;
+	evict_(1);
+}
+
+std::pair<unsigned short int, std::shared_ptr<const HtfCache::Series>> HtfCache::best_divisor(unsigned short int tf, std::int64_t anchor) const{
+	std::pair<unsigned short int, std::shared_ptr<const Series>> out(0, nullptr);
+	for(const Entry& e : lru_){
+		//the largest divisor needs the fewest candles to be aggregated (calendar blocks do not line up with fixed blocks)
+		if(e.anchor == anchor && !htf_agg::is_calendar(e.tf) && e.tf < tf && tf % e.tf == 0 && e.tf > out.first){
+			out = std::make_pair(e.tf, e.cs);
+		}
+	}
+	return out;
+}
+
+void HtfCache::set_cap(std::size_t cap){
+	cap_ = cap;
+	evict_(0);
+}
+void HtfCache::clear(){
+	lru_.clear();
+	map_.clear();
+	bytes_ = 0;
+}
+
+std::size_t HtfCache::cap() const{
+	return cap_;
+}
+std::size_t HtfCache::bytes() const{
+	return bytes_;
+}
+std::size_t HtfCache::size() const{
+	return lru_.size();
+}
+std::size_t HtfCache::bytes_of(const Series& cs){
+	//8 columns of 8 byte values
+	return sizeof(Series) + cs.size() * CandleFile::n_cols_ * sizeof(double);
+}
+
+void HtfCache::evict_(std::size_t keep){
+	while(bytes_ > cap_ && lru_.size() > keep){
+		const Entry& e = lru_.back();
+		bytes_ -= e.bytes;
+		map_.erase(std::make_pair(e.tf, e.anchor));
+		lru_.pop_back();
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "CandleColumns.h"
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+//Cache of higher timeframe candle series keyed by (timeframe in minutes, epoch of the start datetime).
+//When the estimated memory used by the cached series exceeds the cap the least recently used series are evicted
+//(a series which is still referenced elsewhere stays alive until the last reference is released).
+class HtfCache{
+	public:
+		using Series = CandleColumns;
+		//cap is in bytes
+		HtfCache(std::size_t cap = std::size_t(512) << 20);
+		//returns the cached series (nullptr if it is not cached) & marks it as the most recently used
+		std::shared_ptr<const Series> get(unsigned short int tf, std::int64_t anchor);
+		//add a series to the cache (the series just added is never evicted by this call)
+		void put(unsigned short int tf, std::int64_t anchor, std::shared_ptr<const Series> cs);
+		//the cached series with the same anchor & the largest timeframe which divides tf (tf = 0 & nullptr if there is none)
+		//calendar timeframes (W1 & MN1) are skipped
+		std::pair<unsigned short int, std::shared_ptr<const Series>> best_divisor(unsigned short int tf, std::int64_t anchor) const;
+		//modifiers
+		void set_cap(std::size_t cap);
+		void clear();
+		//accessors
+		std::size_t cap() const;
+		std::size_t bytes() const;
+		std::size_t size() const;
+		//estimated memory used by a series
+		static std::size_t bytes_of(const Series& cs);
+	private:
+		struct Entry{
+			unsigned short int tf;
+			std::int64_t anchor;
+			std::shared_ptr<const Series> cs;
+			std::size_t bytes;
+		};
+		std::size_t cap_;
+		std::size_t bytes_ = 0;
+		//most recently used at the front
+		std::list<Entry> lru_;
+		std::map<std::pair<unsigned short int, std::int64_t>, std::list<Entry>::iterator> map_;
+		//evict from the back of lru_ until bytes_ <= cap_ (keeps at least keep entries)
+		void evict_(std::size_t keep);
+};
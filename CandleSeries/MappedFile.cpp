@@ -0,0 +1,50 @@
+#include "MappedFile.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& fn){
+	fd_ = ::open(fn.c_str(), O_RDONLY);
+	if(fd_ == -1){
+		throw std::runtime_error("MappedFile: Unable to open " + fn);
+	}
+	struct stat st;
+	if(::fstat(fd_, &st) == -1){
+		::close(fd_);
+		throw std::runtime_error("MappedFile: Unable to stat " + fn);
+	}
+	len_ = static_cast<std::size_t>(st.st_size);
+	if(len_ == 0){
+		//mmap does not accept empty mappings
+		return;
+	}
+	addr_ = ::mmap(nullptr, len_, PROT_READ, MAP_SHARED, fd_, 0);
+	if(addr_ == MAP_FAILED){
+		addr_ = nullptr;
+		::close(fd_);
+		throw std::runtime_error("MappedFile: Unable to map " + fn);
+	}
+}
+MappedFile::~MappedFile(){
+	if(addr_ != nullptr){
+		::munmap(addr_, len_);
+	}
+	if(fd_ != -1){
+		::close(fd_);
+	}
+}
+const char* MappedFile::data() const{
+	return static_cast<const char*>(addr_);
+}
+std::size_t MappedFile::size() const{
+	return len_;
+}
+std::string_view MappedFile::view() const{
+	return std::string_view(data(), len_);
+}
+void MappedFile::advise_sequential() const{
+	if(addr_ != nullptr){
+		::madvise(addr_, len_, MADV_SEQUENTIAL);
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+
+//read only memory mapping of a whole file (POSIX mmap), the mapping is released when the object is destroyed
+class MappedFile{
+	public:
+		//map the file fn (throws if the file can not be opened or mapped)
+		MappedFile(const std::string& fn);
+		~MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		//accessors
+		const char* data() const;
+		std::size_t size() const;
+		std::string_view view() const;
+		//hint that the mapping will be read sequentially
+		void advise_sequential() const;
+	private:
+		int fd_ = -1;
+		void* addr_ = nullptr;
+		std::size_t len_ = 0;
+};
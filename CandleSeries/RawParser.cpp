@@ -0,0 +1,295 @@
+#include "RawParser.h"
+#include <algorithm>
+#include <charconv>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+//LocalToSys
+raw_parse::LocalToSys::LocalToSys(const std::chrono::time_zone* tmz) : tmz_{tmz} {};
+
+std::int64_t raw_parse::LocalToSys::operator()(std::int64_t local_s){
+	if(local_s >= lo_ && local_s < hi_){
+		return local_s - off_;
+	}
+	using namespace std::chrono;
+	local_seconds lt{seconds{local_s}};
+	local_info li = tmz_->get_info(lt);
+	if(li.result != local_info::unique){
+		//to_sys throws nonexistent_local_time or ambiguous_local_time (same behaviour as constructing a zoned_time)
+		return tmz_->to_sys(lt).time_since_epoch().count();
+	}
+	off_ = li.first.offset.count();
+	//the time zone database uses very large begin & end values for the first & last intervals
+	const sys_seconds lim_lo = sys_days{year{1800}/1/1};
+	const sys_seconds lim_hi = sys_days{year{2400}/1/1};
+	sys_seconds b = li.first.begin;
+	sys_seconds e = li.first.end;
+	lo_ = std::numeric_limits<std::int64_t>::min();
+	hi_ = std::numeric_limits<std::int64_t>::max();
+	if(b > lim_lo){
+		//if the clocks went back at b the local times just after b + off_ are ambiguous
+		sys_info pv = tmz_->get_info(b - seconds{1});
+		lo_ = b.time_since_epoch().count() + std::max<std::int64_t>(off_, pv.offset.count());
+	}
+	if(e < lim_hi){
+		//if the clocks go back at e the local times just before e + off_ are ambiguous
+		sys_info nx = tmz_->get_info(e);
+		hi_ = e.time_since_epoch().count() + std::min<std::int64_t>(off_, nx.offset.count());
+	}
+	return local_s - off_;
+}
+
+//SysToLocal
+raw_parse::SysToLocal::SysToLocal(const std::chrono::time_zone* tmz) : tmz_{tmz} {};
+
+std::int64_t raw_parse::SysToLocal::operator()(std::int64_t sys_s){
+	if(sys_s >= lo_ && sys_s < hi_){
+		return sys_s + off_;
+	}
+	//the intervals are memoized per zone so a new SysToLocal does not go back to the time zone database
+	tmz_cache::Interval iv = tmz_cache::interval(tmz_, sys_s);
+	off_ = iv.off;
+	lo_ = iv.begin;
+	hi_ = iv.end;
+	return sys_s + off_;
+}
+
+bool raw_parse::parse_line(std::string_view line, LocalToSys& to_sys, RawCandle& rc){
+	//strip trailing whitespace (including \r from windows line endings)
+	while(!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')){
+		line.remove_suffix(1);
+	}
+	if(line.empty()){
+		return false;
+	}
+	auto bad_line = [&](){
+		return std::runtime_error("raw_parse::parse_line: Malformed line: " + std::string(line));
+	};
+	std::size_t p = line.find(',');
+	std::int64_t local_s = 0;
+	if(p == std::string_view::npos || !dt_format::decode(line.substr(0, p), local_s)){
+		throw bad_line();
+	}
+	rc.dt = to_sys(local_s);
+	const char* it = line.data() + p + 1;
+	const char* end = line.data() + line.size();
+	double* fields[7] = {&rc.o, &rc.h, &rc.l, &rc.c, &rc.v, &rc.b, &rc.a};
+	for(std::size_t k = 0; k < 7; k++){
+		while(it != end && *it == ' '){
+			it++;
+		}
+		auto [ptr, ec] = std::from_chars(it, end, *fields[k]);
+		if(ec != std::errc()){
+			throw bad_line();
+		}
+		it = ptr;
+		if(k < 6){
+			if(it == end || *it != ','){
+				throw bad_line();
+			}
+			it++;
+		}
+	}
+	return true;
+}
+
+bool raw_parse::parse_tick_line(std::string_view line, LocalToSys& to_sys, Tick& t){
+	while(!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')){
+		line.remove_suffix(1);
+	}
+	if(line.empty()){
+		return false;
+	}
+	auto bad_line = [&](){
+		return std::runtime_error("raw_parse::parse_tick_line: Malformed line: " + std::string(line));
+	};
+	std::size_t p = line.find(',');
+	std::int64_t local_s = 0;
+	if(p == std::string_view::npos || p < 19 || !dt_format::decode(line.substr(0, 19), local_s)){
+		throw bad_line();
+	}
+	//optional fractional seconds (.mmm)
+	std::int64_t ms = 0;
+	if(p > 19){
+		if(line[19] != '.'){
+			throw bad_line();
+		}
+		std::int64_t scale = 100;
+		for(std::size_t k = 20; k < p; k++){
+			unsigned d = static_cast<unsigned>(line[k] - '0');
+			if(d > 9){
+				throw bad_line();
+			}
+			ms += scale * d;
+			scale /= 10;
+		}
+	}
+	t.dt_ms = 1000 * to_sys(local_s) + ms;
+	const char* it = line.data() + p + 1;
+	const char* end = line.data() + line.size();
+	auto next_field = [&](double& x){
+		while(it != end && *it == ' '){
+			it++;
+		}
+		auto [ptr, ec] = std::from_chars(it, end, x);
+		if(ec != std::errc()){
+			throw bad_line();
+		}
+		it = ptr;
+	};
+	next_field(t.b);
+	if(it == end || *it != ','){
+		throw bad_line();
+	}
+	it++;
+	next_field(t.a);
+	//volumes (bid & ask volumes are summed)
+	t.v = 0;
+	bool has_v = false;
+	while(it != end && *it == ','){
+		it++;
+		double x = 0;
+		next_field(x);
+		t.v += x;
+		has_v = true;
+	}
+	if(it != end){
+		throw bad_line();
+	}
+	if(!has_v){
+		t.v = 1;
+	}
+	return true;
+}
+
+void raw_parse::parse_lines(std::string_view data, const std::chrono::time_zone* tmz, std::vector<RawCandle>& out){
+	LocalToSys to_sys(tmz);
+	//a line is roughly 60 characters
+	out.reserve(out.size() + data.size() / 48);
+	RawCandle rc;
+	while(!data.empty()){
+		std::size_t p = data.find('\n');
+		std::string_view line = data.substr(0, p);
+		if(parse_line(line, to_sys, rc)){
+			out.push_back(rc);
+		}
+		data.remove_prefix(p == std::string_view::npos ? data.size() : p + 1);
+	}
+}
+
+void raw_parse::parse_parallel(std::string_view data, const std::chrono::time_zone* tmz, std::vector<RawCandle>& out, unsigned n_threads){
+	if(n_threads == 0){
+		n_threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	//chunks smaller than 1MB are not worth a thread
+	std::size_t min_chunk = std::size_t(1) << 20;
+	n_threads = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(n_threads, data.size() / min_chunk)));
+	//chunk boundaries (each boundary is moved forward to the start of the next line)
+	std::vector<std::size_t> bounds(n_threads + 1, data.size());
+	bounds[0] = 0;
+	for(unsigned k = 1; k < n_threads; k++){
+		std::size_t pos = std::max(bounds[k - 1], k * data.size() / n_threads);
+		pos = data.find('\n', pos);
+		bounds[k] = pos == std::string_view::npos ? data.size() : pos + 1;
+	}
+	std::vector<std::vector<RawCandle>> chunks(n_threads);
+	std::vector<std::exception_ptr> errors(n_threads);
+	std::vector<std::thread> threads;
+	threads.reserve(n_threads);
+	for(unsigned k = 0; k < n_threads; k++){
+		threads.push_back(std::thread([&, k](){
+			try{
+				parse_lines(data.substr(bounds[k], bounds[k + 1] - bounds[k]), tmz, chunks[k]);
+			}catch(...){
+				errors[k] = std::current_exception();
+			}
+		}));
+	}
+	for(std::thread& t : threads){
+		t.join();
+	}
+	for(std::exception_ptr& e : errors){
+		if(e){
+			std::rethrow_exception(e);
+		}
+	}
+	//the chunks are in file order so appending them keeps sorted input sorted
+	std::size_t total = out.size();
+	for(const std::vector<RawCandle>& chunk : chunks){
+		total += chunk.size();
+	}
+	out.reserve(total);
+	for(const std::vector<RawCandle>& chunk : chunks){
+		out.insert(out.end(), chunk.begin(), chunk.end());
+	}
+}
+
+void raw_parse::parse_serial(std::string_view data, const std::chrono::time_zone* tmz, std::vector<RawCandle>& out){
+	while(!data.empty()){
+		std::size_t p = data.find('\n');
+		std::string line(data.substr(0, p));
+		data.remove_prefix(p == std::string_view::npos ? data.size() : p + 1);
+		while(!line.empty() && (line.back() == '\r' || line.back() == ' ')){
+			line.pop_back();
+		}
+		if(line.empty()){
+			continue;
+		}
+		std::vector<std::size_t> commas;
+		commas.reserve(7);
+		for(std::size_t c = line.find(','); c != std::string::npos; c = line.find(',', c + 1)){
+			commas.push_back(c);
+		}
+		if(commas.size() != 7){
+			throw std::runtime_error("raw_parse::parse_serial: Malformed line: " + line);
+		}
+		RawCandle rc;
+		rc.dt = Datetime(line.substr(0, commas[0]), tmz).epoch();
+		rc.o = std::stod(line.substr(commas[0] + 1, commas[1] - commas[0] - 1));
+		rc.h = std::stod(line.substr(commas[1] + 1, commas[2] - commas[1] - 1));
+		rc.l = std::stod(line.substr(commas[2] + 1, commas[3] - commas[2] - 1));
+		rc.c = std::stod(line.substr(commas[3] + 1, commas[4] - commas[3] - 1));
+		rc.v = std::stod(line.substr(commas[4] + 1, commas[5] - commas[4] - 1));
+		rc.b = std::stod(line.substr(commas[5] + 1, commas[6] - commas[5] - 1));
+		rc.a = std::stod(line.substr(commas[6] + 1));
+		out.push_back(rc);
+	}
+}
+
+void raw_parse::sort_unique(std::vector<RawCandle>& rcs){
+	auto dt_less = [](const RawCandle& x, const RawCandle& y){return x.dt < y.dt;};
+	if(!std::is_sorted(rcs.begin(), rcs.end(), dt_less)){
+		std::stable_sort(rcs.begin(), rcs.end(), dt_less);
+	}
+	auto last = std::unique(rcs.begin(), rcs.end(), [](const RawCandle& x, const RawCandle& y){return x.dt == y.dt;});
+	rcs.erase(last, rcs.end());
+}
+
+std::string_view raw_parse::skip_header(std::string_view data){
+	std::size_t p = data.find('\n');
+	return p == std::string_view::npos ? std::string_view() : data.substr(p + 1);
+}
+
+std::string_view raw_parse::seek_local(std::string_view data, std::int64_t local_s){
+	//lo is always the start of a line which is before local_s (or the start of data)
+	std::size_t lo = 0;
+	std::size_t hi = data.size();
+	while(hi - lo > 4096){
+		std::size_t mid = lo + (hi - lo) / 2;
+		std::size_t nl = data.find('\n', mid);
+		if(nl == std::string_view::npos || nl + 1 >= hi){
+			hi = mid;
+			continue;
+		}
+		std::int64_t t = 0;
+		if(dt_format::decode(data.substr(nl + 1, 19), t) && t < local_s){
+			lo = nl + 1;
+		}else{
+			hi = mid;
+		}
+	}
+	return data.substr(lo);
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "../Datetime/Datetime.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//a candle parsed from a raw data file (dt is the number of seconds since the unix epoch (utc))
+struct RawCandle{
+	std::int64_t dt;
+	double o;
+	double h;
+	double l;
+	double c;
+	double v;
+	double b;
+	double a;
+};
+
+//a bid/ask tick parsed from a raw tick file (dt_ms is the number of milliseconds since the unix epoch (utc))
+//v is the traded volume of the tick (1 if the file has no volume columns ==> bar volumes are tick counts)
+struct Tick{
+	std::int64_t dt_ms;
+	double b;
+	double a;
+	double v;
+};
+
+namespace raw_parse{
+	//converts local times in tmz to utc, the utc offset is cached for the range of local times it is valid for
+	//so that the time zone database is only consulted when a transition is crossed
+	class LocalToSys{
+		public:
+			LocalToSys(const std::chrono::time_zone* tmz);
+			//local_s is the number of seconds since 1970.01.01 00:00:00 local time, returns seconds since the unix epoch
+			//throws (like zoned_time) if local_s is ambiguous or does not exist in tmz
+			std::int64_t operator()(std::int64_t local_s);
+		private:
+			const std::chrono::time_zone* tmz_;
+			//the local times in [lo_, hi_) are unique & have utc offset off_
+			std::int64_t lo_ = 1;
+			std::int64_t hi_ = 0;
+			std::int64_t off_ = 0;
+	};
+	//converts utc times to local times in tmz (the utc offset is cached for the range of utc times it is valid for)
+	class SysToLocal{
+		public:
+			SysToLocal(const std::chrono::time_zone* tmz);
+			//sys_s is the number of seconds since the unix epoch, returns seconds since 1970.01.01 00:00:00 local time
+			std::int64_t operator()(std::int64_t sys_s);
+		private:
+			const std::chrono::time_zone* tmz_;
+			//the utc times in [lo_, hi_) have utc offset off_
+			std::int64_t lo_ = 1;
+			std::int64_t hi_ = 0;
+			std::int64_t off_ = 0;
+	};
+	//parse a single line (dt,o,h,l,c,v,b,a), returns false if the line is blank, throws if the line is malformed
+	bool parse_line(std::string_view line, LocalToSys& to_sys, RawCandle& rc);
+	//parse a single tick line (dt,bid,ask[,volume[,volume]]) where dt is YYYY.MM.DD HH:MM:SS with optional milliseconds (.mmm)
+	//the volume columns are summed, returns false if the line is blank, throws if the line is malformed
+	bool parse_tick_line(std::string_view line, LocalToSys& to_sys, Tick& t);
+	//parse every line in data (data must not contain a header)
+	void parse_lines(std::string_view data, const std::chrono::time_zone* tmz, std::vector<RawCandle>& out);
+	//parse data by splitting it into newline aligned chunks which are parsed on separate threads (n_threads = 0 ==> hardware concurrency)
+	void parse_parallel(std::string_view data, const std::chrono::time_zone* tmz, std::vector<RawCandle>& out, unsigned n_threads = 0);
+	//parse data one line at a time with Datetime & std::stod (reference implementation)
+	void parse_serial(std::string_view data, const std::chrono::time_zone* tmz, std::vector<RawCandle>& out);
+	//sort by datetime & remove duplicate datetimes (the first occurrence is kept)
+	void sort_unique(std::vector<RawCandle>& rcs);
+	//returns the data after the header line
+	std::string_view skip_header(std::string_view data);
+	//data must be sorted by datetime, returns a suffix of data (starting at a line) which contains every line with a local time
+	//>= local_s (found by bisecting data, the suffix may also contain a few lines before local_s)
+	std::string_view seek_local(std::string_view data, std::int64_t local_s);
+}
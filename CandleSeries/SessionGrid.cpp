@@ -0,0 +1,171 @@
+#include "SessionGrid.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace{
+	//floor division & modulo (times before 1970 are negative)
+	std::int64_t floor_div(std::int64_t a, std::int64_t b){
+		return a >= 0 ? a / b : -((-a + b - 1) / b);
+	}
+	std::int64_t floor_mod(std::int64_t a, std::int64_t b){
+		return a - b * floor_div(a, b);
+	}
+}
+
+//OffsetTable
+OffsetTable::OffsetTable(const std::chrono::time_zone* tmz, std::int64_t first, std::int64_t last) : tmz_{tmz} {
+	std::int64_t t = first;
+	while(true){
+		std::chrono::sys_info info = tmz->get_info(std::chrono::sys_seconds{std::chrono::seconds{t}});
+		begins_.push_back(info.begin.time_since_epoch().count());
+		ends_.push_back(info.end.time_since_epoch().count());
+		offs_.push_back(info.offset.count());
+		if(ends_.back() > last || ends_.back() <= t){
+			break;
+		}
+		t = ends_.back();
+	}
+}
+std::size_t OffsetTable::size() const{
+	return offs_.size();
+}
+std::int64_t OffsetTable::begin(std::size_t k) const{
+	return begins_[k];
+}
+std::int64_t OffsetTable::end(std::size_t k) const{
+	return ends_[k];
+}
+std::int64_t OffsetTable::offset(std::size_t k) const{
+	return offs_[k];
+}
+std::size_t OffsetTable::segment_of(std::int64_t sys_s) const{
+	auto it = std::upper_bound(begins_.begin(), begins_.end(), sys_s);
+	return it == begins_.begin() ? 0 : static_cast<std::size_t>(std::distance(begins_.begin(), it) - 1);
+}
+std::int64_t OffsetTable::to_local(std::int64_t sys_s) const{
+	return sys_s + offs_[segment_of(sys_s)];
+}
+std::int64_t OffsetTable::to_sys(std::int64_t local_s) const{
+	//offsets are less than a day & segments are longer so only the neighbours of the first guess can map to local_s
+	std::size_t k = segment_of(local_s - offs_[segment_of(local_s)]);
+	int found = 0;
+	std::int64_t sys_s = 0;
+	for(std::size_t j = k > 0 ? k - 1 : 0; j <= k + 1 && j < offs_.size(); j++){
+		std::int64_t s = local_s - offs_[j];
+		if((j == 0 || s >= begins_[j]) && (j + 1 == offs_.size() || s < ends_[j])){
+			found++;
+			sys_s = s;
+		}
+	}
+	if(found != 1){
+		//to_sys throws nonexistent_local_time or ambiguous_local_time (same behaviour as constructing a zoned_time)
+		return tmz_->to_sys(std::chrono::local_seconds{std::chrono::seconds{local_s}}).time_since_epoch().count();
+	}
+	return sys_s;
+}
+
+//SessionHours
+SessionHours::SessionHours(const std::string& asset_c, unsigned short int tf, const std::chrono::time_zone* tmz) : 
+		cal_{&ExchangeCalendar::of(asset_c)}, tf_s_{60 * static_cast<std::int64_t>(tf)} {
+	if(tf == 0){
+		throw std::invalid_argument("SessionHours: tf must be positive");
+	}
+	//seconds of the day in tmz of ny_s seconds after midnight today in New York (as gen_trading_hours converts the session times)
+	raw_parse::LocalToSys ny_to_sys(tmz_cache::zone("America/New_York"));
+	raw_parse::SysToLocal to_local(tmz);
+	std::int64_t today = floor_div(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()), 86400);
+	auto conv = [&](std::int64_t ny_s){
+		return floor_mod(to_local(ny_to_sys(86400 * today + ny_s)), 86400);
+	};
+	std::int64_t midnight = 0;
+	std::int64_t last_bar = 86400 - tf_s_;
+	if(asset_c == "FX"){
+		//sunday opens at 17:00 New York time, friday closes at 17:00 New York time & saturday is closed (open after close)
+		week_[0] = std::make_pair(conv(17 * 3600), last_bar);
+		for(int wd = 1; wd < 5; wd++){
+			week_[wd] = std::make_pair(midnight, last_bar);
+		}
+		week_[5] = std::make_pair(midnight, conv(17 * 3600 - tf_s_));
+		week_[6] = std::make_pair(last_bar, midnight);
+	}else{
+		for(int wd = 0; wd < 7; wd++){
+			auto [open, close] = cal_->regular_session(wd);
+			week_[wd] = open == close ? std::make_pair(last_bar, midnight) : std::make_pair(conv(60 * open), conv(60 * close - tf_s_));
+		}
+	}
+}
+std::int64_t SessionHours::tf_s() const{
+	return tf_s_;
+}
+std::pair<std::int64_t, std::int64_t> SessionHours::hours(int wd) const{
+	return week_[wd];
+}
+std::pair<std::int64_t, std::int64_t> SessionHours::day_hours(std::int64_t day) const{
+	//1970.01.01 was a thursday (0 = sunday)
+	int wd = static_cast<int>(floor_mod(day + 4, 7));
+	if(closed(day)){
+		//open after close (as the weekly closed days)
+		return std::make_pair(86400 - tf_s_, std::int64_t(0));
+	}
+	if(cal_->is_early_close(day)){
+		//the last bar start moves back by the time the session closes early
+		int reg_close = cal_->regular_session(wd).second;
+		return std::make_pair(week_[wd].first, floor_mod(week_[wd].second - 60 * (reg_close - cal_->session(day).second), 86400));
+	}
+	return week_[wd];
+}
+bool SessionHours::closed(std::int64_t day) const{
+	auto [open, close] = cal_->session(day);
+	return open == close;
+}
+std::int64_t SessionHours::last_closed_day(std::int64_t day) const{
+	std::int64_t d = day - 1;
+	while(d > day - 7 && !closed(d)){
+		d--;
+	}
+	return d;
+}
+std::int64_t SessionHours::settle(std::int64_t local_s) const{
+	std::int64_t day = floor_div(local_s, 86400);
+	std::int64_t sod = local_s - 86400 * day;
+	auto [open, close] = day_hours(day);
+	if(sod < open && sod < close){
+		//before the open ==> the open
+		local_s = 86400 * day + open;
+	}else if(sod > open && sod > close){
+		//after the last bar start ==> the open of the next day
+		local_s = 86400 * (day + 1) + day_hours(day + 1).first;
+	}
+	//a closed day (e.g. saturday for FX) ==> the open of the next day
+	for(day = floor_div(local_s, 86400); closed(day); day++){
+		local_s = 86400 * (day + 1) + day_hours(day + 1).first;
+	}
+	return local_s;
+}
+
+//session_grid
+bool session_grid::valid_asset(const std::string& asset_c){
+	return ExchangeCalendar::valid(asset_c);
+}
+
+std::vector<std::int64_t> session_grid::valid_epochs(const std::string& asset_c, unsigned short int tf, const std::chrono::time_zone* tmz,
+		std::int64_t st, std::int64_t end){
+	if(tf == 0){
+		throw std::invalid_argument("valid_epochs: tf must be positive");
+	}
+	std::vector<std::int64_t> out;
+	if(end < st){
+		return out;
+	}
+	SessionHours hours(asset_c, tf, tmz);
+	//the last bar can be moved past end to the next open (a long weekend at most)
+	OffsetTable offs(tmz, st, end + 7 * 86400);
+	std::int64_t local_s = offs.to_local(st);
+	for(std::int64_t s = st; s <= end; s = offs.to_sys(local_s)){
+		local_s = hours.settle(local_s);
+		out.push_back(offs.to_sys(local_s));
+		//the bars are stepped in local time
+		local_s += hours.tf_s();
+	}
+	return out;
+}
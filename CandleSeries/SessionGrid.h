@@ -0,0 +1,77 @@
+#pragma once
+#include "RawParser.h"
+#include "../Datetime/ExchangeCalendar.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+//UTC offsets of a time zone over a span of utc times. The transitions are read from the time zone database once
+//(one get_info call per transition) so that the offsets can be looked up without touching the database
+class OffsetTable{
+	public:
+		//covers the utc times [first, last] (seconds since the unix epoch)
+		OffsetTable(const std::chrono::time_zone* tmz, std::int64_t first, std::int64_t last);
+		//number of segments (utc ranges with a constant offset)
+		std::size_t size() const;
+		//segment k is [begin(k), end(k)) with utc offset offset(k) (in seconds)
+		std::int64_t begin(std::size_t k) const;
+		std::int64_t end(std::size_t k) const;
+		std::int64_t offset(std::size_t k) const;
+		//segment containing sys_s (the first/last segment for times outside the span)
+		std::size_t segment_of(std::int64_t sys_s) const;
+		//seconds since 1970.01.01 00:00:00 local time
+		std::int64_t to_local(std::int64_t sys_s) const;
+		//inverse of to_local, throws (like zoned_time) if local_s is ambiguous or does not exist in the time zone
+		std::int64_t to_sys(std::int64_t local_s) const;
+	private:
+		const std::chrono::time_zone* tmz_;
+		std::vector<std::int64_t> begins_;
+		std::vector<std::int64_t> ends_;
+		std::vector<std::int64_t> offs_;
+};
+
+//Session hours of an asset class in local time of a time zone & the rules gen_valid_dt steps the bars with. The hours of each
+//weekday are the open & the last bar start of tf minutes as seconds of the day (the table gen_trading_hours returns, the New
+//York session times are converted with the utc offsets of today): FX opens on Sunday at 17:00 & closes on Friday at 17:00
+//New York time, EQUITIES & BONDS follow the regular sessions of their exchange calendar (see Datetime/ExchangeCalendar.h)
+//with the holidays & early closes of the calendar applied per day. A closed day has its open after its last bar start
+//Note: days are counted from 1970.01.01 local time & the calendar is read for the same date
+class SessionHours{
+	public:
+		SessionHours(const std::string& asset_c, unsigned short int tf, const std::chrono::time_zone* tmz);
+		std::int64_t tf_s() const;
+		//regular hours of weekday wd (0 = sunday)
+		std::pair<std::int64_t, std::int64_t> hours(int wd) const;
+		//hours of day (holidays & early closes included)
+		std::pair<std::int64_t, std::int64_t> day_hours(std::int64_t day) const;
+		//true if the calendar has no session on day (e.g. saturday for FX)
+		bool closed(std::int64_t day) const;
+		//last closed day before day (e.g. the saturday before an FX week, day - 7 if there is none within a week)
+		std::int64_t last_closed_day(std::int64_t day) const;
+		//bar start for the local time local_s (seconds since 1970.01.01 00:00:00 local time): a time before the open of its day
+		//moves to the open, a time after the last bar start of its day moves to the open of the next day & a time on a closed
+		//day moves to the open of the next day which is not closed (local_s is returned if it is a bar start)
+		std::int64_t settle(std::int64_t local_s) const;
+	private:
+		const ExchangeCalendar* cal_;
+		std::int64_t tf_s_;
+		std::array<std::pair<std::int64_t, std::int64_t>, 7> week_;
+};
+
+//Valid datetime (bar start) generation. The session hours are computed once & the utc offsets are read from an OffsetTable
+//for the requested span, so the bars are stepped with integer arithmetic (no per bar time zone conversions).
+//As in the original gen_valid_dt the bars are stepped by tf in local time from the start time & each bar is moved by the rules
+//of SessionHours::settle, so the bars are anchored at the session open (for FX the sunday open & after that the start of
+//each day once a step passes the last bar start of the day)
+namespace session_grid{
+	//true if asset_c is FX, EQUITIES or BONDS
+	bool valid_asset(const std::string& asset_c);
+	//utc start times of the valid bars of tf minutes (local time of tmz) stepped from st while the step is <= end
+	//(the last bar may be moved past end to the next open, as gen_valid_dt always did)
+	std::vector<std::int64_t> valid_epochs(const std::string& asset_c, unsigned short int tf, const std::chrono::time_zone* tmz,
+			std::int64_t st, std::int64_t end);
+}
@@ -0,0 +1,151 @@
+#include "TickAggregator.h"
+#include <algorithm>
+#include <stdexcept>
+
+TickAggregator::TickAggregator(std::vector<unsigned short int> tfs, std::string asset_c, const std::chrono::time_zone* tmz,
+		std::string price, BarFn on_bar) : tfs_{std::move(tfs)}, asset_c_{std::move(asset_c)}, tmz_{tmz}, on_bar_{std::move(on_bar)},
+		to_local_{tmz}, to_sys_{tmz} {
+	if(!session_grid::valid_asset(asset_c_)){
+		throw std::invalid_argument("TickAggregator: Enter a valid asset class");
+	}
+	if(price == "bid"){
+		price_ = 0;
+	}else if(price == "ask"){
+		price_ = 1;
+	}else if(price == "mid"){
+		price_ = 2;
+	}else{
+		throw std::invalid_argument("TickAggregator: price must be bid, ask or mid");
+	}
+	if(tfs_.empty()){
+		throw std::invalid_argument("TickAggregator: Enter at least one timeframe");
+	}
+	bars_.reserve(tfs_.size());
+	for(unsigned short int tf : tfs_){
+		if(tf == 0){
+			throw std::invalid_argument("TickAggregator: timeframes must be positive");
+		}
+		bars_.push_back(Bar{tf, 60 * static_cast<std::int64_t>(tf), no_bar_, RawCandle{}, {}, SessionHours(asset_c_, tf, tmz_)});
+	}
+}
+
+bool TickAggregator::in_session(std::int64_t sys_s){
+	//sessions open & close on whole minutes so the check is made once per minute
+	std::int64_t m = sys_s >= 0 ? sys_s / 60 : (sys_s - 59) / 60;
+	if(m != sess_min_){
+		sess_min_ = m;
+		sess_open_ = !Datetime(std::chrono::sys_seconds{std::chrono::seconds{sys_s}}, tmz_).is_closed(asset_c_);
+	}
+	return sess_open_;
+}
+
+void TickAggregator::push(const Tick& t){
+	if(t.dt_ms < last_ms_){
+		throw std::invalid_argument("TickAggregator::push: Ticks must be pushed in time order");
+	}
+	last_ms_ = t.dt_ms;
+	n_ticks_++;
+	std::int64_t sys_s = t.dt_ms >= 0 ? t.dt_ms / 1000 : (t.dt_ms - 999) / 1000;
+	if(!in_session(sys_s)){
+		n_dropped_++;
+		return;
+	}
+	double px = price_ == 0 ? t.b : (price_ == 1 ? t.a : (t.b + t.a) / 2);
+	std::int64_t local_s = to_local_(sys_s);
+	for(Bar& b : bars_){
+		std::int64_t start = bar_start_(b, sys_s, local_s);
+		if(start != b.start){
+			emit_(b);
+			b.start = start;
+			b.bar = RawCandle{start, px, px, px, px, 0.0, t.b, t.a};
+		}
+		RawCandle& rc = b.bar;
+		rc.h = std::max(rc.h, px);
+		rc.l = std::min(rc.l, px);
+		rc.c = px;
+		rc.v += t.v;
+		rc.b = t.b;
+		rc.a = t.a;
+	}
+}
+
+std::int64_t TickAggregator::bar_start_(Bar& b, std::int64_t sys_s, std::int64_t local_s){
+	if(b.next == no_bar_){
+		//the grid is stepped from the open after the last closed day before the first tick (the sunday open for FX)
+		b.next_l = b.hours.settle(86400 * b.hours.last_closed_day(local_s >= 0 ? local_s / 86400 : (local_s - 86399) / 86400));
+		b.next = to_sys_(b.next_l);
+		b.grid = b.next;
+	}
+	//step the grid (as gen_valid_dt does) up to the last bar start <= sys_s
+	while(b.next <= sys_s){
+		b.grid = b.next;
+		b.next_l = b.hours.settle(b.next_l + b.tf_s);
+		b.next = to_sys_(b.next_l);
+	}
+	return b.grid;
+}
+
+void TickAggregator::push_file(const std::string& fn, const std::string& tmz_i){
+	MappedFile file(fn);
+	file.advise_sequential();
+	std::string_view data = file.view();
+	//skip the header line if the file has one
+	std::int64_t tmp = 0;
+	if(!data.empty() && !dt_format::decode(data.substr(0, 19), tmp)){
+		data = raw_parse::skip_header(data);
+	}
+	raw_parse::LocalToSys to_sys(tmz_cache::zone(tmz_i));
+	Tick t;
+	while(!data.empty()){
+		std::size_t p = data.find('\n');
+		if(raw_parse::parse_tick_line(data.substr(0, p), to_sys, t)){
+			push(t);
+		}
+		data.remove_prefix(p == std::string_view::npos ? data.size() : p + 1);
+	}
+}
+
+void TickAggregator::flush(){
+	for(Bar& b : bars_){
+		emit_(b);
+	}
+}
+
+void TickAggregator::emit_(Bar& b){
+	if(b.start == no_bar_){
+		return;
+	}
+	if(on_bar_){
+		on_bar_(b.tf, b.bar);
+	}else{
+		b.out.push_back(b.bar);
+	}
+	b.start = no_bar_;
+}
+
+const std::vector<unsigned short int>& TickAggregator::tfs() const{
+	return tfs_;
+}
+const std::vector<RawCandle>& TickAggregator::bars(unsigned short int tf) const{
+	auto it = std::find_if(bars_.cbegin(), bars_.cend(), [tf](const Bar& b){return b.tf == tf;});
+	if(it == bars_.cend()){
+		throw std::invalid_argument("TickAggregator::bars: tf is not one of the aggregated timeframes");
+	}
+	return it->out;
+}
+std::vector<Candle> TickAggregator::candles(unsigned short int tf) const{
+	const std::vector<RawCandle>& rcs = bars(tf);
+	std::vector<Candle> cs;
+	cs.reserve(rcs.size());
+	for(const RawCandle& rc : rcs){
+		cs.push_back(Candle(Datetime(std::chrono::sys_seconds{std::chrono::seconds{rc.dt}}, tmz_), double(rc.o), double(rc.h),
+					double(rc.l), double(rc.c), double(rc.v), double(rc.b), double(rc.a)));
+	}
+	return cs;
+}
+std::size_t TickAggregator::n_ticks() const{
+	return n_ticks_;
+}
+std::size_t TickAggregator::n_dropped() const{
+	return n_dropped_;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "../Candle/Candle.h"
+#include "RawParser.h"
+#include "SessionGrid.h"
+#include "MappedFile.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+//Streaming tick to bar aggregator. Ticks are pushed in time order & the bars of several timeframes are built in one pass
+//(only the bar in progress for each timeframe is kept so memory use does not depend on the number of ticks).
+//Bars start on the session anchored grid gen_valid_dt produces (see SessionHours in SessionGrid.h), stepped from the open of the
+//session of the first tick, & ticks which fall outside the trading session of the asset class (see Datetime::is_closed) are dropped.
+//o, h, l & c come from the bid, ask or mid price of the ticks, b & a are the bid & ask of the last tick in the bar
+//& v is the sum of the tick volumes.
+class TickAggregator{
+	public:
+		//called with the timeframe (in minutes) & the bar each time a bar is completed
+		using BarFn = std::function<void(unsigned short int tf, const RawCandle& bar)>;
+		//tfs are timeframes in minutes, price is bid, ask or mid
+		//if on_bar is empty the completed bars are collected (see bars & candles)
+		TickAggregator(std::vector<unsigned short int> tfs, std::string asset_c, const std::chrono::time_zone* tmz = std::chrono::current_zone(),
+				std::string price = "bid", BarFn on_bar = nullptr);
+		//add a tick (ticks must be pushed in time order, throws if a tick is older than the previous tick)
+		void push(const Tick& t);
+		//stream the ticks in the raw tick file fn (times in tmz_i) through push (the header line, if any, is skipped)
+		void push_file(const std::string& fn, const std::string& tmz_i);
+		//complete the bars in progress
+		void flush();
+		//true if the asset class is trading at sys_s (seconds since the unix epoch)
+		bool in_session(std::int64_t sys_s);
+		//accessors
+		const std::vector<unsigned short int>& tfs() const;
+		//bars collected for timeframe tf (empty if a callback was given)
+		const std::vector<RawCandle>& bars(unsigned short int tf) const;
+		//collected bars as Candles (datetimes in tmz)
+		std::vector<Candle> candles(unsigned short int tf) const;
+		std::size_t n_ticks() const;
+		//number of ticks dropped because they were outside the trading session
+		std::size_t n_dropped() const;
+	private:
+		struct Bar{
+			unsigned short int tf;
+			std::int64_t tf_s;
+			//utc start of the bar in progress (none in progress if start == no_bar_)
+			std::int64_t start;
+			RawCandle bar;
+			std::vector<RawCandle> out;
+			SessionHours hours;
+			//utc start of the grid bar containing the last tick & utc/local start of the grid bar after it (no_bar_ before the first tick)
+			std::int64_t grid = no_bar_;
+			std::int64_t next = no_bar_;
+			std::int64_t next_l = 0;
+		};
+		static constexpr std::int64_t no_bar_ = std::numeric_limits<std::int64_t>::min();
+		std::vector<unsigned short int> tfs_;
+		std::vector<Bar> bars_;
+		std::string asset_c_;
+		const std::chrono::time_zone* tmz_;
+		//0 = bid, 1 = ask, 2 = mid
+		int price_;
+		BarFn on_bar_;
+		raw_parse::SysToLocal to_local_;
+		raw_parse::LocalToSys to_sys_;
+		std::int64_t last_ms_ = std::numeric_limits<std::int64_t>::min();
+		std::size_t n_ticks_ = 0;
+		std::size_t n_dropped_ = 0;
+		//minute of the last session check & its result
+		std::int64_t sess_min_ = no_bar_;
+		bool sess_open_ = false;
+		//finish the bar in progress for b
+		void emit_(Bar& b);
+		//utc start of the grid bar of b containing the tick at sys_s (local time local_s)
+		std::int64_t bar_start_(Bar& b, std::int64_t sys_s, std::int64_t local_s);
+};
@@ -9,6 +9,7 @@
 
 //Note: methods are templated so that they work on Candle or CandlePtr objects
 //Objects must have .o, .c, .h, .l, .hml methods
+//Functions which take a size measure type string dispatch it once per call through size_unary (not for every candle)
 namespace cand_pat{
 	/*
 	 Single Candle Candlestick Patterns
@@ -32,6 +33,22 @@ namespace cand_pat{
 	//serves as a selector for different size types of a candle
 	template <typename C, typename T> 
 	T size_measure(const C& c, T ex, std::string type);
+	//size types of a candle (the strings accepted by size_measure are mapped to these by size_measure_of)
+	enum class SizeMeasure{hml, body, max_wick_to_body, mean_wick_to_body, mean_body_and_wick_to_body}; 
+	//"high minus low", "body", "max wick to body", "mean wick to body" or "mean of body and wick to body" (throws for any other string)
+	inline SizeMeasure size_measure_of(const std::string& type); 
+	//size measure selected at compile time
+	template <SizeMeasure M, typename C, typename T> 
+	T size_measure(const C& c, T ex); 
+	//size measure selected by an enum
+	template <typename C, typename T> 
+	T size_measure(const C& c, T ex, SizeMeasure meas); 
+	//unary size measure of the candles with the measure fixed at compile time
+	template <SizeMeasure M, typename T> 
+	auto size_unary(T init); 
+	//maps type once & calls f with the matching size_unary<M>(init) (the pattern loops are compiled per measure with no switch per candle)
+	template <typename T, typename F> 
+	void size_unary(const std::string& type, T init, F f); 
 	template <typename C, typename T> 
 	T top_wick(const C& c, T ex); 	
 	template <typename C, typename T> 
@@ -337,20 +354,63 @@ T cand_pat::bottom_wick(const C& c, T ex){
 }
 template <typename C, typename T> 
 T cand_pat::size_measure(const C& c, T ex, std::string type){
+	return size_measure(c, ex, size_measure_of(type)); 
+}
+cand_pat::SizeMeasure cand_pat::size_measure_of(const std::string& type){
 	if(type == "high minus low"){
-		return c.h() - c.l(); 	
+		return SizeMeasure::hml; 
 	}else if(type == "body"){
-		return body(c, ex); 
+		return SizeMeasure::body; 
 	}else if(type == "max wick to body"){
-		return std::max(c.h() - body_bottom(c, ex), body_top(c, ex) - c.l()); 	
+		return SizeMeasure::max_wick_to_body; 
 	}else if(type == "mean wick to body"){
-		return (1.0/2)*(c.h() - body_bottom(c, ex) + body_top(c, ex) - c.l()); 
+		return SizeMeasure::mean_wick_to_body; 
 	}else if(type == "mean of body and wick to body"){
-		return (1.0/3)*(c.h() - body_bottom(c, ex) + body_top(c, ex) - c.l() + body(c, ex)); 
+		return SizeMeasure::mean_body_and_wick_to_body; 
 	}else{
 		throw std::invalid_argument("size_measure: Enter a valid string for type"); 
 	}
 }
+template <cand_pat::SizeMeasure M, typename C, typename T> 
+T cand_pat::size_measure(const C& c, T ex){
+	if constexpr(M == SizeMeasure::hml){
+		return c.h() - c.l(); 	
+	}else if constexpr(M == SizeMeasure::body){
+		return body(c, ex); 
+	}else if constexpr(M == SizeMeasure::max_wick_to_body){
+		return std::max(c.h() - body_bottom(c, ex), body_top(c, ex) - c.l()); 	
+	}else if constexpr(M == SizeMeasure::mean_wick_to_body){
+		return (1.0/2)*(c.h() - body_bottom(c, ex) + body_top(c, ex) - c.l()); 
+	}else{
+		return (1.0/3)*(c.h() - body_bottom(c, ex) + body_top(c, ex) - c.l() + body(c, ex)); 
+	}
+}
+template <typename C, typename T> 
+T cand_pat::size_measure(const C& c, T ex, SizeMeasure meas){
+	switch(meas){
+		case SizeMeasure::hml: return size_measure<SizeMeasure::hml>(c, ex); 
+		case SizeMeasure::body: return size_measure<SizeMeasure::body>(c, ex); 
+		case SizeMeasure::max_wick_to_body: return size_measure<SizeMeasure::max_wick_to_body>(c, ex); 
+		case SizeMeasure::mean_wick_to_body: return size_measure<SizeMeasure::mean_wick_to_body>(c, ex); 
+		default: return size_measure<SizeMeasure::mean_body_and_wick_to_body>(c, ex); 
+	}
+}
+template <cand_pat::SizeMeasure M, typename T> 
+auto cand_pat::size_unary(T init){
+	return [init](const auto& c){
+		return cand_pat::size_measure<M>(c, init); 
+	};
+}
+template <typename T, typename F> 
+void cand_pat::size_unary(const std::string& type, T init, F f){
+	switch(size_measure_of(type)){
+		case SizeMeasure::hml: f(size_unary<SizeMeasure::hml>(init)); break; 
+		case SizeMeasure::body: f(size_unary<SizeMeasure::body>(init)); break; 
+		case SizeMeasure::max_wick_to_body: f(size_unary<SizeMeasure::max_wick_to_body>(init)); break; 
+		case SizeMeasure::mean_wick_to_body: f(size_unary<SizeMeasure::mean_wick_to_body>(init)); break; 
+		default: f(size_unary<SizeMeasure::mean_body_and_wick_to_body>(init)); 
+	}
+}
 template <typename C, typename T> 
 T cand_pat::top_wick(const C& c, T ex){
 	return (c.h() - body_top(c, ex)); 
@@ -606,28 +666,27 @@ void cand_pat::bull_engulf(InputIt first1, InputIt last1, OutputIt first2, int k
 	if(k <= 2){
 		throw std::invalid_argument("bull_engulf: The parameter k must be larger than 2"); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator 
-	auto itd = first1; 
-	T m, std, zs;
-	bool c_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-			zs = utility::zscore(size_unary(*it), m, std); 
-		}else{
-			//update the zscore 
-			zs = utility::roll_zscore_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator 
+		auto itd = first1; 
+		T m, std, zs;
+		bool c_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+				zs = utility::zscore(size_unary(*it), m, std); 
+			}else{
+				//update the zscore 
+				zs = utility::roll_zscore_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			c_large = (zs > zs_cut);
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::bull_engulf(it, c_large), ts_name};
+			first2++; 
 		}
-		c_large = (zs > zs_cut);
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::bull_engulf(it, c_large), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt> 
 bool cand_pat::bear_engulf(InputIt it, bool c_large){
@@ -640,29 +699,28 @@ void cand_pat::bear_engulf(InputIt first1, InputIt last1, OutputIt first2, int k
 	if(k <= 2){
 		throw std::invalid_argument("bear_engulf: The parameter k must be larger than 2."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator 
-	auto itd = first1; 
-	//variables for the mean, standard deviation and zscore
-	T m, std, zs;
-	bool c_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-			zs = utility::zscore(size_unary(*it), m, std); 
-		}else{
-			//update the zscore 
-			zs = utility::roll_zscore_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator 
+		auto itd = first1; 
+		//variables for the mean, standard deviation and zscore
+		T m, std, zs;
+		bool c_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+				zs = utility::zscore(size_unary(*it), m, std); 
+			}else{
+				//update the zscore 
+				zs = utility::roll_zscore_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			c_large = (zs > zs_cut);
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::bear_engulf(it, c_large), ts_name};
+			first2++; 
 		}
-		c_large = (zs > zs_cut);
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::bear_engulf(it, c_large), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt, typename T> 
 bool cand_pat::bull_doji_star(InputIt it, bool p_large, T f1, T f2, T f3, T f4, T f5){
@@ -675,30 +733,29 @@ void cand_pat::bull_doji_star(InputIt first1, InputIt last1, OutputIt first2, in
 	if(k <= 2){
 		throw std::invalid_argument("bull_doji_star: The parameter k must be larger than 2."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score
-	T m, std, zs;
-	bool p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score
+		T m, std, zs;
+		bool p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the previous candle
+			zs = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			p_large = (zs > zs_cut);
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::bull_doji_star(it, p_large, f1, f2, f3, f4, f5), ts_name};
+			first2++; 
 		}
-		//compute the zscore of the previous candle
-		zs = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		p_large = (zs > zs_cut);
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::bull_doji_star(it, p_large, f1, f2, f3, f4, f5), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt, typename T> 
 bool cand_pat::bear_doji_star(InputIt it, bool p_large, T f1, T f2, T f3, T f4, T f5){
@@ -711,30 +768,29 @@ void cand_pat::bear_doji_star(InputIt first1, InputIt last1, OutputIt first2, in
 	if(k <= 2){
 		throw std::invalid_argument("bear_doji_star: The parameter k must be larger than 2."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score
-	T m, std, zs;
-	bool p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score
+		T m, std, zs;
+		bool p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the previous candle
+			zs = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			p_large = (zs > zs_cut);
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::bear_doji_star(it, p_large, f1, f2, f3, f4, f5), ts_name};
+			first2++; 
 		}
-		//compute the zscore of the previous candle
-		zs = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		p_large = (zs > zs_cut);
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::bear_doji_star(it, p_large, f1, f2, f3, f4, f5), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt> 
 bool cand_pat::piercing_line(InputIt it, bool c_large, bool p_large){
@@ -747,34 +803,33 @@ void cand_pat::piercing_line(InputIt first1, InputIt last1, OutputIt first2, int
 	if(k <= 2){
 		throw std::invalid_argument("piercing_line: The parameter k must be larger than 2."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_c, zs_p;
-	bool c_large, p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_c, zs_p;
+		bool c_large, p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the current candle 
+			zs_c = utility::zscore(size_unary(*it), m, std);
+			//compute the zscore of the previous candle
+			zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			//booleans for if the current and previous candles were large
+			c_large = (zs_c > zs_cut);
+			p_large = (zs_p > zs_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::piercing_line(it, c_large, p_large), ts_name};
+			first2++; 
 		}
-		//compute the zscore of the current candle 
-		zs_c = utility::zscore(size_unary(*it), m, std);
-		//compute the zscore of the previous candle
-		zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		//booleans for if the current and previous candles were large
-		c_large = (zs_c > zs_cut);
-		p_large = (zs_p > zs_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::piercing_line(it, c_large, p_large), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt> 
 bool cand_pat::dark_cloud_cover(InputIt it, bool c_large, bool p_large){
@@ -787,34 +842,33 @@ void cand_pat::dark_cloud_cover(InputIt first1, InputIt last1, OutputIt first2,
 	if(k <= 2){
 		throw std::invalid_argument("dark_cloud_cover: The parameter k must be larger than 2."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_c, zs_p;
-	bool c_large, p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_c, zs_p;
+		bool c_large, p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the current candle 
+			zs_c = utility::zscore(size_unary(*it), m, std);
+			//compute the zscore of the previous candle
+			zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			//booleans for if the current and previous candles were large
+			c_large = (zs_c > zs_cut);
+			p_large = (zs_p > zs_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::dark_cloud_cover(it, c_large, p_large), ts_name};
+			first2++; 
 		}
-		//compute the zscore of the current candle 
-		zs_c = utility::zscore(size_unary(*it), m, std);
-		//compute the zscore of the previous candle
-		zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		//booleans for if the current and previous candles were large
-		c_large = (zs_c > zs_cut);
-		p_large = (zs_p > zs_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::dark_cloud_cover(it, c_large, p_large), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt, typename T> 
 bool cand_pat::bull_harami(InputIt it, bool c_small, bool p_large, T f1, T f2){
@@ -827,34 +881,33 @@ void cand_pat::bull_harami(InputIt first1, InputIt last1, OutputIt first2, int k
 	if(k <= 2){
 		throw std::invalid_argument("bull_harami: The parameter k must be larger than 2."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_c, zs_p;
-	bool c_small, p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_c, zs_p;
+		bool c_small, p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the current candle 
+			zs_c = utility::zscore(size_unary(*it), m, std);
+			//compute the zscore of the previous candle
+			zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			//booleans for if the current candle is small and the previous candle was large 
+			c_small = (zs_c < zs_small_cut);
+			p_large = (zs_p > zs_large_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::bull_harami(it, c_small, p_large, f1, f2), ts_name};
+			first2++;
 		}
-		//compute the zscore of the current candle 
-		zs_c = utility::zscore(size_unary(*it), m, std);
-		//compute the zscore of the previous candle
-		zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		//booleans for if the current candle is small and the previous candle was large 
-		c_small = (zs_c < zs_small_cut);
-		p_large = (zs_p > zs_large_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::bull_harami(it, c_small, p_large, f1, f2), ts_name};
-		first2++;
-	}
+	});
 }
 template <typename InputIt, typename T> 
 bool cand_pat::bear_harami(InputIt it, bool c_small, bool p_large, T f1, T f2){
@@ -867,34 +920,33 @@ void cand_pat::bear_harami(InputIt first1, InputIt last1, OutputIt first2, int k
 	if(k <= 2){
 		throw std::invalid_argument("bear_harami: The parameter k must be larger than 2."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_c, zs_p;
-	bool c_small, p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_c, zs_p;
+		bool c_small, p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the current candle 
+			zs_c = utility::zscore(size_unary(*it), m, std);
+			//compute the zscore of the previous candle
+			zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			//booleans for if the current candle is small and the previous candle was large 
+			c_small = (zs_c < zs_small_cut);
+			p_large = (zs_p > zs_large_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::bear_harami(it, c_small, p_large, f1, f2), ts_name};
+			first2++;
 		}
-		//compute the zscore of the current candle 
-		zs_c = utility::zscore(size_unary(*it), m, std);
-		//compute the zscore of the previous candle
-		zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		//booleans for if the current candle is small and the previous candle was large 
-		c_small = (zs_c < zs_small_cut);
-		p_large = (zs_p > zs_large_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::bear_harami(it, c_small, p_large, f1, f2), ts_name};
-		first2++;
-	}
+	});
 }
 template <typename InputIt, typename T> 
 bool cand_pat::bull_harami_doji(InputIt it, bool p_large, T f1, T f2, T f3, T f4, T f5){
@@ -907,31 +959,30 @@ bool cand_pat::bull_harami_doji(InputIt first1, InputIt last1, OutputIt first2,
 	if(k <= 2){
 		throw std::invalid_argument("bull_harami_doji: The parameter k must be larger than 2."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_p;
-	bool p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_p;
+		bool p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the previous candle
+			zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			//booleans for if the current candle is small and the previous candle was large 
+			p_large = (zs_p > zs_large_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::bull_harami_doji(it, p_large, f1, f2, f3, f4, f5), ts_name};
+			first2++;
 		}
-		//compute the zscore of the previous candle
-		zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		//booleans for if the current candle is small and the previous candle was large 
-		p_large = (zs_p > zs_large_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::bull_harami_doji(it, p_large, f1, f2, f3, f4, f5), ts_name};
-		first2++;
-	}
+	});
 }
 template <typename InputIt, typename T> 
 bool cand_pat::bear_harami_doji(InputIt it, bool p_large, T f1, T f2, T f3, T f4, T f5){
@@ -944,30 +995,29 @@ bool cand_pat::bear_harami_doji(InputIt first1, InputIt last1, OutputIt first2,
 	if(k <= 2){
 		throw std::invalid_argument("bear_harami_doji: The parameter k must be larger than 2."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_p;
-	bool p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_p;
+		bool p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscores & size boolean
+			zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			p_large = (zs_p > zs_large_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::bear_harami_doji(it, p_large, f1, f2, f3, f4, f5), ts_name};
+			first2++;
 		}
-		//compute the zscores & size boolean
-		zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		p_large = (zs_p > zs_large_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::bear_harami_doji(it, p_large, f1, f2, f3, f4, f5), ts_name};
-		first2++;
-	}
+	});
 }
 template <typename InputIt> 
 bool cand_pat::bull_neck(InputIt it){
@@ -1008,34 +1058,33 @@ void cand_pat::rising_window(InputIt first1, InputIt last1, OutputIt first2, int
 	if(k <= 2){
 		throw std::invalid_argument("rising_window: The parameter k must be larger than 2."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_c, zs_p;
-	bool c_large, p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_c, zs_p;
+		bool c_large, p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the current candle 
+			zs_c = utility::zscore(size_unary(*it), m, std);
+			//compute the zscore of the previous candle
+			zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			//booleans for if the current and previous candles were large
+			c_large = (zs_c > zs_cut);
+			p_large = (zs_p > zs_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::rising_window(it, c_large, p_large, f), ts_name};
+			first2++; 
 		}
-		//compute the zscore of the current candle 
-		zs_c = utility::zscore(size_unary(*it), m, std);
-		//compute the zscore of the previous candle
-		zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		//booleans for if the current and previous candles were large
-		c_large = (zs_c > zs_cut);
-		p_large = (zs_p > zs_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::rising_window(it, c_large, p_large, f), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt, typename T> 
 bool cand_pat::falling_window(InputIt it, bool c_large, bool p_large, T f){
@@ -1048,34 +1097,33 @@ void cand_pat::falling_window(InputIt first1, InputIt last1, OutputIt first2, in
 	if(k <= 2){
 		throw std::invalid_argument("falling_window: The parameter k must be larger than 2."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_c, zs_p;
-	bool c_large, p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_c, zs_p;
+		bool c_large, p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the current candle 
+			zs_c = utility::zscore(size_unary(*it), m, std);
+			//compute the zscore of the previous candle
+			zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			//booleans for if the current and previous candles were large
+			c_large = (zs_c > zs_cut);
+			p_large = (zs_p > zs_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::falling_window(it, c_large, p_large, f), ts_name};
+			first2++; 
 		}
-		//compute the zscore of the current candle 
-		zs_c = utility::zscore(size_unary(*it), m, std);
-		//compute the zscore of the previous candle
-		zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		//booleans for if the current and previous candles were large
-		c_large = (zs_c > zs_cut);
-		p_large = (zs_p > zs_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::falling_window(it, c_large, p_large, f), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt> 
 bool cand_pat::bull_counter_attack(InputIt it, bool p_large){
@@ -1088,30 +1136,29 @@ void cand_pat::bull_counter_attack(InputIt first1, InputIt last1, OutputIt first
 	if(k <= 2){
 		throw std::invalid_argument("bull_counter_attack: The parameter k must be larger than 2."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_p;
-	bool p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_p;
+		bool p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscores & size boolean
+			zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			p_large = (zs_p > zs_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::bull_counter_attack(it, p_large), ts_name};
+			first2++;
 		}
-		//compute the zscores & size boolean
-		zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		p_large = (zs_p > zs_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::bull_counter_attack(it, p_large), ts_name};
-		first2++;
-	}
+	});
 }
 template <typename InputIt> 
 bool cand_pat::bear_counter_attack(InputIt it, bool p_large){
@@ -1124,30 +1171,29 @@ void cand_pat::bear_counter_attack(InputIt first1, InputIt last1, OutputIt first
 	if(k <= 2){
 		throw std::invalid_argument("bear_counter_attack: The parameter k must be larger than 2."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_p;
-	bool p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_p;
+		bool p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscores & size boolean
+			zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			p_large = (zs_p > zs_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::bear_counter_attack(it, p_large), ts_name};
+			first2++;
 		}
-		//compute the zscores & size boolean
-		zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		p_large = (zs_p > zs_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::bear_counter_attack(it, p_large), ts_name};
-		first2++;
-	}
+	});
 }
 /*
 	Triple Candle Candlestick Pattern Implementations 
@@ -1165,32 +1211,31 @@ void cand_pat::morning_star(InputIt first1, InputIt last1, OutputIt first2, int
 	if(k <= 3){
 		throw std::invalid_argument("morning_star: The parameter k must be larger than 3."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_p1, zs_p2;
-	bool p1_small, p2_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_p1, zs_p2;
+		bool p1_small, p2_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscores & size booleans
+			zs_p1 = utility::zscore(size_unary(*std::prev(it)), m, std);
+			zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std); 
+			p1_small = (zs_p1 < zs_small_cut);
+			p2_large = (zs_p2 > zs_large_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::morning_star(it, p2_large, p1_small, f), ts_name};
+			first2++; 
 		}
-		//compute the zscores & size booleans
-		zs_p1 = utility::zscore(size_unary(*std::prev(it)), m, std);
-		zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std); 
-		p1_small = (zs_p1 < zs_small_cut);
-		p2_large = (zs_p2 > zs_large_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::morning_star(it, p2_large, p1_small, f), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt, typename T> 
 bool cand_pat::evening_star(InputIt it, bool p2_large, bool p1_small, T f){
@@ -1205,32 +1250,31 @@ void cand_pat::evening_star(InputIt first1, InputIt last1, OutputIt first2, int
 	if(k <= 3){
 		throw std::invalid_argument("evening_star: The parameter k must be larger than 3."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_p1, zs_p2;
-	bool p1_small, p2_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_p1, zs_p2;
+		bool p1_small, p2_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscores & size booleans
+			zs_p1 = utility::zscore(size_unary(*std::prev(it)), m, std);
+			zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std); 
+			p1_small = (zs_p1 < zs_small_cut);
+			p2_large = (zs_p2 > zs_large_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::evening_star(it, p2_large, p1_small, f), ts_name};
+			first2++; 
 		}
-		//compute the zscores & size booleans
-		zs_p1 = utility::zscore(size_unary(*std::prev(it)), m, std);
-		zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std); 
-		p1_small = (zs_p1 < zs_small_cut);
-		p2_large = (zs_p2 > zs_large_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::evening_star(it, p2_large, p1_small, f), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt, typename T> 
 bool cand_pat::morning_doji_star(InputIt it, bool p2_large, bool p1_small, T f1, T f2, T f3, T f4, T f5, T f6, T f7){
@@ -1242,32 +1286,31 @@ void cand_pat::morning_doji_star(InputIt first1, InputIt last1, OutputIt first2,
 	if(k <= 3){
 		throw std::invalid_argument("morning_doji_star: The parameter k must be larger than 3."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_p1, zs_p2;
-	bool p1_small, p2_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_p1, zs_p2;
+		bool p1_small, p2_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscores & size booleans
+			zs_p1 = utility::zscore(size_unary(*std::prev(it)), m, std);
+			zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std); 
+			p1_small = (zs_p1 < zs_small_cut);
+			p2_large = (zs_p2 > zs_large_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::morning_doji_star(it, p2_large, p1_small, f1, f2, f3, f4, f5, f6, f7), ts_name};
+			first2++; 
 		}
-		//compute the zscores & size booleans
-		zs_p1 = utility::zscore(size_unary(*std::prev(it)), m, std);
-		zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std); 
-		p1_small = (zs_p1 < zs_small_cut);
-		p2_large = (zs_p2 > zs_large_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::morning_doji_star(it, p2_large, p1_small, f1, f2, f3, f4, f5, f6, f7), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt, typename T> 
 bool cand_pat::evening_doji_star(InputIt it, bool p2_large, bool p1_small, T f1, T f2, T f3, T f4, T f5, T f6, T f7){
@@ -1279,34 +1322,33 @@ void cand_pat::evening_doji_star(InputIt first1, InputIt last1, OutputIt first2,
 	if(k <= 3){
 		throw std::invalid_argument("evening_doji_star: The parameter k must be larger than 3."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_p1, zs_p2;
-	bool p1_small, p2_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_p1, zs_p2;
+		bool p1_small, p2_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the previous 
+			zs_p1 = utility::zscore(size_unary(*std::prev(it)), m, std);
+			//compute the zscore of the candle two periods ago
+			zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std); 
+			//booleans for if the current and previous candles were large
+			p1_small = (zs_p1 < zs_small_cut);
+			p2_large = (zs_p2 > zs_large_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::evening_doji_star(it, p2_large, p1_small, f1, f2, f3, f4, f5, f6, f7), ts_name};
+			first2++; 
 		}
-		//compute the zscore of the previous 
-		zs_p1 = utility::zscore(size_unary(*std::prev(it)), m, std);
-		//compute the zscore of the candle two periods ago
-		zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std); 
-		//booleans for if the current and previous candles were large
-		p1_small = (zs_p1 < zs_small_cut);
-		p2_large = (zs_p2 > zs_large_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::evening_doji_star(it, p2_large, p1_small, f1, f2, f3, f4, f5, f6, f7), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt, typename T> 
 bool cand_pat::three_white_soldiers(InputIt it, bool c_large, bool p1_large, bool p2_large, T p){
@@ -1321,36 +1363,35 @@ void cand_pat::three_white_soldiers(InputIt first1, InputIt last1, OutputIt firs
 	if(k <= 3){
 		throw std::invalid_argument("three_white_soldiers: The parameter k must be larger than 3."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_c, zs_p1, zs_p2;
-	bool c_large, p1_large, p2_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_c, zs_p1, zs_p2;
+		bool c_large, p1_large, p2_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the current candle 
+			zs_c = utility::zscore(size_unary(*it), m, std);
+			//compute the zscore of the previous candle
+			zs_p1 = utility::zscore(size_unary(*std::prev(it)), m, std);
+			//compute the zscore of the candle two periods ago
+			zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std);
+			c_large = (zs_p1 > zs_cut); 
+			p1_large = (zs_p1 > zs_cut);
+			p2_large = (zs_p2 > zs_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::three_white_soldiers(it, c_large, p1_large, p2_large, p), ts_name};
+			first2++; 
 		}
-		//compute the zscore of the current candle 
-		zs_c = utility::zscore(size_unary(*it), m, std);
-		//compute the zscore of the previous candle
-		zs_p1 = utility::zscore(size_unary(*std::prev(it)), m, std);
-		//compute the zscore of the candle two periods ago
-		zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std);
-		c_large = (zs_p1 > zs_cut); 
-		p1_large = (zs_p1 > zs_cut);
-		p2_large = (zs_p2 > zs_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::three_white_soldiers(it, c_large, p1_large, p2_large, p), ts_name};
-		first2++; 
-	}
+	});
 }
 //f defines the body percentile of the previous candle that the open of each candle must be below 
 template <typename InputIt, typename T> 
@@ -1366,36 +1407,35 @@ void cand_pat::three_black_crows(InputIt first1, InputIt last1, OutputIt first2,
 	if(k <= 3){
 		throw std::invalid_argument("three_black_crows: The parameter k must be larger than 3."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_c, zs_p1, zs_p2;
-	bool c_large, p1_large, p2_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_c, zs_p1, zs_p2;
+		bool c_large, p1_large, p2_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the current candle 
+			zs_c = utility::zscore(size_unary(*it), m, std);
+			//compute the zscore of the previous candle
+			zs_p1 = utility::zscore(size_unary(*std::prev(it)), m, std);
+			//compute the zscore of the candle two periods ago
+			zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std);
+			c_large = (zs_p1 > zs_cut); 
+			p1_large = (zs_p1 > zs_cut);
+			p2_large = (zs_p2 > zs_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::three_black_crows(it, c_large, p1_large, p2_large, p), ts_name};
+			first2++; 
 		}
-		//compute the zscore of the current candle 
-		zs_c = utility::zscore(size_unary(*it), m, std);
-		//compute the zscore of the previous candle
-		zs_p1 = utility::zscore(size_unary(*std::prev(it)), m, std);
-		//compute the zscore of the candle two periods ago
-		zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std);
-		c_large = (zs_p1 > zs_cut); 
-		p1_large = (zs_p1 > zs_cut);
-		p2_large = (zs_p2 > zs_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::three_black_crows(it, c_large, p1_large, p2_large, p), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt> 
 bool cand_pat::three_inside_up(InputIt it){
@@ -1469,34 +1509,33 @@ void cand_pat::up_tasuki_gap(InputIt first1, InputIt last1, OutputIt first2, int
 	if(k <= 3){
 		throw std::invalid_argument("up_tasuki_gap: The parameter k must be larger than 3."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_c, zs_p;
-	bool c_large, p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_c, zs_p;
+		bool c_large, p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the current candle 
+			zs_c = utility::zscore(size_unary(*it), m, std);
+			//compute the zscore of the previous candle
+			zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			//booleans for if the current and previous candles were large
+			c_large = (zs_c > zs_cut);
+			p_large = (zs_p > zs_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::up_tasuki_gap(it, c_large, p_large), ts_name};
+			first2++; 
 		}
-		//compute the zscore of the current candle 
-		zs_c = utility::zscore(size_unary(*it), m, std);
-		//compute the zscore of the previous candle
-		zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		//booleans for if the current and previous candles were large
-		c_large = (zs_c > zs_cut);
-		p_large = (zs_p > zs_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::up_tasuki_gap(it, c_large, p_large), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt> 
 bool cand_pat::down_tasuki_gap(InputIt it, bool c_large, bool p1_large){
@@ -1510,34 +1549,33 @@ void cand_pat::down_tasuki_gap(InputIt first1, InputIt last1, OutputIt first2, i
 	if(k <= 3){
 		throw std::invalid_argument("down_tasuki_gap: The parameter k must be larger than 3."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_c, zs_p;
-	bool c_large, p_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_c, zs_p;
+		bool c_large, p_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore of the current candle 
+			zs_c = utility::zscore(size_unary(*it), m, std);
+			//compute the zscore of the previous candle
+			zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
+			//booleans for if the current and previous candles were large
+			c_large = (zs_c > zs_cut);
+			p_large = (zs_p > zs_cut); 
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::down_tasuki_gap(it, c_large, p_large), ts_name};
+			first2++; 
 		}
-		//compute the zscore of the current candle 
-		zs_c = utility::zscore(size_unary(*it), m, std);
-		//compute the zscore of the previous candle
-		zs_p = utility::zscore(size_unary(*std::prev(it)), m, std); 
-		//booleans for if the current and previous candles were large
-		c_large = (zs_c > zs_cut);
-		p_large = (zs_p > zs_cut); 
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::down_tasuki_gap(it, c_large, p_large), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt> 
 bool cand_pat::down_gap_two_soldiers(InputIt it, bool p2_large){
@@ -1551,30 +1589,29 @@ void cand_pat::down_gap_two_soldiers(InputIt first1, InputIt last1, OutputIt fir
 	if(k <= 3){
 		throw std::invalid_argument("down_gap_two_soldiers: The parameter k must be larger than 3."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_p2;
-	bool p2_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_p2;
+		bool p2_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore & the size boolean
+			zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std); 
+			p2_large = (zs_p2 > zs_cut);
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::down_gap_two_soldiers(it, p2_large), ts_name};
+			first2++; 
 		}
-		//compute the zscore & the size boolean
-		zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std); 
-		p2_large = (zs_p2 > zs_cut);
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::down_gap_two_soldiers(it, p2_large), ts_name};
-		first2++; 
-	}
+	});
 }
 template <typename InputIt> 
 bool cand_pat::up_gap_two_crows(InputIt it, bool p2_large){
@@ -1588,29 +1625,28 @@ void cand_pat::up_gap_two_crows(InputIt first1, InputIt last1, OutputIt first2,
 	if(k <= 3){
 		throw std::invalid_argument("up_gap_two_crows: The parameter k must be larger than 3."); 
 	}
-	auto size_unary = [&type, init](const auto& c){
-		return cand_pat::size_measure(c, init, type); 
-	};
-	//discard iterator
-	auto itd = first1;
-	//variables for the mean, std and z-score for the current and previous candle sizes
-	T m, std, zs_p2;
-	bool p2_large; 
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		if(it == std::next(first1, k - 1)){
-			std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
-			m = mv.first; 
-			std = std::sqrt(mv.second); 
-		}else{
-			//update the standard deviation 
-			utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
-			itd++; 
+	cand_pat::size_unary(type, init, [&](auto size_unary){
+		//discard iterator
+		auto itd = first1;
+		//variables for the mean, std and z-score for the current and previous candle sizes
+		T m, std, zs_p2;
+		bool p2_large; 
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			if(it == std::next(first1, k - 1)){
+				std::pair<T, T> mv = utility::mean_var(first1, std::next(it), init, size_unary);
+				m = mv.first; 
+				std = std::sqrt(mv.second); 
+			}else{
+				//update the standard deviation 
+				utility::roll_std_update(std, m, size_unary(*itd), size_unary(*it), k); 
+				itd++; 
+			}
+			//compute the zscore & the size boolean
+			zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std); 
+			p2_large = (zs_p2 > zs_cut);
+			*first2 = Timestamp<bool>{it->dt(), cand_pat::up_gap_two_crows(it, p2_large), ts_name};
+			first2++; 
 		}
-		//compute the zscore & the size boolean
-		zs_p2 = utility::zscore(size_unary(*std::prev(it, 2)), m, std); 
-		p2_large = (zs_p2 > zs_cut);
-		*first2 = Timestamp<bool>{it->dt(), cand_pat::up_gap_two_crows(it, p2_large), ts_name};
-		first2++; 
-	}
+	});
 }
 
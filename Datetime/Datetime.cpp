@@ -1,37 +1,12 @@
 #include "Datetime.h" 
 
 //default constructor 
-Datetime::Datetime(){
-	std::stringstream str("1970.01.01 00:00:00"); 
-	std::chrono::local_seconds src; 
-	std::chrono::from_stream(str, "%Y.%m.%d %H:%M:%S", src);
-	dt_ = std::chrono::zoned_time(std::chrono::current_zone(), std::move(src));	
-}
+Datetime::Datetime() : dt_{std::chrono::current_zone(), std::chrono::local_seconds{}} {}
 
 //parameterized constructor using braced initialization 
-Datetime::Datetime(std::string& s, const std::chrono::time_zone* tmz) : 
-	dt_
-	{
-		[&](){
-			std::stringstream str(s); 
-			std::chrono::local_time<std::chrono::seconds> src;
-			std::chrono::from_stream(str, "%Y.%m.%d %H:%M:%S", src);
-			return std::chrono::zoned_time(tmz, std::move(src)); 
-		}()  
-	} {}; 
+Datetime::Datetime(std::string& s, const std::chrono::time_zone* tmz) : dt_{tmz, parse_(s)} {}; 
 
-	
-
-Datetime::Datetime(std::string&& s, const std::chrono::time_zone* tmz) : 
-	dt_
-	{
-		[&](){
-			std::stringstream str(s); 
-			std::chrono::local_time<std::chrono::seconds> src;
-			std::chrono::from_stream(str, "%Y.%m.%d %H:%M:%S", src);
-			return std::chrono::zoned_time(tmz, std::move(src)); 
-		}()  
-	} {}; 
+Datetime::Datetime(std::string&& s, const std::chrono::time_zone* tmz) : dt_{tmz, parse_(s)} {}; 
 
 Datetime::Datetime(std::stringstream&& ss, const std::chrono::time_zone* tmz) : 
 	dt_{
@@ -43,6 +18,8 @@ Datetime::Datetime(std::stringstream&& ss, const std::chrono::time_zone* tmz) :
 
 	} {}; 
 
+Datetime::Datetime(std::chrono::sys_seconds tp, const std::chrono::time_zone* tmz) : dt_{tmz, tp} {}; 
+
 //move constructor 
 Datetime::Datetime(Datetime&& dt) : dt_{std::move(dt.dt_)} {}
 //Copy Constructor 
@@ -110,12 +87,12 @@ std::string_view Datetime::tmz() const{
 
 
 int Datetime::serial_datetime() const{
-	//extract year_month_day object
-	std::chrono::year_month_day ymd;  
-	get_ymd(ymd);
-	//represent the the ymd_ object as an int 
+	//represent the datetime as an int (seconds since the epoch)
 	return std::chrono::sys_time<std::chrono::seconds>(dt_).time_since_epoch().count();  
 }
+std::int64_t Datetime::epoch() const{
+	return dt_.get_sys_time().time_since_epoch().count(); 
+}
 unsigned Datetime::eom() const{
 	//extract year_month_day object
 	std::chrono::year_month_day ymd; 
@@ -164,6 +141,9 @@ void Datetime::get_hms(std::chrono::hh_mm_ss<std::chrono::seconds>& hms) const{
 }
 
 Datetime& Datetime::change_tmz(std::string& tmz){
+	return change_tmz(tmz_cache::zone(tmz)); 
+}
+Datetime& Datetime::change_tmz(const std::chrono::time_zone* tmz){
 	this->dt_ = std::chrono::zoned_time<std::chrono::seconds>(tmz, this->dt_.get_sys_time());
 	return *this;   
 }
@@ -333,62 +313,30 @@ bool Datetime::is_leap() const{
 }
 
 bool Datetime::is_closed(std::string asset_c) const{
-	Datetime close = *this; 
-	Datetime open = *this;
-	std::string est = "America/New_York";
-	std::string c_zone{this->tmz()}; //convert string view to string 
-	//store the weekday number 
-	short int wdn = this->dn() + 1; //in the range [1, 7] 
-	//change the timezone of open and close
-	//std::cout << "in is_closed prior to change_tmz call" << std::endl; 
-	open.change_tmz(est); 
-	close.change_tmz(est);
-	//std::cout << "in is_closed post change_tmz call" << std::endl; 
-	//figure out if we are in ST or DT 
-	/*
-	auto info = open.zt().get_info();
-	bool st = true; 
-	if(info.save > std::chrono::minutes{0}){
-		st = false; 
-	}
-	*/
+	//New York local time of this instant (no copies, the offset interval is memoized by tmz_cache) 
+	static const std::chrono::time_zone* est = tmz_cache::zone("America/New_York"); 
+	std::int64_t ny = tmz_cache::to_local(est, this->epoch()); 
+	std::int64_t days = ny >= 0 ? ny / 86400 : (ny - 86399) / 86400; 
+	std::int64_t sod = ny - 86400 * days; 
+	//weekday in New York (0 = sunday, 1970.01.01 was a thursday)
+	int wd = static_cast<int>((days % 7 + 11) % 7); 
 	if(asset_c == "FX"){
-		if(wdn < 5){
-			return false; 
-		}else if(wdn == 5){
-			//keep the day but roll the time
-			close.roll(5, "17:00:00");
-			//open is the upcoming sunday
-			open.roll(7, "17:00:00"); 
-		}else if(wdn == 6){
-			//close is the previous friday
-			close.roll(-5, "17:00:00");
-			//open is the upcoming Sunday
-			open.roll(7, "17:00:00"); 
-		}else if(wdn == 7){
-			close.roll(-5, "17:00:00"); 
-			open.roll(-7, "17:00:00"); 
-		}
+		//closed from friday 5PM EST to sunday 5PM EST
+		return wd == 6 || (wd == 5 && sod >= 17 * 3600) || (wd == 0 && sod < 17 * 3600); 
 	}else if(asset_c == "EQUITIES" || asset_c == "BONDS"){
-		//close is the current day at 4PM EST
-		close = close.roll(wdn, "16:00:00"); 
-		if(wdn < 5){
-			//open is the next day at 9:30 AM EST 
-			open = open.roll(7, "09:30:00");
-		}else if(wdn == 5){
-			//on friday the next open is monday at 9:30AM EST
-			open = open.roll(1, "09:30:00");  
-		}
+		//open from 9:30AM to 4PM EST on weekdays
+		return wd == 0 || wd == 6 || sod < 9 * 3600 + 30 * 60 || sod >= 16 * 3600; 
 	}else{
 		throw std::runtime_error("is_closed: Enter a valid asset class."); 
 	}
-
-
-	if(*this >= close && *this < open){
-		return true; 
-	}else{
-		return false; 
-	}
+}
+bool Datetime::is_closed(const ExchangeCalendar& cal) const{
+	//New York local time of this instant (no copies, the offset interval is memoized by tmz_cache) 
+	static const std::chrono::time_zone* est = tmz_cache::zone("America/New_York"); 
+	std::int64_t ny = tmz_cache::to_local(est, this->epoch()); 
+	//minute of the instant (holidays & early closes come from the calendar) 
+	std::int64_t ny_min = ny >= 0 ? ny / 60 : (ny - 59) / 60; 
+	return !cal.is_open(ny_min); 
 }
 
 //operators 
@@ -400,13 +348,8 @@ bool Datetime::operator ==(const Datetime& rhs) const{
 	return this->dt_ == rhs.dt_;
 }
 std::strong_ordering Datetime::operator<=>(const Datetime& rhs) const{
-	if(this->serial_datetime() < rhs.serial_datetime()){
-		return std::strong_ordering::less; 
-	}else if(this->serial_datetime() > rhs.serial_datetime()){
-		return std::strong_ordering::greater; 
-	}else{
-		return std::strong_ordering::equivalent; 
-	}
+	//compare the utc instants once 
+	return this->epoch() <=> rhs.epoch(); 
 }
 //move assignment operator 
 Datetime& Datetime::operator=(Datetime&& dt){
@@ -419,6 +362,17 @@ Datetime& Datetime::operator=(const Datetime& dt){
 	return *this; 
 }
 
+std::chrono::local_seconds Datetime::parse_(const std::string& s){
+	std::int64_t local_s = 0; 
+	if(s.size() == dt_format::width && dt_format::decode(s, local_s)){
+		return std::chrono::local_seconds{std::chrono::seconds{local_s}}; 
+	}
+	std::stringstream str(s); 
+	std::chrono::local_time<std::chrono::seconds> src;
+	std::chrono::from_stream(str, "%Y.%m.%d %H:%M:%S", src);
+	return src; 
+}
+
 //Validate function
 void Datetime::validate_(std::string &s) const{
 	//This validate function assumes s is in the format %Y.%m.%d %H:%M:%S
@@ -1,8 +1,12 @@
 #pragma once
 #include <chrono>
+#include <cstdint>
 #include <iostream> 
 #include <stdexcept>
 #include <string>
+#include "DatetimeFormat.h"
+#include "TmzCache.h"
+#include "ExchangeCalendar.h"
 
 class Datetime{
 	public:
@@ -12,6 +16,8 @@ class Datetime{
 		Datetime(std::string& s, const std::chrono::time_zone* = std::chrono::current_zone()); 
 		Datetime(std::string&& s, const std::chrono::time_zone* = std::chrono::current_zone()); 
 		Datetime(std::stringstream&& ss, const std::chrono::time_zone* tmz = std::chrono::current_zone()); 
+		//construct from a utc time point (used when datetimes are stored as seconds since the epoch)
+		Datetime(std::chrono::sys_seconds tp, const std::chrono::time_zone* tmz = std::chrono::current_zone()); 
 		//move constructor 
 		Datetime(Datetime&& dt);
 		//copy constructor 
@@ -35,7 +41,9 @@ class Datetime{
 		void display_date() const;
 		void display_time() const; 
 		//modifiers
+		//the zone is located through tmz_cache (locate_zone is only called once per name)
 		Datetime& change_tmz(std::string& tmz);
+		Datetime& change_tmz(const std::chrono::time_zone* tmz);
 		Datetime& add_years(int&& rhs_y); 
 		Datetime& add_months(int&& rhs_m); 
 		Datetime& add_days(int&& rhs_d); 
@@ -51,11 +59,16 @@ class Datetime{
 		bool is_eom() const;
 		bool is_leap() const; 
 		int serial_datetime() const;
+		//seconds since the unix epoch (utc) as a 64 bit integer 
+		std::int64_t epoch() const; 
 		bool is_christmas() const; 
 		bool is_christmas_eve() const; 
 		bool is_new_years() const; 
 		bool is_new_years_eve() const; 
+		//true outside the weekly trading hours of the asset class (FX: sunday 5PM to friday 5PM EST, EQUITIES & BONDS: 9:30AM to 4PM EST on weekdays) 
 		bool is_closed(std::string asset_c) const; 
+		//calendar aware variant: true if the venue (see ExchangeCalendar::of) is closed at this instant (holidays & early closes included) 
+		bool is_closed(const ExchangeCalendar& cal) const; 
 		//operators 
 		int operator -(const Datetime& rhs) const; 
 		bool operator ==(const Datetime& rhs) const; 
@@ -67,11 +80,13 @@ class Datetime{
 	private:
 		std::chrono::zoned_time<std::chrono::seconds> dt_;
 		void validate_(std::string &s) const; 
+		//parse a local time in the format %Y.%m.%d %H:%M:%S (fixed layouts are decoded by dt_format, anything else by from_stream)
+		static std::chrono::local_seconds parse_(const std::string& s); 
 };
 
 struct DatetimeHash{
 	std::size_t operator()(const Datetime& dt) const{
-		return std::hash<int>{}(dt.serial_datetime()); 
+		return std::hash<std::int64_t>{}(dt.epoch()); 
 	}
 }; 
 
@@ -0,0 +1,68 @@
+#include "DatetimeFormat.h"
+#include <chrono>
+
+bool dt_format::decode(std::string_view s, std::int64_t& local_s){
+	if(s.size() < width){
+		return false;
+	}
+	//the date separators must match (. or -) & the date/time separator is a space (or T in the ISO layout)
+	char sep = s[4];
+	if((sep != '.' && sep != '-') || s[7] != sep || (s[10] != ' ' && !(sep == '-' && s[10] == 'T')) || s[13] != ':' || s[16] != ':'){
+		return false;
+	}
+	bool ok = true;
+	auto num = [&](std::size_t i, std::size_t n){
+		int val = 0;
+		for(std::size_t k = i; k < i + n; k++){
+			unsigned d = static_cast<unsigned>(s[k] - '0');
+			ok = ok && d < 10;
+			val = 10 * val + static_cast<int>(d);
+		}
+		return val;
+	};
+	int y = num(0, 4);
+	int mo = num(5, 2);
+	int d = num(8, 2);
+	int hr = num(11, 2);
+	int mn = num(14, 2);
+	int sc = num(17, 2);
+	if(!ok || hr > 23 || mn > 59 || sc > 59){
+		return false;
+	}
+	std::chrono::year_month_day ymd{std::chrono::year{y}, std::chrono::month{static_cast<unsigned>(mo)}, std::chrono::day{static_cast<unsigned>(d)}};
+	if(!ymd.ok()){
+		return false;
+	}
+	local_s = std::chrono::sys_days{ymd}.time_since_epoch().count() * 86400 + hr * 3600 + mn * 60 + sc;
+	return true;
+}
+
+void dt_format::encode(std::int64_t local_s, char* out){
+	//floor division (times before 1970 are negative)
+	std::int64_t days = local_s >= 0 ? local_s / 86400 : (local_s - 86399) / 86400;
+	std::int64_t sod = local_s - 86400 * days;
+	std::chrono::year_month_day ymd{std::chrono::sys_days{std::chrono::days{days}}};
+	auto put = [&](std::size_t i, std::size_t n, unsigned val){
+		for(std::size_t k = i + n; k > i; k--){
+			out[k - 1] = static_cast<char>('0' + val % 10);
+			val /= 10;
+		}
+	};
+	put(0, 4, static_cast<unsigned>(int(ymd.year())));
+	out[4] = '.';
+	put(5, 2, unsigned(ymd.month()));
+	out[7] = '.';
+	put(8, 2, unsigned(ymd.day()));
+	out[10] = ' ';
+	put(11, 2, static_cast<unsigned>(sod / 3600));
+	out[13] = ':';
+	put(14, 2, static_cast<unsigned>(sod / 60 % 60));
+	out[16] = ':';
+	put(17, 2, static_cast<unsigned>(sod % 60));
+}
+
+std::string dt_format::format(std::int64_t local_s){
+	std::string out(width, ' ');
+	encode(local_s, out.data());
+	return out;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+//Fast path for the fixed datetime layouts used by the project: the raw vendor & cleaned layout YYYY.MM.DD HH:MM:SS and the
+//ISO like YYYY-MM-DD HH:MM:SS (or YYYY-MM-DDTHH:MM:SS). The digits are decoded directly into seconds since
+//1970.01.01 00:00:00 local time (no streams, locale or allocations), anything else is left to the chrono parser
+namespace dt_format{
+	//number of characters in a fixed layout datetime
+	inline constexpr std::size_t width = 19;
+	//decode the first 19 characters of s, returns false if they are not in one of the layouts (or are not a valid datetime)
+	bool decode(std::string_view s, std::int64_t& local_s);
+	//write local_s as YYYY.MM.DD HH:MM:SS to out[0, 19) (years 0000 to 9999)
+	void encode(std::int64_t local_s, char* out);
+	std::string format(std::int64_t local_s);
+}
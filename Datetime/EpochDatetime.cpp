@@ -0,0 +1,181 @@
+#include "EpochDatetime.h"
+
+//static members (the time zone table)
+std::array<std::atomic<const std::chrono::time_zone*>, EpochDatetime::max_zones_> EpochDatetime::zones_{};
+std::atomic<std::size_t> EpochDatetime::n_zones_{0};
+std::mutex EpochDatetime::zones_mutex_;
+
+//default constructor
+EpochDatetime::EpochDatetime() : epoch_{0}, tmz_id_{intern(std::chrono::current_zone())} {};
+
+//parameterized constructors
+EpochDatetime::EpochDatetime(std::int64_t epoch) : EpochDatetime(epoch, std::chrono::current_zone()) {};
+
+EpochDatetime::EpochDatetime(std::int64_t epoch, const std::chrono::time_zone* tmz) : epoch_{epoch} {
+	if(tmz == nullptr){
+		throw std::invalid_argument("EpochDatetime Constructor: tmz must not be null");
+	}
+	tmz_id_ = intern(tmz);
+};
+
+EpochDatetime::EpochDatetime(const Datetime& dt) : epoch_{dt.epoch()}, tmz_id_{intern(dt.zt().get_time_zone())} {};
+
+//copy constructor (copies the cached calendar fields as well)
+EpochDatetime::EpochDatetime(const EpochDatetime& dt) : epoch_{dt.epoch_}, tmz_id_{dt.tmz_id_}, cal_{dt.cal_.load(std::memory_order_relaxed)} {};
+
+Datetime EpochDatetime::to_datetime() const{
+	return Datetime(std::chrono::sys_seconds{std::chrono::seconds{epoch_}}, tz());
+}
+
+//accessors
+std::int64_t EpochDatetime::epoch() const{
+	return epoch_;
+}
+std::uint16_t EpochDatetime::tmz_id() const{
+	return tmz_id_;
+}
+const std::chrono::time_zone* EpochDatetime::tz() const{
+	return zone(tmz_id_);
+}
+std::string_view EpochDatetime::tmz() const{
+	return tz()->name();
+}
+
+/*
+	layout of the packed calendar fields
+	bit 0: computed flag, bits 1-3: weekday number, bits 4-9: seconds, bits 10-15: minutes,
+	bits 16-20: hours, bits 21-25: day, bits 26-29: month, bits 30-45: year + 32768
+*/
+std::uint64_t EpochDatetime::calendar_() const{
+	std::uint64_t cal = cal_.load(std::memory_order_relaxed);
+	if(cal != 0){
+		return cal;
+	}
+	using namespace std::chrono;
+	sys_seconds st{seconds{epoch_}};
+	//convert to local time using the offset of the time zone at st
+	auto info = tz()->get_info(st);
+	local_seconds lt{st.time_since_epoch() + info.offset};
+	auto ld = floor<days>(lt);
+	year_month_day ymd{ld};
+	hh_mm_ss<seconds> hms{lt - ld};
+	weekday wd{ld};
+	cal = 1;
+	cal |= static_cast<std::uint64_t>(wd.c_encoding()) << 1;
+	cal |= static_cast<std::uint64_t>(hms.seconds().count()) << 4;
+	cal |= static_cast<std::uint64_t>(hms.minutes().count()) << 10;
+	cal |= static_cast<std::uint64_t>(hms.hours().count()) << 16;
+	cal |= static_cast<std::uint64_t>(static_cast<unsigned>(ymd.day())) << 21;
+	cal |= static_cast<std::uint64_t>(static_cast<unsigned>(ymd.month())) << 26;
+	cal |= static_cast<std::uint64_t>(static_cast<int>(ymd.year()) + 32768) << 30;
+	//racing writers store the same value
+	cal_.store(cal, std::memory_order_relaxed);
+	return cal;
+}
+int EpochDatetime::year() const{
+	return static_cast<int>((calendar_() >> 30) & 0xFFFF) - 32768;
+}
+unsigned EpochDatetime::month() const{
+	return static_cast<unsigned>((calendar_() >> 26) & 0xF);
+}
+unsigned EpochDatetime::day() const{
+	return static_cast<unsigned>((calendar_() >> 21) & 0x1F);
+}
+unsigned int EpochDatetime::hour() const{
+	return static_cast<unsigned int>((calendar_() >> 16) & 0x1F);
+}
+unsigned int EpochDatetime::min() const{
+	return static_cast<unsigned int>((calendar_() >> 10) & 0x3F);
+}
+unsigned int EpochDatetime::sec() const{
+	return static_cast<unsigned int>((calendar_() >> 4) & 0x3F);
+}
+unsigned short int EpochDatetime::dn() const{
+	return static_cast<unsigned short int>((calendar_() >> 1) & 0x7);
+}
+void EpochDatetime::get_ymd(std::chrono::year_month_day& ymd) const{
+	ymd = std::chrono::year_month_day{std::chrono::year{year()}, std::chrono::month{month()}, std::chrono::day{day()}};
+}
+void EpochDatetime::get_hms(std::chrono::hh_mm_ss<std::chrono::seconds>& hms) const{
+	hms = std::chrono::hh_mm_ss<std::chrono::seconds>(std::chrono::hours{hour()} + std::chrono::minutes{min()} + std::chrono::seconds{sec()});
+}
+std::int64_t EpochDatetime::serial_datetime() const{
+	return epoch_;
+}
+void EpochDatetime::display() const{
+	std::chrono::year_month_day ymd;
+	get_ymd(ymd);
+	std::chrono::hh_mm_ss<std::chrono::seconds> hms;
+	get_hms(hms);
+	std::cout << ymd << " " << hms << " " << tmz();
+}
+
+//modifiers (invalidate the cached calendar fields)
+EpochDatetime& EpochDatetime::add_secs(std::int64_t rhs_s){
+	epoch_ += rhs_s;
+	cal_.store(0, std::memory_order_relaxed);
+	return *this;
+}
+EpochDatetime& EpochDatetime::add_mins(std::int64_t rhs_m){
+	return add_secs(60 * rhs_m);
+}
+EpochDatetime& EpochDatetime::add_hours(std::int64_t rhs_h){
+	return add_secs(3600 * rhs_h);
+}
+EpochDatetime& EpochDatetime::change_tmz(const std::string& tmz){
+	tmz_id_ = intern(tmz_cache::zone(tmz));
+	cal_.store(0, std::memory_order_relaxed);
+	return *this;
+}
+
+//operators
+std::int64_t EpochDatetime::operator -(const EpochDatetime& rhs) const{
+	//returns the difference between the two instants in seconds
+	return epoch_ - rhs.epoch_;
+}
+bool EpochDatetime::operator ==(const EpochDatetime& rhs) const{
+	return epoch_ == rhs.epoch_;
+}
+std::strong_ordering EpochDatetime::operator<=>(const EpochDatetime& rhs) const{
+	return epoch_ <=> rhs.epoch_;
+}
+EpochDatetime& EpochDatetime::operator=(const EpochDatetime& dt){
+	epoch_ = dt.epoch_;
+	tmz_id_ = dt.tmz_id_;
+	cal_.store(dt.cal_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	return *this;
+}
+
+//time zone interning
+std::uint16_t EpochDatetime::intern(const std::chrono::time_zone* tmz){
+	//lock free search of the zones interned so far
+	std::size_t n = n_zones_.load(std::memory_order_acquire);
+	for(std::size_t i = 0; i < n; i++){
+		if(zones_[i].load(std::memory_order_relaxed) == tmz){
+			return static_cast<std::uint16_t>(i);
+		}
+	}
+	std::lock_guard<std::mutex> lock(zones_mutex_);
+	//another thread may have added the zone while we were waiting on the lock
+	n = n_zones_.load(std::memory_order_acquire);
+	for(std::size_t i = 0; i < n; i++){
+		if(zones_[i].load(std::memory_order_relaxed) == tmz){
+			return static_cast<std::uint16_t>(i);
+		}
+	}
+	if(n == max_zones_){
+		throw std::runtime_error("EpochDatetime::intern: Too many distinct time zones");
+	}
+	zones_[n].store(tmz, std::memory_order_relaxed);
+	n_zones_.store(n + 1, std::memory_order_release);
+	return static_cast<std::uint16_t>(n);
+}
+const std::chrono::time_zone* EpochDatetime::zone(std::uint16_t tmz_id){
+	return zones_[tmz_id].load(std::memory_order_relaxed);
+}
+EpochDatetime EpochDatetime::from_id(std::int64_t epoch, std::uint16_t tmz_id){
+	if(tmz_id >= n_zones_.load(std::memory_order_acquire)){
+		throw std::invalid_argument("EpochDatetime::from_id: tmz_id has not been interned");
+	}
+	return EpochDatetime(epoch, zone(tmz_id));
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "Datetime.h"
+#include <atomic>
+#include <array>
+#include <mutex>
+#include <cstdint>
+
+//Compact alternative to Datetime: stores the number of seconds since the unix epoch (utc) and a small interned time zone id.
+//Calendar fields (year, month, day, hour, ...) are computed on first use and cached, comparison, hashing and operator- are
+//integer operations on the epoch. Note: unlike Datetime, equality only compares the instants (not the time zones)
+class EpochDatetime{
+	public:
+		//default constructor (1970.01.01 00:00:00 utc in the current zone)
+		EpochDatetime();
+		//parameterized constructors (epoch is in seconds since the unix epoch, the single argument version uses the current zone)
+		explicit EpochDatetime(std::int64_t epoch);
+		EpochDatetime(std::int64_t epoch, const std::chrono::time_zone* tmz);
+		//conversion from a Datetime
+		EpochDatetime(const Datetime& dt);
+		//copy constructor
+		EpochDatetime(const EpochDatetime& dt);
+		//convert back to a Datetime
+		Datetime to_datetime() const;
+		//accessors
+		std::int64_t epoch() const;
+		std::uint16_t tmz_id() const;
+		const std::chrono::time_zone* tz() const;
+		std::string_view tmz() const;
+		int year() const;
+		unsigned month() const;
+		unsigned day() const;
+		unsigned int hour() const;
+		unsigned int min() const;
+		unsigned int sec() const;
+		unsigned short int dn() const;
+		void get_ymd(std::chrono::year_month_day& ymd) const;
+		void get_hms(std::chrono::hh_mm_ss<std::chrono::seconds>& hms) const;
+		//same as epoch (kept so that EpochDatetime can be used where Datetime::serial_datetime is used)
+		std::int64_t serial_datetime() const;
+		//Display function
+		void display() const;
+		//modifiers (these add absolute durations to the epoch so they do not follow local time across dst changes)
+		EpochDatetime& add_secs(std::int64_t rhs_s);
+		EpochDatetime& add_mins(std::int64_t rhs_m);
+		EpochDatetime& add_hours(std::int64_t rhs_h);
+		//change the time zone the calendar fields are computed in (the instant is unchanged)
+		EpochDatetime& change_tmz(const std::string& tmz);
+		//operators
+		std::int64_t operator -(const EpochDatetime& rhs) const;
+		bool operator ==(const EpochDatetime& rhs) const;
+		std::strong_ordering operator <=> (const EpochDatetime& rhs) const;
+		//copy assignment operator
+		EpochDatetime& operator=(const EpochDatetime& dt);
+
+		//time zone interning (returns the id of tmz, adding it to the table if necessary)
+		static std::uint16_t intern(const std::chrono::time_zone* tmz);
+		//returns the time zone with id tmz_id
+		static const std::chrono::time_zone* zone(std::uint16_t tmz_id);
+		//construct from an interned time zone id (throws if tmz_id has not been interned)
+		static EpochDatetime from_id(std::int64_t epoch, std::uint16_t tmz_id);
+	private:
+		std::int64_t epoch_ = 0;
+		std::uint16_t tmz_id_ = 0;
+		//packed calendar fields (0 ==> not computed yet), atomic so that concurrent readers can fill the cache
+		mutable std::atomic<std::uint64_t> cal_{0};
+		//compute (if needed) and return the packed calendar fields
+		std::uint64_t calendar_() const;
+		//the maximum number of distinct time zones which can be interned
+		static constexpr std::size_t max_zones_ = 512;
+		static std::array<std::atomic<const std::chrono::time_zone*>, max_zones_> zones_;
+		static std::atomic<std::size_t> n_zones_;
+		static std::mutex zones_mutex_;
+};
+
+struct EpochDatetimeHash{
+	std::size_t operator()(const EpochDatetime& dt) const{
+		return std::hash<std::int64_t>{}(dt.epoch());
+	}
+};
@@ -0,0 +1,328 @@
+#include "ExchangeCalendar.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <stdexcept>
+
+namespace{
+	//floor division & modulo (days before 1970 are negative)
+	std::int64_t floor_div(std::int64_t a, std::int64_t b){
+		return a >= 0 ? a / b : -((-a + b - 1) / b);
+	}
+	//weekday of a day since 1970.01.01 (0 = sunday, 1970.01.01 was a thursday)
+	int weekday(std::int64_t day){
+		return static_cast<int>(day + 4 - 7 * floor_div(day + 4, 7));
+	}
+	std::int64_t days_of(std::chrono::sys_days d){
+		return d.time_since_epoch().count();
+	}
+	std::int64_t date(int y, unsigned m, unsigned d){
+		using namespace std::chrono;
+		return days_of(sys_days{year{y} / month{m} / day{d}});
+	}
+	//n-th (1 based) weekday wd of the month & last weekday wd of the month
+	std::int64_t nth(int y, unsigned m, unsigned wd, unsigned n){
+		using namespace std::chrono;
+		return days_of(sys_days{year{y} / month{m} / std::chrono::weekday{wd}[n]});
+	}
+	std::int64_t last(int y, unsigned m, unsigned wd){
+		using namespace std::chrono;
+		return days_of(sys_days{year{y} / month{m} / std::chrono::weekday{wd}[std::chrono::last]});
+	}
+	//easter sunday (anonymous gregorian algorithm)
+	std::int64_t easter(int y){
+		int a = y % 19, b = y / 100, c = y % 100, d = b / 4, e = b % 4, f = (b + 8) / 25, g = (b - f + 1) / 3;
+		int h = (19 * a + b - d - g + 15) % 30, i = c / 4, k = c % 4, l = (32 + 2 * e + 2 * i - h - k) % 7;
+		int m = (a + 11 * h + 22 * l) / 451;
+		int month = (h + l - 7 * m + 114) / 31, day = (h + l - 7 * m + 114) % 31 + 1;
+		return date(y, month, day);
+	}
+	//day on which a fixed date holiday is observed (a saturday holiday moves to friday if sat_to_fri is true & is dropped
+	//otherwise, a sunday holiday moves to monday), returns false if the holiday is not observed
+	bool observed(std::int64_t day, bool sat_to_fri, std::int64_t& out){
+		int wd = weekday(day);
+		if(wd == 6){
+			out = day - 1;
+			return sat_to_fri;
+		}
+		out = wd == 0 ? day + 1 : day;
+		return true;
+	}
+	constexpr unsigned mon = 1, thu = 4;
+}
+
+const ExchangeCalendar& ExchangeCalendar::of(const std::string& asset_c){
+	//each calendar is built on first use (thread safe initialization of function local statics)
+	if(asset_c == "FX"){
+		static const ExchangeCalendar cal("FX");
+		return cal;
+	}else if(asset_c == "EQUITIES"){
+		static const ExchangeCalendar cal("EQUITIES");
+		return cal;
+	}else if(asset_c == "BONDS"){
+		static const ExchangeCalendar cal("BONDS");
+		return cal;
+	}
+	throw std::invalid_argument("ExchangeCalendar: Enter a valid asset class");
+}
+bool ExchangeCalendar::valid(const std::string& asset_c){
+	return asset_c == "FX" || asset_c == "EQUITIES" || asset_c == "BONDS";
+}
+
+ExchangeCalendar::ExchangeCalendar(const std::string& name) : name_{name} {
+	//pattern 0 is closed
+	add_pattern_(0, 0);
+	first_day_ = date(first_year_, 1, 1);
+	days_.resize(date(last_year_ + 1, 1, 1) - first_day_);
+	if(name_ == "FX"){
+		build_fx_();
+	}else if(name_ == "EQUITIES"){
+		build_nyse_();
+	}else{
+		build_sifma_();
+	}
+}
+
+std::uint8_t ExchangeCalendar::add_pattern_(int open, int close){
+	for(std::size_t k = 0; k < patterns_.size(); k++){
+		if(patterns_[k].open == open && patterns_[k].close == close){
+			return static_cast<std::uint8_t>(k);
+		}
+	}
+	Pattern p{{}, open, close};
+	for(int m = open; m < close; m++){
+		p.bits[m / 64] |= std::uint64_t(1) << (m % 64);
+	}
+	patterns_.push_back(p);
+	return static_cast<std::uint8_t>(patterns_.size() - 1);
+}
+
+const ExchangeCalendar::Pattern& ExchangeCalendar::pattern_(std::int64_t day) const{
+	std::int64_t k = day - first_day_;
+	if(k < 0 || k >= static_cast<std::int64_t>(days_.size())){
+		return patterns_[weekly_[weekday(day)]];
+	}
+	return patterns_[days_[k]];
+}
+
+void ExchangeCalendar::close_(std::int64_t day){
+	std::int64_t k = day - first_day_;
+	if(k >= 0 && k < static_cast<std::int64_t>(days_.size())){
+		days_[k] = 0;
+	}
+}
+void ExchangeCalendar::close_early_(std::int64_t day, int close){
+	std::int64_t k = day - first_day_;
+	if(k < 0 || k >= static_cast<std::int64_t>(days_.size())){
+		return;
+	}
+	//holidays & weekends stay closed
+	const Pattern& p = patterns_[days_[k]];
+	if(p.open < p.close && close < p.close){
+		days_[k] = add_pattern_(p.open, std::max(p.open, close));
+	}
+}
+std::int64_t ExchangeCalendar::prev_trading_day_(std::int64_t day) const{
+	std::int64_t d = day - 1;
+	for(int k = 0; k < 14 && pattern_(d).open == pattern_(d).close; k++){
+		d--;
+	}
+	return d;
+}
+
+void ExchangeCalendar::build_fx_(){
+	//sunday 17:00 to friday 17:00, no holidays
+	weekly_ = {add_pattern_(17 * 60, minutes_per_day_), add_pattern_(0, minutes_per_day_), add_pattern_(0, minutes_per_day_),
+		add_pattern_(0, minutes_per_day_), add_pattern_(0, minutes_per_day_), add_pattern_(0, 17 * 60), 0};
+	for(std::size_t k = 0; k < days_.size(); k++){
+		days_[k] = weekly_[weekday(first_day_ + k)];
+	}
+}
+
+void ExchangeCalendar::build_nyse_(){
+	std::uint8_t reg = add_pattern_(9 * 60 + 30, 16 * 60);
+	weekly_ = {0, reg, reg, reg, reg, reg, 0};
+	for(std::size_t k = 0; k < days_.size(); k++){
+		days_[k] = weekly_[weekday(first_day_ + k)];
+	}
+	std::int64_t d = 0;
+	for(int y = first_year_; y <= last_year_; y++){
+		//new year's day (not observed on the friday before if it falls on a saturday)
+		if(observed(date(y, 1, 1), false, d)){
+			close_(d);
+		}
+		//martin luther king jr. day (from 1998)
+		if(y >= 1998){
+			close_(nth(y, 1, mon, 3));
+		}
+		//washington's birthday & memorial day (monday holidays from 1971)
+		if(y >= 1971){
+			close_(nth(y, 2, mon, 3));
+			close_(last(y, 5, mon));
+		}else{
+			if(observed(date(y, 2, 22), true, d)){
+				close_(d);
+			}
+			if(observed(date(y, 5, 30), true, d)){
+				close_(d);
+			}
+		}
+		//good friday
+		close_(easter(y) - 2);
+		//juneteenth (from 2022)
+		if(y >= 2022 && observed(date(y, 6, 19), true, d)){
+			close_(d);
+		}
+		//independence day, labor day, thanksgiving & christmas
+		if(observed(date(y, 7, 4), true, d)){
+			close_(d);
+		}
+		close_(nth(y, 9, mon, 1));
+		close_(nth(y, 11, thu, 4));
+		if(observed(date(y, 12, 25), true, d)){
+			close_(d);
+		}
+		//presidential election days (until 1980)
+		if(y <= 1980 && y % 4 == 0){
+			close_(nth(y, 11, mon, 1) + 1);
+		}
+		//early closes at 13:00 (from 1993): july 3rd & christmas eve when they fall on monday to thursday & the day after thanksgiving
+		if(y >= 1993){
+			for(std::int64_t e : {date(y, 7, 3), date(y, 12, 24)}){
+				if(weekday(e) >= 1 && weekday(e) <= 4){
+					close_early_(e, 13 * 60);
+				}
+			}
+			close_early_(nth(y, 11, thu, 4) + 1, 13 * 60);
+		}
+	}
+	//unscheduled closures (weather, national days of mourning, september 11th)
+	const int special[][3] = {{1972, 12, 28}, {1973, 1, 25}, {1977, 7, 14}, {1985, 9, 27}, {1994, 4, 27}, {2001, 9, 11}, {2001, 9, 12},
+		{2001, 9, 13}, {2001, 9, 14}, {2004, 6, 11}, {2007, 1, 2}, {2012, 10, 29}, {2012, 10, 30}, {2018, 12, 5}, {2025, 1, 9}};
+	for(const auto& s : special){
+		close_(date(s[0], s[1], s[2]));
+	}
+}
+
+void ExchangeCalendar::build_sifma_(){
+	std::uint8_t reg = add_pattern_(8 * 60, 17 * 60);
+	weekly_ = {0, reg, reg, reg, reg, reg, 0};
+	for(std::size_t k = 0; k < days_.size(); k++){
+		days_[k] = weekly_[weekday(first_day_ + k)];
+	}
+	std::int64_t d = 0;
+	for(int y = first_year_; y <= last_year_; y++){
+		if(observed(date(y, 1, 1), false, d)){
+			close_(d);
+		}
+		if(y >= 1998){
+			close_(nth(y, 1, mon, 3));
+		}
+		close_(nth(y, 2, mon, 3));
+		close_(easter(y) - 2);
+		close_(last(y, 5, mon));
+		if(y >= 2022 && observed(date(y, 6, 19), true, d)){
+			close_(d);
+		}
+		if(observed(date(y, 7, 4), true, d)){
+			close_(d);
+		}
+		close_(nth(y, 9, mon, 1));
+		//columbus day & veterans day (not observed on the friday before if it falls on a saturday)
+		close_(nth(y, 10, mon, 2));
+		if(observed(date(y, 11, 11), false, d)){
+			close_(d);
+		}
+		close_(nth(y, 11, thu, 4));
+		if(observed(date(y, 12, 25), true, d)){
+			close_(d);
+		}
+	}
+	const int special[][3] = {{2001, 9, 11}, {2001, 9, 12}, {2012, 10, 30}};
+	for(const auto& s : special){
+		close_(date(s[0], s[1], s[2]));
+	}
+	//early closes at 14:00 on the trading day before new year's day, good friday, memorial day, independence day & christmas
+	//& on the day after thanksgiving (the holidays must be in the table first)
+	for(int y = first_year_; y <= last_year_; y++){
+		observed(date(y, 7, 4), true, d);
+		std::int64_t july4 = d;
+		observed(date(y, 12, 25), true, d);
+		std::int64_t xmas = d;
+		for(std::int64_t h : {date(y, 1, 1), easter(y) - 2, last(y, 5, mon), july4, xmas}){
+			close_early_(prev_trading_day_(h), 14 * 60);
+		}
+		close_early_(nth(y, 11, thu, 4) + 1, 14 * 60);
+	}
+}
+
+const std::string& ExchangeCalendar::name() const{
+	return name_;
+}
+
+bool ExchangeCalendar::is_open(std::int64_t ny_min) const{
+	std::int64_t day = floor_div(ny_min, minutes_per_day_);
+	std::int64_t m = ny_min - minutes_per_day_ * day;
+	return (pattern_(day).bits[m / 64] >> (m % 64)) & 1;
+}
+
+std::int64_t ExchangeCalendar::next_open(std::int64_t ny_min) const{
+	std::int64_t day = floor_div(ny_min, minutes_per_day_);
+	std::int64_t m = ny_min - minutes_per_day_ * day;
+	for(int k = 0; k < 370; k++, day++, m = 0){
+		const Pattern& p = pattern_(day);
+		if(m >= p.close){
+			continue;
+		}
+		for(std::size_t w = m / 64; w < p.bits.size(); w++){
+			std::uint64_t bits = p.bits[w];
+			if(w == std::size_t(m / 64)){
+				bits &= ~std::uint64_t(0) << (m % 64);
+			}
+			if(bits != 0){
+				return minutes_per_day_ * day + 64 * w + std::countr_zero(bits);
+			}
+		}
+	}
+	throw std::runtime_error("next_open: No tradable minute within a year");
+}
+
+std::int64_t ExchangeCalendar::prev_open(std::int64_t ny_min) const{
+	std::int64_t day = floor_div(ny_min, minutes_per_day_);
+	std::int64_t m = ny_min - minutes_per_day_ * day;
+	for(int k = 0; k < 370; k++, day--, m = minutes_per_day_ - 1){
+		const Pattern& p = pattern_(day);
+		if(p.open == p.close || m < p.open){
+			continue;
+		}
+		for(std::int64_t w = m / 64; w >= 0; w--){
+			std::uint64_t bits = p.bits[w];
+			if(w == m / 64 && m % 64 != 63){
+				bits &= (std::uint64_t(1) << (m % 64 + 1)) - 1;
+			}
+			if(bits != 0){
+				return minutes_per_day_ * day + 64 * w + 63 - std::countl_zero(bits);
+			}
+		}
+	}
+	throw std::runtime_error("prev_open: No tradable minute within a year");
+}
+
+std::pair<int, int> ExchangeCalendar::session(std::int64_t day) const{
+	const Pattern& p = pattern_(day);
+	return std::make_pair(p.open, p.close);
+}
+std::pair<int, int> ExchangeCalendar::regular_session(int wd) const{
+	const Pattern& p = patterns_[weekly_[wd]];
+	return std::make_pair(p.open, p.close);
+}
+bool ExchangeCalendar::is_holiday(std::int64_t day) const{
+	const Pattern& p = pattern_(day);
+	const Pattern& r = patterns_[weekly_[weekday(day)]];
+	return r.open < r.close && p.open == p.close;
+}
+bool ExchangeCalendar::is_early_close(std::int64_t day) const{
+	const Pattern& p = pattern_(day);
+	const Pattern& r = patterns_[weekly_[weekday(day)]];
+	return p.open < p.close && p.close < r.close;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+//Trading calendar of a US venue in New York local time. Every day from first_year_ to last_year_ is mapped to a session
+//pattern (closed, regular session, early close ...) & every pattern is stored as a bitmap of the 1440 minutes of the day,
+//so "is this minute tradable" is two table lookups & the next/previous tradable minute is found a word (64 minutes) at a time
+//Holidays & early closes are generated from the rules of the venue (plus a table of unscheduled closures), days outside
+//the covered years follow the weekly pattern. The calendars are built once per process & are read only afterwards
+//Note: minutes & days are counted from 1970.01.01 00:00 New York local time (see tmz_cache::to_local)
+class ExchangeCalendar{
+	public:
+		static constexpr int first_year_ = 1970;
+		static constexpr int last_year_ = 2099;
+		static constexpr int minutes_per_day_ = 1440;
+
+		//calendar of an asset class: "FX" (Sunday 17:00 to Friday 17:00, no holidays), "EQUITIES" (NYSE, 09:30 to 16:00 with
+		//13:00 early closes) or "BONDS" (SIFMA recommended hours, 08:00 to 17:00 with 14:00 early closes) (throws for other names)
+		static const ExchangeCalendar& of(const std::string& asset_c);
+		//true if of(asset_c) exists
+		static bool valid(const std::string& asset_c);
+		ExchangeCalendar(const ExchangeCalendar&) = delete;
+		ExchangeCalendar& operator=(const ExchangeCalendar&) = delete;
+		const std::string& name() const;
+		//true if the minute [ny_min, ny_min + 1) is tradable
+		bool is_open(std::int64_t ny_min) const;
+		//first tradable minute >= ny_min & last tradable minute <= ny_min (throws if there is none within a year)
+		std::int64_t next_open(std::int64_t ny_min) const;
+		std::int64_t prev_open(std::int64_t ny_min) const;
+		//session of the day as minutes of the day [open, close) (open == close if the venue is closed)
+		std::pair<int, int> session(std::int64_t day) const;
+		//regular session of a weekday (0 = sunday)
+		std::pair<int, int> regular_session(int wd) const;
+		//a day on which the venue normally trades but is closed & a day on which it closes before the regular close
+		bool is_holiday(std::int64_t day) const;
+		bool is_early_close(std::int64_t day) const;
+	private:
+		//minutes [open, close) of the day as a bitmap (bit m % 64 of bits[m / 64] is minute m)
+		struct Pattern{
+			std::array<std::uint64_t, (minutes_per_day_ + 63) / 64> bits;
+			int open;
+			int close;
+		};
+		ExchangeCalendar(const std::string& name);
+		std::string name_;
+		std::vector<Pattern> patterns_;
+		//pattern of each weekday (0 = sunday) & of each day in [first_day_, first_day_ + days_.size())
+		std::array<std::uint8_t, 7> weekly_;
+		std::int64_t first_day_;
+		std::vector<std::uint8_t> days_;
+		const Pattern& pattern_(std::int64_t day) const;
+		//index of the pattern [open, close) (added if it does not exist)
+		std::uint8_t add_pattern_(int open, int close);
+		//holiday & early close rules of each venue
+		void build_fx_();
+		void build_nyse_();
+		void build_sifma_();
+		//set the pattern of a day (days outside the covered years are ignored)
+		void close_(std::int64_t day);
+		void close_early_(std::int64_t day, int close);
+		//the trading day before day (skips weekends & holidays already in the table)
+		std::int64_t prev_trading_day_(std::int64_t day) const;
+};
@@ -0,0 +1,84 @@
+#include "TmzCache.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace{
+	//memoized intervals of one zone (sorted by begin, non overlapping)
+	struct ZoneMemo{
+		std::mutex m;
+		std::vector<tmz_cache::Interval> ivs;
+	};
+	std::mutex names_m;
+	std::map<std::string, const std::chrono::time_zone*, std::less<>> names;
+	std::mutex memos_m;
+	std::map<const std::chrono::time_zone*, std::unique_ptr<ZoneMemo>> memos;
+	//zone & interval of the last lookup on this thread (checked before any locking, the intervals never change)
+	thread_local const std::chrono::time_zone* last_tmz = nullptr;
+	thread_local tmz_cache::Interval last_iv{1, 0, 0};
+
+	ZoneMemo& memo_of(const std::chrono::time_zone* tmz){
+		std::lock_guard<std::mutex> lock(memos_m);
+		std::unique_ptr<ZoneMemo>& z = memos[tmz];
+		if(!z){
+			z = std::make_unique<ZoneMemo>();
+		}
+		return *z;
+	}
+}
+
+const std::chrono::time_zone* tmz_cache::zone(std::string_view name){
+	std::lock_guard<std::mutex> lock(names_m);
+	auto it = names.find(name);
+	if(it != names.end()){
+		return it->second;
+	}
+	const std::chrono::time_zone* tmz = std::chrono::locate_zone(name);
+	names.emplace(std::string(name), tmz);
+	return tmz;
+}
+
+tmz_cache::Interval tmz_cache::interval(const std::chrono::time_zone* tmz, std::int64_t sys_s){
+	if(tmz == last_tmz && last_iv.contains(sys_s)){
+		return last_iv;
+	}
+	ZoneMemo& z = memo_of(tmz);
+	{
+		std::lock_guard<std::mutex> lock(z.m);
+		//the last interval which begins at or before sys_s
+		auto it = std::partition_point(z.ivs.begin(), z.ivs.end(), [&](const Interval& x){ return x.begin <= sys_s; });
+		if(it != z.ivs.begin() && std::prev(it)->contains(sys_s)){
+			last_tmz = tmz;
+			last_iv = *std::prev(it);
+			return last_iv;
+		}
+	}
+	std::chrono::sys_info info = tmz->get_info(std::chrono::sys_seconds{std::chrono::seconds{sys_s}});
+	Interval iv{info.begin.time_since_epoch().count(), info.end.time_since_epoch().count(), info.offset.count()};
+	std::lock_guard<std::mutex> lock(z.m);
+	auto it = std::partition_point(z.ivs.begin(), z.ivs.end(), [&](const Interval& x){ return x.begin < iv.begin; });
+	if(it == z.ivs.end() || it->begin != iv.begin){
+		z.ivs.insert(it, iv);
+	}
+	last_tmz = tmz;
+	last_iv = iv;
+	return iv;
+}
+
+std::int64_t tmz_cache::to_local(const std::chrono::time_zone* tmz, std::int64_t sys_s){
+	return sys_s + interval(tmz, sys_s).off;
+}
+
+void tmz_cache::to_local(const std::chrono::time_zone* tmz, std::span<const std::int64_t> sys, std::span<std::int64_t> out){
+	//empty interval ==> the first element looks up its interval
+	Interval iv{1, 0, 0};
+	for(std::size_t i = 0; i < sys.size() && i < out.size(); i++){
+		if(!iv.contains(sys[i])){
+			iv = interval(tmz, sys[i]);
+		}
+		out[i] = sys[i] + iv.off;
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+//Time zone conversion service. Time zones are located once per name & the utc offset intervals (sys_info ranges) of every
+//zone are memoized as they are looked up, so converting a sorted stream of utc times to local time is a range check & an
+//addition per element (the time zone database is only consulted the first time a transition is crossed). Thread safe, each
+//thread keeps the last interval it looked up so repeated lookups in the same interval take no locks
+namespace tmz_cache{
+	//utc times in [begin, end) have utc offset off (seconds since the unix epoch & seconds)
+	struct Interval{
+		std::int64_t begin;
+		std::int64_t end;
+		std::int64_t off;
+		bool contains(std::int64_t sys_s) const{ return sys_s >= begin && sys_s < end; }
+	};
+	//cached std::chrono::locate_zone (throws like locate_zone if there is no such zone)
+	const std::chrono::time_zone* zone(std::string_view name);
+	//the offset interval of tmz containing sys_s
+	Interval interval(const std::chrono::time_zone* tmz, std::int64_t sys_s);
+	//seconds since 1970.01.01 00:00:00 local time of tmz
+	std::int64_t to_local(const std::chrono::time_zone* tmz, std::int64_t sys_s);
+	//batch version (out.size() must be at least sys.size()), sorted input only crosses each transition once
+	void to_local(const std::chrono::time_zone* tmz, std::span<const std::int64_t> sys, std::span<std::int64_t> out);
+}
@@ -22,8 +22,9 @@ class RFFS{
 		RFFS(double imp_thresh); 
 		RFFS(int k, int c, int t, double mgs, int md);
 		RFFS(double imp_thresh, int c, int t, double mgs, int md);
-		//Perform the feature selection
-		void Select(arma::mat train, arma::Row<size_t> train_lab, arma::mat test, arma::Row<size_t> test_lab);
+		//Perform the feature selection (T is the element type of the feature matrices, e.g. float for arma::fmat)
+		template <typename T> 
+		void Select(arma::Mat<T> train, arma::Row<size_t> train_lab, arma::Mat<T> test, arma::Row<size_t> test_lab);
 		//display the feature importances 
 		void display_fi() const; 
 		//getter for the vector of indices of the k most important features
@@ -94,7 +95,8 @@ RFFS<F>::RFFS(double imp_thresh, int c, int t, double mgs, int md) : imp_thresh_
 }; 
 
 template <typename F>
-void RFFS<F>::Select(arma::mat train, arma::Row<size_t> train_lab, arma::mat test, arma::Row<size_t> test_lab){
+template <typename T> 
+void RFFS<F>::Select(arma::Mat<T> train, arma::Row<size_t> train_lab, arma::Mat<T> test, arma::Row<size_t> test_lab){
 	if(k_ > train.n_rows){
 		throw std::invalid_argument("Select: The number of features to select must be less than or equal to the number of features."); 
 	}
@@ -115,7 +117,7 @@ void RFFS<F>::Select(arma::mat train, arma::Row<size_t> train_lab, arma::mat tes
 		arma::uvec ind_wo_i = arma::find(ind != i);
 		//train the random forest 
 		mlpack::RandomForest<F> rf; 
-		arma::mat train_wo_i = train.rows(ind_wo_i);
+		arma::Mat<T> train_wo_i = train.rows(ind_wo_i);
 		
 		rf.Train(train_wo_i, train_lab, c_, t_, 1, mgs_, md_);
 		//assess model performance by looking at AUROC
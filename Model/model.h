@@ -200,8 +200,9 @@ namespace model{
 	void tomeks_pca_lmnn_model(Mod& M, Dist& d, const arma::Mat<T>& matrix, const arma::Row<L>& labels, arma::Mat<T>& t, int k_tomeks, DP dp, double ret_var, int k_lmnn, int d_lmnn); 
 	
 
-	//KNN Classifier class which is templated on a voting policy class and a distance metric 
-	template <typename V, typename D> 
+	//KNN Classifier class which is templated on a voting policy class, a distance metric & the element type of the data matrices
+	//(T = float for arma::fmat feature matrices, the class probabilities in p_vec are doubles in both cases)
+	template <typename V, typename D, typename T = double> 
 	class KNNC{
 		public:
 			//Default constructor
@@ -209,11 +210,11 @@ namespace model{
 			//constructor
 			KNNC(int k);
 			//Training function (n is the number of classes)
-			void Train(arma::mat& data, arma::Row<size_t>& labels, int n); 
+			void Train(arma::Mat<T>& data, arma::Row<size_t>& labels, int n); 
 			//Classify (Note: the mlpack .Classify member functions take data in by const reference) 
-			void Classify(const arma::mat& data, arma::Row<size_t>& labels);
+			void Classify(const arma::Mat<T>& data, arma::Row<size_t>& labels);
 			//Classify Overload (probability of class j for data point i is accessed from p_vec[j, i]
-			void Classify(const arma::mat& data, arma::Row<size_t>& labels, arma::mat& p_vec);
+			void Classify(const arma::Mat<T>& data, arma::Row<size_t>& labels, arma::mat& p_vec);
 		private:
 			//Distance metric
 			D d_ = D(); 
@@ -224,7 +225,7 @@ namespace model{
 			//number of classes (default to zero and set to n when .Train is called)
 			int n_ = 0; 
 			//Nearest Neighbor Search object 
-			mlpack::NeighborSearch<mlpack::NearestNeighborSort, D> nns_;
+			mlpack::NeighborSearch<mlpack::NearestNeighborSort, D, arma::Mat<T>> nns_;
 			//true class labels 
 			arma::Row<size_t> labels_; 
 	};
@@ -1499,14 +1500,14 @@ void model::tomeks_pca_lmnn_model(Mod& M, Dist& d, const arma::Mat<T>& matrix, c
 	M.Train(mat, lab, 2);
 }
 
-template <typename V, typename D> 
-model::KNNC<V, D>::KNNC(int k) : k_{k} {};
+template <typename V, typename D, typename T> 
+model::KNNC<V, D, T>::KNNC(int k) : k_{k} {};
 
 //Note: We dont use the labels when building the reference tree for KNN but to match the behavior of other mlpack 
 //classifiers we need to pass the labels (==> allows the same .Train() call to work for KNNC and mlpack classifiers)
 
-template <typename V, typename D> 
-void model::KNNC<V, D>::Train(arma::mat& data, arma::Row<size_t>& labels, int n){
+template <typename V, typename D, typename T> 
+void model::KNNC<V, D, T>::Train(arma::Mat<T>& data, arma::Row<size_t>& labels, int n){
 	n_ = n; 
 	//build the reference tree for the data
 	nns_.Train(data);
@@ -1515,14 +1516,14 @@ void model::KNNC<V, D>::Train(arma::mat& data, arma::Row<size_t>& labels, int n)
 }
 
 //store predicted labels in labels 
-template<typename V, typename D>
-void model::KNNC<V, D>::Classify(const arma::mat& data, arma::Row<size_t>& labels){
+template<typename V, typename D, typename T>
+void model::KNNC<V, D, T>::Classify(const arma::Mat<T>& data, arma::Row<size_t>& labels){
 	//resize labels
 	labels.resize(data.n_cols);
 	//lambda to apply to each column in data
-	auto vote = [&](const arma::vec& c){
+	auto vote = [&](const arma::Col<T>& c){
 		//get the column number of c
-		arma::mat::const_iterator itb = data.begin();
+		typename arma::Mat<T>::const_iterator itb = data.begin();
 		//note matrices are stored column by column ==> distance from first element of first col to first element of c / n_rows is the col number 
 		int cn = std::distance(itb, c.begin_row(0)) / data.n_rows; 
 		//neigbors and distances matrices
@@ -1540,16 +1541,16 @@ void model::KNNC<V, D>::Classify(const arma::mat& data, arma::Row<size_t>& label
 	data.each_col(vote); 
 }
 
-template<typename V, typename D>
-void model::KNNC<V, D>::Classify(const arma::mat& data, arma::Row<size_t>& labels, arma::mat& p_vec){
+template<typename V, typename D, typename T>
+void model::KNNC<V, D, T>::Classify(const arma::Mat<T>& data, arma::Row<size_t>& labels, arma::mat& p_vec){
 	//resize labels and p_vec
 	labels.resize(data.n_cols);
 	//n_ classes 
 	p_vec.resize(n_, data.n_cols);
 	//lambda to apply to each column in data
-	auto vote = [&](const arma::vec& c){
+	auto vote = [&](const arma::Col<T>& c){
 		//get the column number of c
-		arma::mat::const_iterator itb = data.begin();
+		typename arma::Mat<T>::const_iterator itb = data.begin();
 		//note matrices are stored column by column ==> distance from first element of first col to first element of c / n_rows is the col number 
 		int cn = std::distance(itb, c.begin_row(0)) / data.n_rows; 
 		//neigbors and distances matrices
@@ -0,0 +1,197 @@
+#include "FeaturePlan.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+FeaturePlan::FeaturePlan(const std::vector<FeatureSpec>& specs){
+	for(const FeatureSpec& spec : specs){
+		add(spec);
+	}
+}
+
+std::size_t FeaturePlan::n_features() const{
+	return features_.size();
+}
+std::size_t FeaturePlan::n_nodes() const{
+	return nodes_.size();
+}
+const std::vector<std::string>& FeaturePlan::names() const{
+	return names_;
+}
+std::size_t FeaturePlan::start() const{
+	std::size_t st = 0;
+	for(int f : features_){
+		st = std::max(st, nodes_[f].start);
+	}
+	return st;
+}
+std::size_t FeaturePlan::start_(int a) const{
+	return nodes_[a].start;
+}
+
+int FeaturePlan::node_(Op op, PriceField field, int a, int b, int c, int k, double p1, double p2){
+	Key key{op, field, a, b, c, k, p1, p2};
+	auto found = index_.find(key);
+	if(found != index_.end()){
+		return found->second;
+	}
+	Node nd{op, field, a, b, c, k, p1, p2, 0, 0};
+	switch(op){
+		case Op::field:
+		case Op::hl:
+			nd.start = 0;
+			break;
+		case Op::tr:
+			//the true range starts at the second candle (as in tech_ind::atr)
+			nd.start = 1;
+			break;
+		case Op::sma:
+		case Op::pct_change:
+			nd.start = start_(a) + k - 1;
+			break;
+		case Op::ema:
+			nd.start = start_(a) + k;
+			break;
+		case Op::roll_std:
+			nd.start = std::max(start_(a) + k - 1, start_(b));
+			break;
+		case Op::gain:
+		case Op::loss:
+			nd.start = start_(a) + 1;
+			break;
+		case Op::bb:
+			nd.start = std::max({start_(a), start_(b), start_(c)});
+			break;
+		default:
+			//diff, env, atrp, rsi
+			nd.start = std::max(start_(a), start_(b));
+	}
+	if(op == Op::sma || op == Op::roll_std || op == Op::pct_change){
+		//window of the last k inputs
+		nd.ring = ring_size_;
+		ring_size_ += k;
+	}
+	nodes_.push_back(nd);
+	index_.emplace(key, nodes_.size() - 1);
+	return nodes_.size() - 1;
+}
+int FeaturePlan::field_(PriceField field){
+	return node_(Op::field, field, -1, -1, -1, 0);
+}
+int FeaturePlan::sma_(int a, int k){
+	return node_(Op::sma, PriceField::close, a, -1, -1, k);
+}
+int FeaturePlan::ema_(int a, int k, double alpha){
+	return node_(Op::ema, PriceField::close, a, -1, -1, k, alpha);
+}
+int FeaturePlan::roll_std_(int a, int m, int k){
+	return node_(Op::roll_std, PriceField::close, a, m, -1, k);
+}
+
+std::size_t FeaturePlan::add(const FeatureSpec& spec){
+	const std::vector<double>& p = spec.params;
+	auto n_params = [&spec, &p](std::size_t n){
+		if(p.size() != n){
+			throw std::invalid_argument("FeaturePlan::add: " + spec.ind + " takes " + std::to_string(n) + " parameters");
+		}
+	};
+	//periods must be positive integers (min is 2 for the periods of standard deviations)
+	auto period = [&spec, &p](std::size_t j, int min = 1){
+		if(!(p[j] >= min) || p[j] != std::floor(p[j])){
+			throw std::invalid_argument("FeaturePlan::add: invalid period for " + spec.ind);
+		}
+		return static_cast<int>(p[j]);
+	};
+	PriceField pf = price_field::from_string(spec.field);
+	int x = field_(pf);
+	int f = -1;
+	const std::string& ind = spec.ind;
+	if(ind == "sma"){
+		n_params(1);
+		f = sma_(x, period(0));
+	}else if(ind == "ema"){
+		n_params(2);
+		f = ema_(x, period(0), p[1]);
+	}else if(ind == "wilders_ma"){
+		//an ema with period 2*k - 1 & alpha 1 / k
+		n_params(1);
+		int k = period(0);
+		f = ema_(x, 2*k - 1, 1.0 / k);
+	}else if(ind == "ema_diff" || ind == "macd"){
+		//long period ema - short period ema (as in utility::ema_diff)
+		n_params(4);
+		int k1 = period(0);
+		int k2 = period(2);
+		double alpha1 = p[1];
+		double alpha2 = p[3];
+		if(k1 > k2){
+			std::swap(k1, k2);
+			std::swap(alpha1, alpha2);
+		}
+		f = node_(Op::diff, PriceField::close, ema_(x, k2, alpha2), ema_(x, k1, alpha1), -1, 0);
+	}else if(ind == "mov_std"){
+		n_params(1);
+		int k = period(0, 2);
+		f = roll_std_(x, sma_(x, k), k);
+	}else if(ind == "sma_bb"){
+		n_params(3);
+		int m = sma_(x, period(0));
+		f = node_(Op::bb, PriceField::close, x, m, roll_std_(x, m, period(1, 2)), 0, p[2]);
+	}else if(ind == "ema_bb"){
+		n_params(4);
+		int m = ema_(x, period(0), p[1]);
+		f = node_(Op::bb, PriceField::close, x, m, roll_std_(x, m, period(2, 2)), 0, p[3]);
+	}else if(ind == "ema_env"){
+		n_params(3);
+		f = node_(Op::env, PriceField::close, x, ema_(x, period(0), p[1]), -1, 0, p[2]);
+	}else if(ind == "atr"){
+		n_params(1);
+		f = sma_(node_(Op::tr, PriceField::close, -1, -1, -1, 0), period(0));
+	}else if(ind == "atrp"){
+		n_params(1);
+		int atr = sma_(node_(Op::tr, PriceField::close, -1, -1, -1, 0), period(0));
+		f = node_(Op::atrp, PriceField::close, atr, x, -1, 0);
+	}else if(ind == "k_bands_sma"){
+		n_params(3);
+		int atr = sma_(node_(Op::tr, PriceField::close, -1, -1, -1, 0), period(1));
+		f = node_(Op::bb, PriceField::close, x, sma_(x, period(0)), atr, 0, p[2]);
+	}else if(ind == "k_bands_ema"){
+		n_params(4);
+		int atr = sma_(node_(Op::tr, PriceField::close, -1, -1, -1, 0), period(2));
+		f = node_(Op::bb, PriceField::close, x, ema_(x, period(0), p[1]), atr, 0, p[3]);
+	}else if(ind == "chaik_vol_sma"){
+		//percent change of the k1 period sma of high - low over k2 periods
+		n_params(3);
+		int m = sma_(node_(Op::hl, PriceField::close, -1, -1, -1, 0), period(0));
+		f = node_(Op::pct_change, PriceField::close, m, -1, -1, period(1), p[2]);
+	}else if(ind == "chaik_vol_ema"){
+		n_params(4);
+		int m = ema_(node_(Op::hl, PriceField::close, -1, -1, -1, 0), period(0), p[1]);
+		f = node_(Op::pct_change, PriceField::close, m, -1, -1, period(2), p[3]);
+	}else if(ind == "rsi_sma"){
+		n_params(1);
+		int k = period(0);
+		int u = node_(Op::gain, PriceField::close, x, -1, -1, 0);
+		int d = node_(Op::loss, PriceField::close, x, -1, -1, 0);
+		f = node_(Op::rsi, PriceField::close, sma_(u, k), sma_(d, k), -1, 0);
+	}else if(ind == "rsi_ema"){
+		n_params(2);
+		int k = period(0);
+		int u = node_(Op::gain, PriceField::close, x, -1, -1, 0);
+		int d = node_(Op::loss, PriceField::close, x, -1, -1, 0);
+		f = node_(Op::rsi, PriceField::close, ema_(u, k, p[1]), ema_(d, k, p[1]), -1, 0);
+	}else{
+		throw std::invalid_argument("FeaturePlan::add: unsupported indicator " + ind);
+	}
+	features_.push_back(f);
+	//row name, e.g. ema(close, 20, 0.0952381)
+	std::ostringstream name;
+	name << ind << "(" << price_field::to_string(pf);
+	for(double v : p){
+		name << ", " << v;
+	}
+	name << ")";
+	names_.push_back(name.str());
+	return features_.size() - 1;
+}
@@ -0,0 +1,319 @@
+#pragma once
+#include <armadillo>
+#include "../Utility/utility.h"
+#include "../Candle/PriceField.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+//indicator of a feature matrix row: the tech_ind function name, the price field it is computed on & its numeric parameters
+//(in the order of the tech_ind function's parameters, see FeaturePlan::add)
+struct FeatureSpec{
+	std::string ind;
+	std::string field = "close";
+	std::vector<double> params;
+};
+
+//Feature matrix built from a list of indicator specs in a single pass over the candles. The specs are compiled into a DAG of
+//intermediates (price fields, true range, rolling means, emas, rolling standard deviations ...) where an intermediate used by
+//several features is computed once (e.g. the 12 & 26 period close emas of macd, ema_bb, ema_env & k_bands_ema). eval walks the
+//candles once, updates the nodes in topological order & writes the features of each candle to a column of the matrix
+//The updates use the utility kernels of the batch functions (roll_mean_update, ema_update, roll_std_s_ss_update ...) but every
+//intermediate starts at the first candle it can, so a feature may differ in the last bits from a batch function which starts
+//one of its windows later (e.g. k_bands_ema with k2 > k1)
+//With T = float (arma::fmat) the window sums are NeumaierSums instead (roll_mean_update drifts in single precision over a long
+//series) & the sums of the rolling standard deviations are taken of x - ref, where ref is a recent input, so the variance does
+//not cancel at price levels much larger than the spread
+class FeaturePlan{
+	public:
+		FeaturePlan() = default;
+		FeaturePlan(const std::vector<FeatureSpec>& specs);
+		//add a feature & return its row, the supported indicators (& params) are:
+		//"sma" (k), "ema" (k, alpha), "wilders_ma" (k), "ema_diff" & "macd" (k1, alpha1, k2, alpha2), "mov_std" (k),
+		//"sma_bb" (k1, k2, nstd), "ema_bb" (k1, alpha, k2, nstd), "ema_env" (k, alpha, p), "atr" (k), "atrp" (k),
+		//"k_bands_sma" (k1, k2, mult), "k_bands_ema" (k1, alpha, k2, mult), "chaik_vol_sma" (k1, k2, undef),
+		//"chaik_vol_ema" (k1, alpha, k2, undef), "rsi_sma" (k), "rsi_ema" (k, alpha)
+		//(atr & chaik_vol_* do not use the field) throws std::invalid_argument for other indicators or bad parameters
+		std::size_t add(const FeatureSpec& spec);
+		std::size_t n_features() const;
+		//number of distinct intermediates (including the features)
+		std::size_t n_nodes() const;
+		//name of each row, e.g. "ema(close, 20, 0.0952381)"
+		const std::vector<std::string>& names() const;
+		//offset (from first) of the first candle for which every feature has a value
+		std::size_t start() const;
+		//evaluate the features over the candles [first, last) (objects with .o, .h, .l, .c, .v, .b, .a methods)
+		//matrix is n_features() x (distance(first, last) - start()), column j holds the features of the candle start() + j
+		template <typename T, typename InputIt>
+		void eval(InputIt first, InputIt last, arma::Mat<T>& matrix) const;
+	private:
+		enum class Op : std::uint8_t{field, tr, hl, sma, ema, roll_std, diff, bb, env, atrp, pct_change, gain, loss, rsi};
+		//a node of the DAG, the inputs (a, b, c) are indices of earlier nodes (nodes_ is in topological order)
+		struct Node{
+			Op op;
+			PriceField field;
+			int a;
+			int b;
+			int c;
+			int k;
+			double p1;
+			double p2;
+			std::size_t start; //first candle with a value
+			std::size_t ring; //offset of the node's window in the eval ring buffer (window nodes)
+		};
+		using Key = std::tuple<Op, PriceField, int, int, int, int, double, double>;
+		std::vector<Node> nodes_;
+		std::map<Key, int> index_;
+		std::vector<int> features_;
+		std::vector<std::string> names_;
+		std::size_t ring_size_ = 0;
+		//index of the node (added if the same node does not exist)
+		int node_(Op op, PriceField field, int a, int b, int c, int k, double p1 = 0, double p2 = 0);
+		int field_(PriceField field);
+		int sma_(int a, int k);
+		int ema_(int a, int k, double alpha);
+		int roll_std_(int a, int m, int k);
+		std::size_t start_(int a) const;
+};
+
+template <typename T, typename InputIt>
+void FeaturePlan::eval(InputIt first, InputIt last, arma::Mat<T>& matrix) const{
+	std::size_t n = std::distance(first, last);
+	std::size_t st = start();
+	matrix.set_size(features_.size(), n > st ? n - st : 0);
+	if(n <= st){
+		return;
+	}
+	//compensated window sums in single precision
+	constexpr bool comp = std::is_same_v<T, float>;
+	//state of each node (s & ss are running sums, cs & css their compensated versions, prev is the previous input & ref the shift
+	//of the compensated sums of squares)
+	struct State{
+		T val;
+		T s;
+		T ss;
+		T prev;
+		int n;
+		int head;
+		utility::NeumaierSum<T> cs;
+		utility::NeumaierSum<T> css;
+		T ref;
+	};
+	std::vector<State> state(nodes_.size(), State{T{}, T{}, T{}, T{}, 0, 0, {}, {}, T{}});
+	//windows of the last k inputs of the window nodes
+	std::vector<T> ring(ring_size_);
+	//push x onto the window of node j & return the value which falls out (the oldest value if the window is not full)
+	auto push = [&](const Node& nd, State& s, const T& x){
+		T* w = ring.data() + nd.ring;
+		T old = w[s.head];
+		w[s.head] = x;
+		s.head = s.head + 1 == nd.k ? 0 : s.head + 1;
+		return old;
+	};
+	//apply f to the window of node j (oldest first)
+	auto for_window = [&](const Node& nd, const State& s, auto f){
+		const T* w = ring.data() + nd.ring;
+		for(int j = 0; j < nd.k; j++){
+			f(w[(s.head + j) % nd.k]);
+		}
+	};
+	std::size_t i = 0;
+	for(auto it = first; it != last; it++, i++){
+		const auto& c = *it;
+		for(std::size_t j = 0; j < nodes_.size(); j++){
+			const Node& nd = nodes_[j];
+			State& s = state[j];
+			switch(nd.op){
+				case Op::field:
+					s.val = price_field::visit(nd.field, [&c](auto f){ return price_field::project<decltype(f)::value>(c); });
+					break;
+				case Op::tr:{
+					//as in tech_ind::atr (the close of the candle itself)
+					double hl = c.h() - c.l();
+					double hc = std::abs(c.h() - c.c());
+					double lc = std::abs(c.l() - c.c());
+					s.val = std::max(hl, std::max(hc, lc));
+					break;
+				}
+				case Op::hl:
+					s.val = c.h() - c.l();
+					break;
+				case Op::sma:{
+					if(i < nodes_[nd.a].start){
+						break;
+					}
+					const T& x = state[nd.a].val;
+					if constexpr(comp){
+						T old = push(nd, s, x);
+						s.cs.add(x);
+						if(s.n < nd.k){
+							s.n++;
+						}else{
+							s.cs.sub(old);
+						}
+						s.val = s.cs.value() / nd.k;
+					}else if(s.n < nd.k){
+						//mean of the first k values (same order as utility::mean)
+						push(nd, s, x);
+						s.s = x + s.s;
+						s.n++;
+						if(s.n == nd.k){
+							s.val = (1.0 / nd.k) * s.s;
+						}
+					}else{
+						T old = push(nd, s, x);
+						utility::roll_mean_update(s.val, old, x, nd.k);
+					}
+					break;
+				}
+				case Op::ema:{
+					if(i < nodes_[nd.a].start){
+						break;
+					}
+					const T& x = state[nd.a].val;
+					if(s.n < nd.k){
+						//the ema starts from the mean of the first k values (utility::ema_setup)
+						s.s = x + s.s;
+						s.n++;
+						if(s.n == nd.k){
+							s.val = (1.0 / nd.k) * s.s;
+						}
+					}else{
+						utility::ema_update(s.val, x, static_cast<T>(nd.p1));
+					}
+					break;
+				}
+				case Op::roll_std:{
+					if(i < nodes_[nd.a].start){
+						break;
+					}
+					const T& x = state[nd.a].val;
+					if constexpr(comp){
+						if(s.n == 0){
+							s.ref = x;
+						}
+						T old = push(nd, s, x) - s.ref;
+						T d = x - s.ref;
+						s.cs.add(d);
+						s.css.add(d*d);
+						if(s.n < nd.k){
+							s.n++;
+						}else{
+							s.cs.sub(old);
+							s.css.sub(old*old);
+						}
+						if(s.n == nd.k && s.head == 0){
+							//every k values move ref to the newest value & sum the window again (keeps x - ref small when the
+							//level drifts away from the first value, amortized O(1))
+							s.ref = x;
+							s.cs = {};
+							s.css = {};
+							for_window(nd, s, [&s](const T& v){
+								s.cs.add(v - s.ref);
+								s.css.add((v - s.ref)*(v - s.ref));
+							});
+						}
+						if(i >= nd.start){
+							//the variance is shift invariant (mean & sums relative to ref)
+							s.val = std::sqrt(std::abs(utility::var(s.cs.value(), s.css.value(), state[nd.b].val - s.ref, nd.k)));
+						}
+					}else if(i < nd.start){
+						push(nd, s, x);
+					}else if(i == nd.start){
+						//sums of the first window from scratch (as in tech_ind::sma_bb)
+						push(nd, s, x);
+						s.s = T{};
+						s.ss = T{};
+						for_window(nd, s, [&s](const T& v){
+							s.s = s.s + v;
+							s.ss = s.ss + std::pow(v, 2);
+						});
+						s.val = utility::std(s.s, s.ss, state[nd.b].val, nd.k);
+					}else{
+						T old = push(nd, s, x);
+						s.val = utility::roll_std_s_ss_update(s.s, s.ss, state[nd.b].val, old, x, nd.k);
+					}
+					break;
+				}
+				case Op::diff:
+					if(i >= nd.start){
+						s.val = state[nd.a].val - state[nd.b].val;
+					}
+					break;
+				case Op::bb:
+					if(i >= nd.start){
+						//same as utility::bb_timestamp
+						const T& m = state[nd.b].val;
+						const T& sd = state[nd.c].val;
+						T lb = m - (static_cast<T>(nd.p1) * sd);
+						T ub = m + (static_cast<T>(nd.p1) * sd);
+						s.val = .5;
+						if(lb != ub){
+							s.val = ((state[nd.a].val - lb) / (ub - lb));
+						}
+					}
+					break;
+				case Op::env:
+					if(i >= nd.start){
+						const T& ema = state[nd.b].val;
+						T p = nd.p1;
+						s.val = (state[nd.a].val - ema*(1 - p)) / (2*p*ema);
+					}
+					break;
+				case Op::atrp:
+					if(i >= nd.start){
+						s.val = 100 / state[nd.b].val * state[nd.a].val;
+					}
+					break;
+				case Op::pct_change:{
+					if(i < nodes_[nd.a].start){
+						break;
+					}
+					const T& x = state[nd.a].val;
+					push(nd, s, x);
+					if(i >= nd.start){
+						//the window holds the last k values, the oldest is at head
+						s.val = utility::percent_change(x, ring[nd.ring + s.head], static_cast<T>(nd.p1), false);
+					}
+					break;
+				}
+				case Op::gain:
+				case Op::loss:{
+					if(i < nodes_[nd.a].start){
+						break;
+					}
+					const T& x = state[nd.a].val;
+					if(i > nodes_[nd.a].start){
+						T diff = x - s.prev;
+						if(nd.op == Op::gain){
+							s.val = diff > 0 ? diff : 0.0;
+						}else{
+							s.val = diff < 0 ? -1*diff : 0.0;
+						}
+					}
+					s.prev = x;
+					break;
+				}
+				case Op::rsi:
+					if(i >= nd.start){
+						//same as utility::rsi_timestamp
+						const T& mu = state[nd.a].val;
+						const T& md = state[nd.b].val;
+						s.val = (mu + md) == 0.0 ? 50.0 : 100 - ((100*md) / (mu + md));
+					}
+					break;
+			}
+		}
+		if(i >= st){
+			//the features of a candle are a column (contiguous in the column major matrix)
+			T* col = matrix.colptr(i - st);
+			for(std::size_t r = 0; r < features_.size(); r++){
+				col[r] = state[features_[r]].val;
+			}
+		}
+	}
+}
@@ -0,0 +1,705 @@
+#pragma once
+#include "../Utility/utility.h"
+#include <optional>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <cstdint>
+
+//Streaming versions of the main tech_ind indicators for live & walk forward use. An indicator object is fed one candle at a
+//time with push(c) & returns the value of the indicator for that candle (std::nullopt while it is warming up), the work per
+//candle does not depend on the length of the history & the memory is fixed (running sums/means/emas plus a ring of the last
+//k inputs where a rolling window needs the value which leaves it)
+//The objects use the same utility update kernels in the same order as the batch functions, so pushing the candles of
+//[first1, last1) gives the values written by the batch function bit for bit (the first value is returned for the candle the
+//batch function writes its first timestamp for)
+//Note: c must have the .h, .l, .c & .v methods used by the indicator (Candle, CandlePtr) & un_op must work with c
+namespace stream_ind{
+	//fixed capacity ring holding the last n values pushed
+	template <typename T>
+	class Ring{
+		public:
+			Ring(int n);
+			void push(const T& x);
+			//j'th most recent value (j = 0 is the last value pushed)
+			const T& back(int j) const;
+			int size() const;
+			bool full() const;
+			//call f on the last n values (oldest first)
+			template <typename F>
+			void for_each(int n, F f) const;
+		private:
+			std::vector<T> vals_;
+			int head_; //slot of the next value
+			int size_;
+	};
+	//mean of the last n values of a ring (same operation order as utility::mean)
+	template <typename T>
+	T ring_mean(const Ring<T>& r, int n, T init);
+
+	/*
+		Moving Averages
+	*/
+	//tech_ind::sma (first value at candle k - 1)
+	template <typename T, typename UnaryOp>
+	class Sma{
+		public:
+			Sma(int k, UnaryOp un_op, T init);
+			template <typename C>
+			std::optional<T> push(const C& c);
+		private:
+			int k_;
+			UnaryOp un_op_;
+			T init_;
+			Ring<T> vals_;
+			T m_;
+	};
+	//tech_ind::ema (first value at candle k)
+	template <typename T, typename UnaryOp>
+	class Ema{
+		public:
+			Ema(int k, T alpha, UnaryOp un_op, T init);
+			template <typename C>
+			std::optional<T> push(const C& c);
+		private:
+			int k_;
+			T alpha_;
+			UnaryOp un_op_;
+			int n_;
+			T s_; //sum of the first k values (ema_setup)
+			T ema_;
+	};
+	//tech_ind::wilders_ma (an ema with period 2*k - 1 & alpha 1 / k, first value at candle 2*k - 1)
+	template <typename T, typename UnaryOp>
+	class WildersMa{
+		public:
+			WildersMa(int k, UnaryOp un_op, T init);
+			template <typename C>
+			std::optional<T> push(const C& c);
+		private:
+			Ema<T, UnaryOp> ema_;
+	};
+
+	/*
+		Bands
+	*/
+	//tech_ind::sma_bb, position of the value in the bollinger bands (first value at candle max(k1, k2) - 1)
+	template <typename T, typename UnaryOp>
+	class SmaBb{
+		public:
+			SmaBb(int k1, int k2, T nstd, UnaryOp un_op, T init);
+			template <typename C>
+			std::optional<T> push(const C& c);
+		private:
+			int k1_;
+			int k2_;
+			T nstd_;
+			UnaryOp un_op_;
+			T init_;
+			Ring<T> vals_;
+			T m_;
+			T s_;
+			T ss_;
+			T std_;
+			T value_(const T& x) const;
+	};
+
+	/*
+		Oscillators
+	*/
+	//tech_ind::rsi_sma (first value at candle k)
+	template <typename T, typename UnaryOp>
+	class RsiSma{
+		public:
+			RsiSma(int k, UnaryOp un_op, T init);
+			template <typename C>
+			std::optional<T> push(const C& c);
+		private:
+			int k_;
+			UnaryOp un_op_;
+			T init_;
+			std::optional<T> prev_;
+			Ring<T> ups_;
+			Ring<T> downs_;
+			T mu_;
+			T md_;
+	};
+	//tech_ind::rsi_ema (first value at candle k + 1)
+	template <typename T, typename UnaryOp>
+	class RsiEma{
+		public:
+			RsiEma(int k, T alpha, UnaryOp un_op, T init);
+			template <typename C>
+			std::optional<T> push(const C& c);
+		private:
+			int k_;
+			T alpha_;
+			UnaryOp un_op_;
+			std::optional<T> prev_;
+			int n_;
+			T ema_u_;
+			T ema_d_;
+	};
+	//tech_ind::macd without a signal line, the ema difference (long period ema - short period ema, first value at candle max(k1, k2))
+	template <typename T, typename UnaryOp>
+	class Macd{
+		public:
+			Macd(int k1, T alpha1, int k2, T alpha2, UnaryOp un_op, T init);
+			template <typename C>
+			std::optional<T> push(const C& c);
+		private:
+			Ema<T, UnaryOp> ema1_;
+			Ema<T, UnaryOp> ema2_;
+	};
+	//tech_ind::macd with a k3 period sma signal line, (ema difference, signal) (first value at candle max(k1, k2) + k3 - 1)
+	template <typename T, typename UnaryOp>
+	class MacdSignal{
+		public:
+			MacdSignal(int k1, T alpha1, int k2, T alpha2, int k3, UnaryOp un_op, T init);
+			template <typename C>
+			std::optional<std::pair<T, T>> push(const C& c);
+		private:
+			Macd<T, UnaryOp> macd_;
+			int k3_;
+			T init_;
+			Ring<T> diffs_;
+			T sig_;
+	};
+	//tech_ind::stoch_osc, position of un_op(c) between the lowest low & the highest high of the last k candles
+	//(first value at candle k - 1, undef if the range is empty)
+	template <typename T, typename UnaryOp>
+	class StochOsc{
+		public:
+			StochOsc(int k, UnaryOp un_op, T undef);
+			template <typename C>
+			std::optional<T> push(const C& c);
+		private:
+			int k_;
+			UnaryOp un_op_;
+			T undef_;
+			std::int64_t i_;
+			//monotonic queues of (candle index, low) & (candle index, high) of the window (at most k entries each)
+			std::deque<std::pair<std::int64_t, T>> lows_;
+			std::deque<std::pair<std::int64_t, T>> highs_;
+	};
+	//tech_ind::cci_sma (un_op is the typical price (h + l + c) / 3 for the usual cci, first value at candle max(k1, k2) - 1)
+	//the mean absolute deviation is over the last k2 values so a push costs O(k2)
+	template <typename T, typename UnaryOp>
+	class CciSma{
+		public:
+			CciSma(int k1, int k2, T w, UnaryOp un_op, T init);
+			template <typename C>
+			std::optional<T> push(const C& c);
+		private:
+			int k1_;
+			int k2_;
+			T w_;
+			UnaryOp un_op_;
+			T init_;
+			Ring<T> vals_;
+			T m_;
+			T value_(const T& x) const;
+	};
+
+	/*
+		Volatility & Trend
+	*/
+	//tech_ind::atr (first value at candle k)
+	//Note: as in tech_ind::atr the true range uses the close of the candle itself
+	template <typename T>
+	class Atr{
+		public:
+			Atr(int k, T init);
+			template <typename C>
+			std::optional<T> push(const C& c);
+		private:
+			int k_;
+			T init_;
+			bool first_;
+			Ring<T> trs_;
+			T m_;
+	};
+	//tech_ind::dmi (first value at candle k + 1)
+	template <typename T>
+	class Dmi{
+		public:
+			Dmi(int k, T init);
+			template <typename C>
+			std::optional<T> push(const C& c);
+		private:
+			int k_;
+			T alpha_;
+			//high, low & close of the previous candle
+			std::optional<std::pair<T, T>> prev_hl_;
+			T prev_c_;
+			int n_;
+			//smoothed DM+, DM- and TR
+			T sdmp_;
+			T sdmn_;
+			T smtr_;
+	};
+	//tech_ind::adx, wilders moving average (period k2) of the k1 period dmi (first value at candle k1 + 2*k2)
+	template <typename T>
+	class Adx{
+		public:
+			Adx(int k1, int k2, T init);
+			template <typename C>
+			std::optional<T> push(const C& c);
+		private:
+			Dmi<T> dmi_;
+			WildersMa<T, std::identity> ma_;
+	};
+
+	/*
+		Volume
+	*/
+	//tech_ind::on_bal_vol (a value for every candle)
+	template <typename T, typename UnaryOp>
+	class Obv{
+		public:
+			Obv(UnaryOp un_op, T init);
+			template <typename C>
+			std::optional<T> push(const C& c);
+		private:
+			UnaryOp un_op_;
+			std::optional<T> prev_;
+			T obv_;
+	};
+}
+
+//Ring
+template <typename T>
+stream_ind::Ring<T>::Ring(int n) : vals_(n), head_{0}, size_{0} {
+	if(n < 1){
+		throw std::invalid_argument("Ring: n must be at least 1");
+	}
+}
+template <typename T>
+void stream_ind::Ring<T>::push(const T& x){
+	vals_[head_] = x;
+	head_ = head_ + 1 == static_cast<int>(vals_.size()) ? 0 : head_ + 1;
+	size_ = std::min(size_ + 1, static_cast<int>(vals_.size()));
+}
+template <typename T>
+const T& stream_ind::Ring<T>::back(int j) const{
+	int n = vals_.size();
+	return vals_[(head_ - 1 - j + 2*n) % n];
+}
+template <typename T>
+int stream_ind::Ring<T>::size() const{
+	return size_;
+}
+template <typename T>
+bool stream_ind::Ring<T>::full() const{
+	return size_ == static_cast<int>(vals_.size());
+}
+template <typename T>
+template <typename F>
+void stream_ind::Ring<T>::for_each(int n, F f) const{
+	for(int j = n - 1; j >= 0; j--){
+		f(back(j));
+	}
+}
+template <typename T>
+T stream_ind::ring_mean(const Ring<T>& r, int n, T init){
+	T s = init;
+	r.for_each(n, [&s](const T& x){ s = x + s; });
+	return (1.0 / n) * s;
+}
+
+//Sma
+template <typename T, typename UnaryOp>
+stream_ind::Sma<T, UnaryOp>::Sma(int k, UnaryOp un_op, T init) :
+	k_{k}, un_op_{un_op}, init_{init}, vals_{k}, m_{init} {};
+
+template <typename T, typename UnaryOp>
+template <typename C>
+std::optional<T> stream_ind::Sma<T, UnaryOp>::push(const C& c){
+	T x = un_op_(c);
+	if(!vals_.full()){
+		vals_.push(x);
+		if(!vals_.full()){
+			return std::nullopt;
+		}
+		//mean of the first k values
+		m_ = ring_mean(vals_, k_, init_);
+		return m_;
+	}
+	utility::roll_mean_update(m_, vals_.back(k_ - 1), x, k_);
+	vals_.push(x);
+	return m_;
+}
+
+//Ema
+template <typename T, typename UnaryOp>
+stream_ind::Ema<T, UnaryOp>::Ema(int k, T alpha, UnaryOp un_op, T init) :
+	k_{k}, alpha_{alpha}, un_op_{un_op}, n_{0}, s_{init}, ema_{init} {};
+
+template <typename T, typename UnaryOp>
+template <typename C>
+std::optional<T> stream_ind::Ema<T, UnaryOp>::push(const C& c){
+	T x = un_op_(c);
+	if(n_ < k_){
+		//the ema starts from the mean of the first k values
+		s_ = x + s_;
+		n_++;
+		if(n_ == k_){
+			ema_ = (1.0 / k_) * s_;
+		}
+		return std::nullopt;
+	}
+	utility::ema_update(ema_, x, alpha_);
+	return ema_;
+}
+
+//WildersMa
+template <typename T, typename UnaryOp>
+stream_ind::WildersMa<T, UnaryOp>::WildersMa(int k, UnaryOp un_op, T init) :
+	ema_{2*k - 1, static_cast<T>(1.0 / k), un_op, init} {};
+
+template <typename T, typename UnaryOp>
+template <typename C>
+std::optional<T> stream_ind::WildersMa<T, UnaryOp>::push(const C& c){
+	return ema_.push(c);
+}
+
+//SmaBb
+template <typename T, typename UnaryOp>
+stream_ind::SmaBb<T, UnaryOp>::SmaBb(int k1, int k2, T nstd, UnaryOp un_op, T init) :
+	k1_{k1}, k2_{k2}, nstd_{nstd}, un_op_{un_op}, init_{init}, vals_{std::max(k1, k2)}, m_{init}, s_{init}, ss_{init}, std_{init} {};
+
+template <typename T, typename UnaryOp>
+template <typename C>
+std::optional<T> stream_ind::SmaBb<T, UnaryOp>::push(const C& c){
+	T x = un_op_(c);
+	if(!vals_.full()){
+		vals_.push(x);
+		if(!vals_.full()){
+			return std::nullopt;
+		}
+		//compute m, s & ss from scratch for the first window
+		m_ = ring_mean(vals_, k1_, init_);
+		s_ = init_;
+		ss_ = init_;
+		vals_.for_each(k2_, [this](const T& v){
+			s_ = s_ + v;
+			ss_ = ss_ + std::pow(v, 2);
+		});
+		std_ = utility::std(s_, ss_, m_, k2_);
+		return value_(x);
+	}
+	utility::roll_mean_update(m_, vals_.back(k1_ - 1), x, k1_);
+	std_ = utility::roll_std_s_ss_update(s_, ss_, m_, vals_.back(k2_ - 1), x, k2_);
+	vals_.push(x);
+	return value_(x);
+}
+template <typename T, typename UnaryOp>
+T stream_ind::SmaBb<T, UnaryOp>::value_(const T& x) const{
+	//same as utility::bb_timestamp
+	T lb = m_ - (nstd_ * std_);
+	T ub = m_ + (nstd_ * std_);
+	T bb = .5;
+	if(lb != ub){
+		bb = ((x - lb) / (ub - lb));
+	}
+	return bb;
+}
+
+//RsiSma
+template <typename T, typename UnaryOp>
+stream_ind::RsiSma<T, UnaryOp>::RsiSma(int k, UnaryOp un_op, T init) :
+	k_{k}, un_op_{un_op}, init_{init}, ups_{k}, downs_{k}, mu_{init}, md_{init} {};
+
+template <typename T, typename UnaryOp>
+template <typename C>
+std::optional<T> stream_ind::RsiSma<T, UnaryOp>::push(const C& c){
+	T x = un_op_(c);
+	if(!prev_){
+		prev_ = x;
+		return std::nullopt;
+	}
+	T diff = x - *prev_;
+	prev_ = x;
+	T u = diff > 0 ? diff : 0.0;
+	T d = diff < 0 ? -1*diff : 0.0;
+	if(!ups_.full()){
+		ups_.push(u);
+		downs_.push(d);
+		if(!ups_.full()){
+			return std::nullopt;
+		}
+		mu_ = ring_mean(ups_, k_, init_);
+		md_ = ring_mean(downs_, k_, init_);
+	}else{
+		utility::roll_mean_update(mu_, ups_.back(k_ - 1), u, k_);
+		utility::roll_mean_update(md_, downs_.back(k_ - 1), d, k_);
+		ups_.push(u);
+		downs_.push(d);
+	}
+	//same as utility::rsi_timestamp
+	if((mu_ + md_) == 0.0){
+		return 50.0;
+	}
+	return 100 - ((100*md_) / (mu_ + md_));
+}
+
+//RsiEma
+template <typename T, typename UnaryOp>
+stream_ind::RsiEma<T, UnaryOp>::RsiEma(int k, T alpha, UnaryOp un_op, T init) :
+	k_{k}, alpha_{alpha}, un_op_{un_op}, n_{0}, ema_u_{init}, ema_d_{init} {};
+
+template <typename T, typename UnaryOp>
+template <typename C>
+std::optional<T> stream_ind::RsiEma<T, UnaryOp>::push(const C& c){
+	T x = un_op_(c);
+	if(!prev_){
+		prev_ = x;
+		return std::nullopt;
+	}
+	T diff = x - *prev_;
+	prev_ = x;
+	T u = diff > 0 ? diff : 0.0;
+	T d = diff < 0 ? -1*diff : 0.0;
+	if(n_ < k_){
+		//the emas start from the means of the first k ups & downs (ema_u_ & ema_d_ hold the sums until then)
+		ema_u_ = u + ema_u_;
+		ema_d_ = d + ema_d_;
+		n_++;
+		if(n_ == k_){
+			ema_u_ = (1.0 / k_) * ema_u_;
+			ema_d_ = (1.0 / k_) * ema_d_;
+		}
+		return std::nullopt;
+	}
+	utility::ema_update(ema_u_, u, alpha_);
+	utility::ema_update(ema_d_, d, alpha_);
+	if((ema_u_ + ema_d_) == 0.0){
+		return 50.0;
+	}
+	return 100 - ((100*ema_d_) / (ema_u_ + ema_d_));
+}
+
+//Macd
+template <typename T, typename UnaryOp>
+stream_ind::Macd<T, UnaryOp>::Macd(int k1, T alpha1, int k2, T alpha2, UnaryOp un_op, T init) :
+	//ema1_ is the shorter period ema (as in utility::ema_diff)
+	ema1_{std::min(k1, k2), k1 > k2 ? alpha2 : alpha1, un_op, init},
+	ema2_{std::max(k1, k2), k1 > k2 ? alpha1 : alpha2, un_op, init} {};
+
+template <typename T, typename UnaryOp>
+template <typename C>
+std::optional<T> stream_ind::Macd<T, UnaryOp>::push(const C& c){
+	std::optional<T> e1 = ema1_.push(c);
+	std::optional<T> e2 = ema2_.push(c);
+	if(!e2){
+		return std::nullopt;
+	}
+	return *e2 - *e1;
+}
+
+//MacdSignal
+template <typename T, typename UnaryOp>
+stream_ind::MacdSignal<T, UnaryOp>::MacdSignal(int k1, T alpha1, int k2, T alpha2, int k3, UnaryOp un_op, T init) :
+	macd_{k1, alpha1, k2, alpha2, un_op, init}, k3_{k3}, init_{init}, diffs_{k3}, sig_{init} {};
+
+template <typename T, typename UnaryOp>
+template <typename C>
+std::optional<std::pair<T, T>> stream_ind::MacdSignal<T, UnaryOp>::push(const C& c){
+	std::optional<T> diff = macd_.push(c);
+	if(!diff){
+		return std::nullopt;
+	}
+	if(!diffs_.full()){
+		diffs_.push(*diff);
+		if(!diffs_.full()){
+			return std::nullopt;
+		}
+		sig_ = ring_mean(diffs_, k3_, init_);
+	}else{
+		utility::roll_mean_update(sig_, diffs_.back(k3_ - 1), *diff, k3_);
+		diffs_.push(*diff);
+	}
+	return std::make_pair(*diff, sig_);
+}
+
+//StochOsc
+template <typename T, typename UnaryOp>
+stream_ind::StochOsc<T, UnaryOp>::StochOsc(int k, UnaryOp un_op, T undef) :
+	k_{k}, un_op_{un_op}, undef_{undef}, i_{0} {};
+
+template <typename T, typename UnaryOp>
+template <typename C>
+std::optional<T> stream_ind::StochOsc<T, UnaryOp>::push(const C& c){
+	//same as utility::roll_minmax_update
+	while(!lows_.empty() && lows_.front().first <= i_ - k_){
+		lows_.pop_front();
+	}
+	while(!highs_.empty() && highs_.front().first <= i_ - k_){
+		highs_.pop_front();
+	}
+	while(!lows_.empty() && lows_.back().second >= c.l()){
+		lows_.pop_back();
+	}
+	while(!highs_.empty() && highs_.back().second <= c.h()){
+		highs_.pop_back();
+	}
+	lows_.emplace_back(i_, c.l());
+	highs_.emplace_back(i_, c.h());
+	i_++;
+	if(i_ < k_){
+		return std::nullopt;
+	}
+	T mn = lows_.front().second;
+	T mx = highs_.front().second;
+	if(mn != mx){
+		return (un_op_(c) - mn) / (mx - mn);
+	}
+	return undef_;
+}
+
+//CciSma
+template <typename T, typename UnaryOp>
+stream_ind::CciSma<T, UnaryOp>::CciSma(int k1, int k2, T w, UnaryOp un_op, T init) :
+	k1_{k1}, k2_{k2}, w_{w}, un_op_{un_op}, init_{init}, vals_{std::max(k1, k2)}, m_{init} {};
+
+template <typename T, typename UnaryOp>
+template <typename C>
+std::optional<T> stream_ind::CciSma<T, UnaryOp>::push(const C& c){
+	T x = un_op_(c);
+	if(!vals_.full()){
+		vals_.push(x);
+		if(!vals_.full()){
+			return std::nullopt;
+		}
+		m_ = ring_mean(vals_, k1_, init_);
+		return value_(x);
+	}
+	utility::roll_mean_update(m_, vals_.back(k1_ - 1), x, k1_);
+	vals_.push(x);
+	return value_(x);
+}
+template <typename T, typename UnaryOp>
+T stream_ind::CciSma<T, UnaryOp>::value_(const T& x) const{
+	//same as utility::cci_timestamp (mean absolute difference from m of the last k2 values)
+	T s = init_;
+	vals_.for_each(k2_, [this, &s](const T& v){ s = std::abs(m_ - v) + s; });
+	T denom = w_ * ((1.0 / k2_) * s);
+	if(denom != 0.0){
+		return (x - m_) / denom;
+	}
+	return 0.0;
+}
+
+//Atr
+template <typename T>
+stream_ind::Atr<T>::Atr(int k, T init) :
+	k_{k}, init_{init}, first_{true}, trs_{k}, m_{init} {};
+
+template <typename T>
+template <typename C>
+std::optional<T> stream_ind::Atr<T>::push(const C& c){
+	if(first_){
+		//the batch function starts the true ranges at the second candle
+		first_ = false;
+		return std::nullopt;
+	}
+	double hl = c.h() - c.l();
+	double hc = std::abs(c.h() - c.c());
+	double lc = std::abs(c.l() - c.c());
+	T tr = std::max(hl, std::max(hc, lc));
+	if(!trs_.full()){
+		trs_.push(tr);
+		if(!trs_.full()){
+			return std::nullopt;
+		}
+		m_ = ring_mean(trs_, k_, init_);
+		return m_;
+	}
+	utility::roll_mean_update(m_, trs_.back(k_ - 1), tr, k_);
+	trs_.push(tr);
+	return m_;
+}
+
+//Dmi
+template <typename T>
+stream_ind::Dmi<T>::Dmi(int k, T init) :
+	k_{k}, alpha_{static_cast<T>(1.0 / k)}, prev_c_{init}, n_{0}, sdmp_{init}, sdmn_{init}, smtr_{init} {};
+
+template <typename T>
+template <typename C>
+std::optional<T> stream_ind::Dmi<T>::push(const C& c){
+	if(!prev_hl_){
+		prev_hl_ = std::make_pair(c.h(), c.l());
+		prev_c_ = c.c();
+		return std::nullopt;
+	}
+	T dmp = c.h() > prev_hl_->first ? c.h() - prev_hl_->first : 0.0;
+	T dmn = c.l() < prev_hl_->second ? prev_hl_->second - c.l() : 0.0;
+	double hl = c.h() - c.l();
+	double hc = std::abs(c.h() - prev_c_);
+	double lc = std::abs(c.l() - prev_c_);
+	T tr = std::max(hl, std::max(hc, lc));
+	prev_hl_ = std::make_pair(c.h(), c.l());
+	prev_c_ = c.c();
+	if(n_ < k_){
+		//the smoothed values start from the means of the first k values
+		sdmp_ = dmp + sdmp_;
+		sdmn_ = dmn + sdmn_;
+		smtr_ = tr + smtr_;
+		n_++;
+		if(n_ == k_){
+			sdmp_ = (1.0 / k_) * sdmp_;
+			sdmn_ = (1.0 / k_) * sdmn_;
+			smtr_ = (1.0 / k_) * smtr_;
+		}
+		return std::nullopt;
+	}
+	utility::ema_update(sdmp_, dmp, alpha_);
+	utility::ema_update(sdmn_, dmn, alpha_);
+	utility::ema_update(smtr_, tr, alpha_);
+	T dip = .5;
+	T din = .5;
+	if(smtr_ != 0.0){
+		dip = (sdmp_ / smtr_);
+		din = (sdmn_ / smtr_);
+	}
+	return 100.0 * std::abs(dip - din) / (dip + din);
+}
+
+//Adx
+template <typename T>
+stream_ind::Adx<T>::Adx(int k1, int k2, T init) :
+	dmi_{k1, init}, ma_{k2, std::identity{}, init} {};
+
+template <typename T>
+template <typename C>
+std::optional<T> stream_ind::Adx<T>::push(const C& c){
+	std::optional<T> dmi = dmi_.push(c);
+	if(!dmi){
+		return std::nullopt;
+	}
+	return ma_.push(*dmi);
+}
+
+//Obv
+template <typename T, typename UnaryOp>
+stream_ind::Obv<T, UnaryOp>::Obv(UnaryOp un_op, T init) :
+	un_op_{un_op}, obv_{init} {};
+
+template <typename T, typename UnaryOp>
+template <typename C>
+std::optional<T> stream_ind::Obv<T, UnaryOp>::push(const C& c){
+	T cur = un_op_(c);
+	if(!prev_){
+		obv_ = c.v();
+	}else if(cur > *prev_){
+		obv_ += c.v();
+	}else if(cur < *prev_){
+		obv_ -= c.v();
+	}
+	prev_ = cur;
+	return obv_;
+}
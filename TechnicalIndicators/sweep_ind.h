@@ -0,0 +1,293 @@
+#pragma once
+#include <armadillo>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+
+//Sweep versions of the rolling kernels for the parameter grids of GridSearch & Genetic (see utility::discretization), where the
+//same indicator is evaluated at many window lengths. The series is reduced once to prefix sums (the mean & variance of any
+//window in O(1)) or to sparse tables (the min & max of any window in O(1)) & every window length in ks is read off them, so a
+//sweep over m windows costs one pass plus m * n lookups instead of m passes with their own rolling state
+//The output is a column block: block is (n - start) x ks.size(), column j holds the indicator with window ks[j] & row r holds
+//the value for the element start + r, where start (returned) is the first element for which every window has a value
+//Note: the values agree with the rolling kernels up to rounding (the window sums are differences of prefix sums)
+namespace sweep_ind{
+	//prefix sums & sums of squares of x_i - x_0 (shifting by the first value keeps the sums small so that the differences
+	//lose less to cancellation), accumulated in at least double precision
+	template <typename T>
+	class PrefixSums{
+		public:
+			using A = std::common_type_t<T, double>;
+			PrefixSums() = default;
+			template <typename InputIt, typename UnaryOp>
+			PrefixSums(InputIt first, InputIt last, UnaryOp un_op);
+			std::size_t size() const;
+			//sum, mean, sample variance & sample standard deviation of the k values ending at i (i >= k - 1)
+			A sum(std::size_t i, int k) const;
+			T mean(std::size_t i, int k) const;
+			T var(std::size_t i, int k) const;
+			T std(std::size_t i, int k) const;
+		private:
+			A x0_ = 0;
+			//s_[i] & ss_[i] are the sums over the first i (shifted) values
+			std::vector<A> s_;
+			std::vector<A> ss_;
+	};
+	//sparse table of the series, comp(a, b) is true if a is kept over b (std::less for the min, std::greater for the max)
+	//only the levels needed for ranges of up to max_k elements are built
+	template <typename T, typename Comp>
+	class SparseTable{
+		public:
+			template <typename InputIt, typename UnaryOp>
+			SparseTable(InputIt first, InputIt last, std::size_t max_k, UnaryOp un_op, Comp comp = Comp{});
+			std::size_t size() const;
+			//min or max of the elements [l, r] (r - l + 1 <= max_k)
+			T query(std::size_t l, std::size_t r) const;
+		private:
+			//levels_[j][i] is the min or max of the 2^j elements starting at i
+			std::vector<std::vector<T>> levels_;
+			Comp comp_;
+	};
+
+	//the distinct window lengths (sorted) of the I'th parameter of a grid (e.g. one built with utility::discretization)
+	template <std::size_t I, typename ...PointTypes>
+	std::vector<int> windows(const std::vector<std::tuple<PointTypes...>>& grid);
+	//column of the window k in a block computed for ks (throws if ks does not contain k)
+	std::size_t column(const std::vector<int>& ks, int k);
+	//check the windows (>= min_k) & size the block for a series of n elements whose first value for window k is at k - 1 + lag
+	template <typename T>
+	std::size_t block_setup(std::size_t n, const std::vector<int>& ks, int min_k, int lag, arma::Mat<T>& block, const std::string& fn);
+
+	//rolling mean for each window (utility::roll_mean, tech_ind::sma)
+	template <typename InputIt, typename T, typename UnaryOp>
+	std::size_t sma(InputIt first1, InputIt last1, const std::vector<int>& ks, UnaryOp un_op, arma::Mat<T>& block);
+	//rolling standard deviation for each window (utility::roll_std, tech_ind::mov_std) windows must be >= 2
+	template <typename InputIt, typename T, typename UnaryOp>
+	std::size_t roll_std(InputIt first1, InputIt last1, const std::vector<int>& ks, UnaryOp un_op, arma::Mat<T>& block);
+	//rolling minimum & maximum for each window (utility::roll_min, utility::roll_max)
+	template <typename InputIt, typename T, typename UnaryOp>
+	std::size_t roll_min(InputIt first1, InputIt last1, const std::vector<int>& ks, UnaryOp un_op, arma::Mat<T>& block);
+	template <typename InputIt, typename T, typename UnaryOp>
+	std::size_t roll_max(InputIt first1, InputIt last1, const std::vector<int>& ks, UnaryOp un_op, arma::Mat<T>& block);
+	//relative strength index with sma means of the gains & losses for each window (tech_ind::rsi_sma, first value at element k)
+	template <typename InputIt, typename T, typename UnaryOp>
+	std::size_t rsi_sma(InputIt first1, InputIt last1, const std::vector<int>& ks, UnaryOp un_op, arma::Mat<T>& block);
+	//donchian width (max high - min low) for each window (tech_ind::donch_width)
+	template <typename InputIt, typename T>
+	std::size_t donch_width(InputIt first1, InputIt last1, const std::vector<int>& ks, arma::Mat<T>& block);
+}
+
+template <typename T>
+template <typename InputIt, typename UnaryOp>
+sweep_ind::PrefixSums<T>::PrefixSums(InputIt first, InputIt last, UnaryOp un_op){
+	std::size_t n = std::distance(first, last);
+	s_.resize(n + 1);
+	ss_.resize(n + 1);
+	s_[0] = 0;
+	ss_[0] = 0;
+	if(n > 0){
+		x0_ = un_op(*first);
+	}
+	std::size_t i = 0;
+	for(auto it = first; it != last; it++, i++){
+		A x = static_cast<A>(un_op(*it)) - x0_;
+		s_[i + 1] = s_[i] + x;
+		ss_[i + 1] = ss_[i] + x*x;
+	}
+}
+template <typename T>
+std::size_t sweep_ind::PrefixSums<T>::size() const{
+	return s_.size() - 1;
+}
+template <typename T>
+typename sweep_ind::PrefixSums<T>::A sweep_ind::PrefixSums<T>::sum(std::size_t i, int k) const{
+	return (s_[i + 1] - s_[i + 1 - k]) + k*x0_;
+}
+template <typename T>
+T sweep_ind::PrefixSums<T>::mean(std::size_t i, int k) const{
+	return x0_ + (s_[i + 1] - s_[i + 1 - k]) / k;
+}
+template <typename T>
+T sweep_ind::PrefixSums<T>::var(std::size_t i, int k) const{
+	//the variance is shift invariant so it is computed from the shifted sums
+	A s = s_[i + 1] - s_[i + 1 - k];
+	A ss = ss_[i + 1] - ss_[i + 1 - k];
+	A v = (ss - s*s / k) / (k - 1);
+	//rounding can make the variance of a flat window slightly negative
+	return v > 0 ? v : 0;
+}
+template <typename T>
+T sweep_ind::PrefixSums<T>::std(std::size_t i, int k) const{
+	return std::sqrt(var(i, k));
+}
+
+template <typename T, typename Comp>
+template <typename InputIt, typename UnaryOp>
+sweep_ind::SparseTable<T, Comp>::SparseTable(InputIt first, InputIt last, std::size_t max_k, UnaryOp un_op, Comp comp) : comp_{comp}{
+	std::size_t n = std::distance(first, last);
+	levels_.emplace_back();
+	levels_[0].reserve(n);
+	for(auto it = first; it != last; it++){
+		levels_[0].push_back(un_op(*it));
+	}
+	//level j from level j - 1 (the two halves of each 2^j range) up to level bit_width(max_k) - 1
+	for(std::size_t w = 2; w <= std::min(n, max_k); w *= 2){
+		const std::vector<T>& prev = levels_.back();
+		std::vector<T> level(n - w + 1);
+		for(std::size_t i = 0; i < level.size(); i++){
+			const T& a = prev[i];
+			const T& b = prev[i + w / 2];
+			level[i] = comp_(b, a) ? b : a;
+		}
+		levels_.push_back(std::move(level));
+	}
+}
+template <typename T, typename Comp>
+std::size_t sweep_ind::SparseTable<T, Comp>::size() const{
+	return levels_[0].size();
+}
+template <typename T, typename Comp>
+T sweep_ind::SparseTable<T, Comp>::query(std::size_t l, std::size_t r) const{
+	//two (overlapping) ranges of the largest power of 2 that fits cover [l, r]
+	std::size_t j = std::bit_width(r - l + 1) - 1;
+	const T& a = levels_[j][l];
+	const T& b = levels_[j][r + 1 - (std::size_t{1} << j)];
+	return comp_(b, a) ? b : a;
+}
+
+template <std::size_t I, typename ...PointTypes>
+std::vector<int> sweep_ind::windows(const std::vector<std::tuple<PointTypes...>>& grid){
+	std::vector<int> ks;
+	ks.reserve(grid.size());
+	for(const auto& pt : grid){
+		ks.push_back(static_cast<int>(std::get<I>(pt)));
+	}
+	std::sort(ks.begin(), ks.end());
+	ks.erase(std::unique(ks.begin(), ks.end()), ks.end());
+	return ks;
+}
+inline std::size_t sweep_ind::column(const std::vector<int>& ks, int k){
+	auto it = std::find(ks.begin(), ks.end(), k);
+	if(it == ks.end()){
+		throw std::invalid_argument("sweep_ind::column: window " + std::to_string(k) + " is not in the sweep");
+	}
+	return std::distance(ks.begin(), it);
+}
+template <typename T>
+std::size_t sweep_ind::block_setup(std::size_t n, const std::vector<int>& ks, int min_k, int lag, arma::Mat<T>& block, const std::string& fn){
+	int max_k = 0;
+	for(int k : ks){
+		if(k < min_k){
+			throw std::invalid_argument(fn + ": windows must be >= " + std::to_string(min_k));
+		}
+		max_k = std::max(max_k, k);
+	}
+	std::size_t start = ks.empty() ? 0 : max_k - 1 + lag;
+	block.set_size(n > start ? n - start : 0, ks.size());
+	return start;
+}
+
+template <typename InputIt, typename T, typename UnaryOp>
+std::size_t sweep_ind::sma(InputIt first1, InputIt last1, const std::vector<int>& ks, UnaryOp un_op, arma::Mat<T>& block){
+	PrefixSums<T> ps(first1, last1, un_op);
+	std::size_t start = block_setup(ps.size(), ks, 1, 0, block, "sweep_ind::sma");
+	for(std::size_t j = 0; j < ks.size(); j++){
+		//each window writes its own (contiguous) column
+		T* col = block.colptr(j);
+		for(std::size_t r = 0; r < block.n_rows; r++){
+			col[r] = ps.mean(start + r, ks[j]);
+		}
+	}
+	return start;
+}
+template <typename InputIt, typename T, typename UnaryOp>
+std::size_t sweep_ind::roll_std(InputIt first1, InputIt last1, const std::vector<int>& ks, UnaryOp un_op, arma::Mat<T>& block){
+	PrefixSums<T> ps(first1, last1, un_op);
+	std::size_t start = block_setup(ps.size(), ks, 2, 0, block, "sweep_ind::roll_std");
+	for(std::size_t j = 0; j < ks.size(); j++){
+		T* col = block.colptr(j);
+		for(std::size_t r = 0; r < block.n_rows; r++){
+			col[r] = ps.std(start + r, ks[j]);
+		}
+	}
+	return start;
+}
+template <typename InputIt, typename T, typename UnaryOp>
+std::size_t sweep_ind::roll_min(InputIt first1, InputIt last1, const std::vector<int>& ks, UnaryOp un_op, arma::Mat<T>& block){
+	//the largest window is start + 1
+	std::size_t start = block_setup(std::distance(first1, last1), ks, 1, 0, block, "sweep_ind::roll_min");
+	SparseTable<T, std::less<T>> st(first1, last1, start + 1, un_op);
+	for(std::size_t j = 0; j < ks.size(); j++){
+		T* col = block.colptr(j);
+		for(std::size_t r = 0; r < block.n_rows; r++){
+			std::size_t i = start + r;
+			col[r] = st.query(i + 1 - ks[j], i);
+		}
+	}
+	return start;
+}
+template <typename InputIt, typename T, typename UnaryOp>
+std::size_t sweep_ind::roll_max(InputIt first1, InputIt last1, const std::vector<int>& ks, UnaryOp un_op, arma::Mat<T>& block){
+	//the largest window is start + 1
+	std::size_t start = block_setup(std::distance(first1, last1), ks, 1, 0, block, "sweep_ind::roll_max");
+	SparseTable<T, std::greater<T>> st(first1, last1, start + 1, un_op);
+	for(std::size_t j = 0; j < ks.size(); j++){
+		T* col = block.colptr(j);
+		for(std::size_t r = 0; r < block.n_rows; r++){
+			std::size_t i = start + r;
+			col[r] = st.query(i + 1 - ks[j], i);
+		}
+	}
+	return start;
+}
+template <typename InputIt, typename T, typename UnaryOp>
+std::size_t sweep_ind::rsi_sma(InputIt first1, InputIt last1, const std::vector<int>& ks, UnaryOp un_op, arma::Mat<T>& block){
+	std::size_t n = std::distance(first1, last1);
+	//gains & losses of the elements [1, n) (element i is at i - 1)
+	std::vector<T> u;
+	std::vector<T> d;
+	u.reserve(n);
+	d.reserve(n);
+	for(auto it = first1; n > 0 && std::next(it) != last1; it++){
+		T diff = un_op(*std::next(it)) - un_op(*it);
+		u.push_back(diff > 0 ? diff : 0.0);
+		d.push_back(diff < 0 ? -1*diff : 0.0);
+	}
+	std::identity id;
+	PrefixSums<T> ups(u.cbegin(), u.cend(), id);
+	PrefixSums<T> dps(d.cbegin(), d.cend(), id);
+	std::size_t start = block_setup(n, ks, 1, 1, block, "sweep_ind::rsi_sma");
+	for(std::size_t j = 0; j < ks.size(); j++){
+		T* col = block.colptr(j);
+		for(std::size_t r = 0; r < block.n_rows; r++){
+			//same as utility::rsi_timestamp
+			T mu = ups.mean(start + r - 1, ks[j]);
+			T md = dps.mean(start + r - 1, ks[j]);
+			col[r] = (mu + md) == 0.0 ? 50.0 : 100 - ((100*md) / (mu + md));
+		}
+	}
+	return start;
+}
+template <typename InputIt, typename T>
+std::size_t sweep_ind::donch_width(InputIt first1, InputIt last1, const std::vector<int>& ks, arma::Mat<T>& block){
+	//the largest window is start + 1
+	std::size_t start = block_setup(std::distance(first1, last1), ks, 1, 0, block, "sweep_ind::donch_width");
+	SparseTable<T, std::greater<T>> h(first1, last1, start + 1, [](const auto& c){ return c.h(); });
+	SparseTable<T, std::less<T>> l(first1, last1, start + 1, [](const auto& c){ return c.l(); });
+	for(std::size_t j = 0; j < ks.size(); j++){
+		T* col = block.colptr(j);
+		for(std::size_t r = 0; r < block.n_rows; r++){
+			std::size_t i = start + r;
+			col[r] = h.query(i + 1 - ks[j], i) - l.query(i + 1 - ks[j], i);
+		}
+	}
+	return start;
+}
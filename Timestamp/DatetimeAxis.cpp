@@ -0,0 +1,31 @@
+#include "DatetimeAxis.h"
+#include <algorithm>
+
+DatetimeAxis::DatetimeAxis(std::vector<std::int64_t> epochs, const std::chrono::time_zone* tmz) : epochs_{std::move(epochs)}, tmz_{tmz} {};
+DatetimeAxis::DatetimeAxis(std::span<const std::int64_t> epochs, const std::chrono::time_zone* tmz) : epochs_(epochs.begin(), epochs.end()), tmz_{tmz} {};
+
+std::size_t DatetimeAxis::size() const{
+	return epochs_.size();
+}
+bool DatetimeAxis::empty() const{
+	return epochs_.empty();
+}
+std::int64_t DatetimeAxis::epoch(std::size_t i) const{
+	return epochs_[i];
+}
+Datetime DatetimeAxis::dt(std::size_t i) const{
+	return Datetime(std::chrono::sys_seconds{std::chrono::seconds{epochs_[i]}}, tmz_);
+}
+std::span<const std::int64_t> DatetimeAxis::epochs() const{
+	return epochs_;
+}
+const std::chrono::time_zone* DatetimeAxis::tmz() const{
+	return tmz_;
+}
+std::size_t DatetimeAxis::index_of(std::int64_t epoch) const{
+	auto it = std::lower_bound(epochs_.cbegin(), epochs_.cend(), epoch);
+	if(it == epochs_.cend() || *it != epoch){
+		return npos;
+	}
+	return static_cast<std::size_t>(it - epochs_.cbegin());
+}
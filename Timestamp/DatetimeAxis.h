@@ -0,0 +1,57 @@
+#pragma once
+#include "../Datetime/Datetime.h"
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <vector>
+
+//Sorted datetimes of a series stored once as seconds since the unix epoch (utc) & shared (through a shared_ptr) by the
+//TimeSeries objects computed from the series. A TimeSeries refers to its datetimes by an offset into the axis
+class DatetimeAxis{
+	public:
+		static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+		DatetimeAxis() = default;
+		DatetimeAxis(std::vector<std::int64_t> epochs, const std::chrono::time_zone* tmz);
+		DatetimeAxis(std::span<const std::int64_t> epochs, const std::chrono::time_zone* tmz);
+		//build the axis from a range of objects with .dt() methods (Candle, CandlePtr, Timestamp etc.)
+		template <typename It>
+		DatetimeAxis(It first, It last);
+		//accessors
+		std::size_t size() const;
+		bool empty() const;
+		std::int64_t epoch(std::size_t i) const;
+		Datetime dt(std::size_t i) const;
+		std::span<const std::int64_t> epochs() const;
+		const std::chrono::time_zone* tmz() const;
+		//position of epoch on the axis (npos if it is not on the axis)
+		std::size_t index_of(std::int64_t epoch) const;
+	private:
+		std::vector<std::int64_t> epochs_;
+		const std::chrono::time_zone* tmz_ = std::chrono::current_zone();
+};
+
+template <typename It>
+DatetimeAxis::DatetimeAxis(It first, It last){
+	//CandlePtr::dt returns a pointer to a Datetime
+	auto epoch_of = [](const auto& x){
+		if constexpr(requires { x.dt()->epoch(); }){
+			return x.dt()->epoch();
+		}else{
+			return x.dt().epoch();
+		}
+	};
+	epochs_.reserve(std::distance(first, last));
+	if(first != last){
+		if constexpr(requires { first->dt()->zt(); }){
+			tmz_ = first->dt()->zt().get_time_zone();
+		}else{
+			tmz_ = first->dt().zt().get_time_zone();
+		}
+	}
+	for(auto it = first; it != last; it++){
+		epochs_.push_back(epoch_of(*it));
+	}
+}
@@ -0,0 +1,289 @@
+#pragma once
+#include "Timestamp.h"
+#include "DatetimeAxis.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//Columnar alternative to std::vector<Timestamp<T>>. The variable name is stored once, the values are stored contiguously
+//& the datetimes are the positions [offset_, offset_ + size()) of a DatetimeAxis shared with the series the values were
+//computed from (no per element allocations). Iterators dereference to a Point which has the same .dt() & .val() accessors
+//as Timestamp<T> so sync_iterators, generate_matrix & the tech_ind functions accept TimeSeries iterators directly
+template <typename T>
+class TimeSeries{
+	public:
+		class const_iterator;
+		//proxy for the element at position i
+		class Point{
+			public:
+				Point(const TimeSeries* ts, std::size_t i) : ts_{ts}, i_{i} {};
+				Datetime dt() const{ return ts_->dt(i_); }
+				const T& val() const{ return ts_->val(i_); }
+				const std::string& var() const{ return ts_->name(); }
+				void display() const;
+				//materialize the element
+				Timestamp<T> timestamp() const{ return Timestamp<T>(dt(), val(), var()); }
+				//the tech_ind templates recover positions with std::distance(&(*first1), &x)
+				const_iterator operator&() const{ return const_iterator(ts_, i_); }
+			private:
+				const TimeSeries* ts_;
+				std::size_t i_;
+		};
+		//random access iterator (dereferences to a Point by value)
+		class const_iterator{
+			public:
+				using iterator_category = std::random_access_iterator_tag;
+				using value_type = Point;
+				using difference_type = std::ptrdiff_t;
+				using reference = Point;
+				struct pointer{
+					Point ref;
+					const Point* operator->() const{ return std::addressof(ref); }
+				};
+				const_iterator() = default;
+				const_iterator(const TimeSeries* ts, std::size_t i) : ts_{ts}, i_{i} {};
+				reference operator*() const{ return Point(ts_, i_); }
+				pointer operator->() const{ return pointer{Point(ts_, i_)}; }
+				reference operator[](difference_type n) const{ return Point(ts_, i_ + n); }
+				const_iterator& operator++(){ ++i_; return *this; }
+				const_iterator operator++(int){ const_iterator tmp = *this; ++i_; return tmp; }
+				const_iterator& operator--(){ --i_; return *this; }
+				const_iterator operator--(int){ const_iterator tmp = *this; --i_; return tmp; }
+				const_iterator& operator+=(difference_type n){ i_ += n; return *this; }
+				const_iterator& operator-=(difference_type n){ i_ -= n; return *this; }
+				friend const_iterator operator+(const_iterator it, difference_type n){ return it += n; }
+				friend const_iterator operator+(difference_type n, const_iterator it){ return it += n; }
+				friend const_iterator operator-(const_iterator it, difference_type n){ return it -= n; }
+				friend difference_type operator-(const const_iterator& lhs, const const_iterator& rhs){
+					return static_cast<difference_type>(lhs.i_) - static_cast<difference_type>(rhs.i_);
+				}
+				friend bool operator==(const const_iterator& lhs, const const_iterator& rhs){ return lhs.i_ == rhs.i_; }
+				friend auto operator<=>(const const_iterator& lhs, const const_iterator& rhs){ return lhs.i_ <=> rhs.i_; }
+				std::size_t index() const{ return i_; }
+			private:
+				const TimeSeries* ts_ = nullptr;
+				std::size_t i_ = 0;
+		};
+		//output iterator which can be passed to the tech_ind functions in place of a std::vector<Timestamp<T>> iterator
+		//utility::timestamp_zip writes the values straight into the series, other writes (*w = Timestamp<T>{...}) go through a Slot
+		class writer{
+			public:
+				using iterator_category = std::output_iterator_tag;
+				using value_type = void;
+				using difference_type = std::ptrdiff_t;
+				using pointer = void;
+				using reference = void;
+				struct Slot{
+					TimeSeries* ts;
+					std::size_t i;
+					Slot& operator=(const Timestamp<T>& t){
+						ts->write_(i, t.dt().epoch(), t.val());
+						return *this;
+					}
+				};
+				writer() = default;
+				writer(TimeSeries* ts, std::size_t i) : ts_{ts}, i_{i} {};
+				Slot operator*() const{ return Slot{ts_, i_}; }
+				writer& operator++(){ ++i_; return *this; }
+				writer operator++(int){ writer tmp = *this; ++i_; return tmp; }
+				TimeSeries& series() const{ return *ts_; }
+				std::size_t index() const{ return i_; }
+			private:
+				TimeSeries* ts_ = nullptr;
+				std::size_t i_ = 0;
+		};
+
+		TimeSeries() = default;
+		TimeSeries(std::shared_ptr<const DatetimeAxis> axis, const std::string& name = "");
+		//vals[i] is the value at datetime axis->dt(offset + i)
+		TimeSeries(std::shared_ptr<const DatetimeAxis> axis, std::size_t offset, std::vector<T> vals, const std::string& name);
+		//accessors
+		const std::string& name() const;
+		void set_name(const std::string& name);
+		const std::shared_ptr<const DatetimeAxis>& axis() const;
+		std::size_t offset() const;
+		std::size_t size() const;
+		bool empty() const;
+		std::span<const T> vals() const;
+		const T& val(std::size_t i) const;
+		Datetime dt(std::size_t i) const;
+		std::int64_t epoch(std::size_t i) const;
+		//element access & iterators
+		Point operator[](std::size_t i) const;
+		const_iterator begin() const;
+		const_iterator end() const;
+		//writer starting at position 0 (the first write fixes the offset into the axis)
+		writer wbegin();
+		//resize the series so that positions [i, i + n) exist & return them for writing
+		//first_dt & last_dt are the datetimes of positions i & i + n - 1 (throws if they are not the matching points on the axis)
+		std::span<T> write_span(std::size_t i, const Datetime& first_dt, const Datetime& last_dt, std::size_t n);
+		void clear();
+		//convert to the row based representation
+		std::vector<Timestamp<T>> timestamps() const;
+		//display function
+		void display() const;
+	private:
+		std::shared_ptr<const std::string> name_ = std::make_shared<const std::string>();
+		std::shared_ptr<const DatetimeAxis> axis_;
+		std::size_t offset_ = 0;
+		std::vector<T> vals_;
+		//position of epoch on the axis (throws if it is not on the axis)
+		std::size_t locate_(std::int64_t epoch) const;
+		//write val at position i (i <= size()), the first write into an empty series fixes the offset
+		void write_(std::size_t i, std::int64_t epoch, const T& val);
+};
+
+template <typename T>
+void TimeSeries<T>::Point::display() const{
+	dt().display();
+	std::cout << std::setprecision(12);
+	std::cout << " " << var() << ": " << val() << std::endl;
+}
+
+template <typename T>
+TimeSeries<T>::TimeSeries(std::shared_ptr<const DatetimeAxis> axis, const std::string& name) :
+	name_{std::make_shared<const std::string>(name)}, axis_{std::move(axis)} {};
+
+template <typename T>
+TimeSeries<T>::TimeSeries(std::shared_ptr<const DatetimeAxis> axis, std::size_t offset, std::vector<T> vals, const std::string& name) :
+	name_{std::make_shared<const std::string>(name)}, axis_{std::move(axis)}, offset_{offset}, vals_{std::move(vals)} {
+	if(!axis_ || offset_ + vals_.size() > axis_->size()){
+		throw std::invalid_argument("TimeSeries: the values do not fit on the datetime axis");
+	}
+}
+
+//accessors
+template <typename T>
+const std::string& TimeSeries<T>::name() const{
+	return *name_;
+}
+template <typename T>
+void TimeSeries<T>::set_name(const std::string& name){
+	if(name != *name_){
+		name_ = std::make_shared<const std::string>(name);
+	}
+}
+template <typename T>
+const std::shared_ptr<const DatetimeAxis>& TimeSeries<T>::axis() const{
+	return axis_;
+}
+template <typename T>
+std::size_t TimeSeries<T>::offset() const{
+	return offset_;
+}
+template <typename T>
+std::size_t TimeSeries<T>::size() const{
+	return vals_.size();
+}
+template <typename T>
+bool TimeSeries<T>::empty() const{
+	return vals_.empty();
+}
+template <typename T>
+std::span<const T> TimeSeries<T>::vals() const{
+	return vals_;
+}
+template <typename T>
+const T& TimeSeries<T>::val(std::size_t i) const{
+	return vals_[i];
+}
+template <typename T>
+Datetime TimeSeries<T>::dt(std::size_t i) const{
+	return axis_->dt(offset_ + i);
+}
+template <typename T>
+std::int64_t TimeSeries<T>::epoch(std::size_t i) const{
+	return axis_->epoch(offset_ + i);
+}
+
+template <typename T>
+typename TimeSeries<T>::Point TimeSeries<T>::operator[](std::size_t i) const{
+	return Point(this, i);
+}
+template <typename T>
+typename TimeSeries<T>::const_iterator TimeSeries<T>::begin() const{
+	return const_iterator(this, 0);
+}
+template <typename T>
+typename TimeSeries<T>::const_iterator TimeSeries<T>::end() const{
+	return const_iterator(this, vals_.size());
+}
+template <typename T>
+typename TimeSeries<T>::writer TimeSeries<T>::wbegin(){
+	return writer(this, 0);
+}
+
+template <typename T>
+std::span<T> TimeSeries<T>::write_span(std::size_t i, const Datetime& first_dt, const Datetime& last_dt, std::size_t n){
+	if(n == 0){
+		return std::span<T>();
+	}
+	if(i > vals_.size()){
+		throw std::invalid_argument("TimeSeries::write_span: writes must start at or before the end of the series");
+	}
+	if(vals_.empty()){
+		offset_ = locate_(first_dt.epoch());
+	}
+	if(offset_ + i + n > axis_->size() || axis_->epoch(offset_ + i) != first_dt.epoch() || axis_->epoch(offset_ + i + n - 1) != last_dt.epoch()){
+		throw std::invalid_argument("TimeSeries::write_span: the datetimes do not line up with the datetime axis");
+	}
+	if(vals_.size() < i + n){
+		vals_.resize(i + n);
+	}
+	return std::span<T>(vals_.data() + i, n);
+}
+template <typename T>
+void TimeSeries<T>::clear(){
+	offset_ = 0;
+	vals_.clear();
+}
+
+template <typename T>
+std::vector<Timestamp<T>> TimeSeries<T>::timestamps() const{
+	std::vector<Timestamp<T>> out;
+	out.reserve(vals_.size());
+	for(std::size_t i = 0; i < vals_.size(); i++){
+		out.push_back(Timestamp<T>(dt(i), vals_[i], *name_));
+	}
+	return out;
+}
+template <typename T>
+void TimeSeries<T>::display() const{
+	for(const_iterator it = begin(); it != end(); it++){
+		it->display();
+	}
+}
+
+template <typename T>
+std::size_t TimeSeries<T>::locate_(std::int64_t epoch) const{
+	if(!axis_){
+		throw std::runtime_error("TimeSeries: the series has no datetime axis");
+	}
+	std::size_t i = axis_->index_of(epoch);
+	if(i == DatetimeAxis::npos){
+		throw std::invalid_argument("TimeSeries: datetime is not on the datetime axis");
+	}
+	return i;
+}
+template <typename T>
+void TimeSeries<T>::write_(std::size_t i, std::int64_t epoch, const T& val){
+	if(i > vals_.size()){
+		throw std::invalid_argument("TimeSeries: writes must be made in order");
+	}
+	if(vals_.empty()){
+		offset_ = locate_(epoch);
+	}
+	if(offset_ + i >= axis_->size() || axis_->epoch(offset_ + i) != epoch){
+		throw std::invalid_argument("TimeSeries: datetime does not line up with the datetime axis");
+	}
+	if(i == vals_.size()){
+		vals_.push_back(val);
+	}else{
+		vals_[i] = val;
+	}
+}
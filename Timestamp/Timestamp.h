@@ -1,5 +1,6 @@
 #pragma once
 #include "../Datetime/Datetime.h" 
+#include <memory>
 
 template <typename T> 
 class Timestamp{
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#if __has_include(<experimental/simd>) && !defined(UTILITY_NO_SIMD)
+#include <experimental/simd>
+#endif
+
+//Portable wrapper over the SIMD packs used by the span kernels in utility.h. With <experimental/simd> (libstdc++ 11+) a pack
+//is a native_simd (the widest the target supports), otherwise (or if UTILITY_NO_SIMD is defined) a pack holds a single value
+//& the kernels run as plain scalar loops. The kernels only use lane wise +, -, * & / so every lane computes what the scalar
+//code computes (the results are the same bits with or without SIMD)
+namespace simd{
+#if __has_include(<experimental/simd>) && !defined(UTILITY_NO_SIMD)
+	template <typename T>
+	using pack = std::experimental::native_simd<T>;
+	template <typename T>
+	pack<T> load(const T* p){
+		return pack<T>(p, std::experimental::element_aligned);
+	}
+	template <typename T>
+	void store(const pack<T>& v, T* p){
+		v.copy_to(p, std::experimental::element_aligned);
+	}
+#else
+	template <typename T>
+	struct pack{
+		T v;
+		pack() = default;
+		pack(T x) : v{x} {}
+		static constexpr std::size_t size(){
+			return 1;
+		}
+		friend pack operator+(const pack& a, const pack& b){ return pack(a.v + b.v); }
+		friend pack operator-(const pack& a, const pack& b){ return pack(a.v - b.v); }
+		friend pack operator*(const pack& a, const pack& b){ return pack(a.v * b.v); }
+		friend pack operator/(const pack& a, const pack& b){ return pack(a.v / b.v); }
+	};
+	template <typename T>
+	pack<T> load(const T* p){
+		return pack<T>(*p);
+	}
+	template <typename T>
+	void store(const pack<T>& v, T* p){
+		*p = v.v;
+	}
+#endif
+	//number of lanes of a pack of T
+	template <typename T>
+	constexpr std::size_t width = pack<T>::size();
+}
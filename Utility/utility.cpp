@@ -718,74 +718,11 @@ double utility::parse::convert_cell(const std::string& cell){
 	}
 	return std::stod(formatted_cell); 
 }
-void utility::sync_iterators(std::pair<std::pair<std::vector<CandlePtr>::const_iterator, std::vector<CandlePtr>::const_iterator>, 
-		std::pair<std::vector<CandlePtr>::const_iterator, std::vector<CandlePtr>::const_iterator>>& csitpp){
-	Datetime lf_dt; 
-	Datetime fl_dt;
-	if(*(csitpp.first.first->dt()) > *(csitpp.second.first->dt())){
-		lf_dt = *((csitpp.first.first->dt()));  
-		for(auto it = csitpp.second.first; it != csitpp.second.second; it++){
-			if(*(it->dt()) == lf_dt){
-				csitpp.second.first = it; 
-			}
-		}
-	}else{
-		lf_dt = *((csitpp.second.first->dt()));  
-		for(auto it = csitpp.first.first; it != csitpp.first.second; it++){
-			if(*(it->dt()) == lf_dt){
-				csitpp.first.first = it; 
-			}
-		}
-	}
-	if(*(csitpp.first.second->dt()) < *(csitpp.second.second->dt())){
-		fl_dt = *((csitpp.first.second->dt()));  
-		for(auto it = csitpp.second.second; it != csitpp.second.first; it--){
-			if(*(it->dt()) == fl_dt){
-				csitpp.second.second = it; 
-			}
-		}
-	}else{
-		fl_dt = *((csitpp.second.second->dt()));  
-		for(auto it = csitpp.first.second; it != csitpp.first.first; it--){
-			if(*(it->dt()) == fl_dt){
-				csitpp.first.second = it; 
-			}
-		}
-	}
-}
-void utility::sync_iterators(std::pair<std::pair<std::vector<Candle>::const_iterator, std::vector<Candle>::const_iterator>, 
-			std::pair<std::vector<Candle>::const_iterator, std::vector<Candle>::const_iterator>>& csitpp){
-	Datetime lf_dt; 
-	Datetime fl_dt;
-	if(csitpp.first.first->dt() > csitpp.second.first->dt()){
-		lf_dt = (csitpp.first.first->dt());  
-		for(auto it = csitpp.second.first; it != csitpp.second.second; it++){
-			if(it->dt() == lf_dt){
-				csitpp.second.first = it; 
-			}
-		}
-	}else{
-		lf_dt = (csitpp.second.first->dt());  
-		for(auto it = csitpp.first.first; it != csitpp.first.second; it++){
-			if(it->dt() == lf_dt){
-				csitpp.first.first = it; 
-			}
-		}
+void utility::span_kernel_check(std::size_t n, std::size_t n_out, std::size_t k, std::size_t min_k, const std::string& fn){
+	if(k < min_k || k > n){
+		throw std::invalid_argument(fn + ": window must be in [" + std::to_string(min_k) + ", x.size()]");
 	}
-	if(csitpp.first.second->dt() < csitpp.second.second->dt()){
-		fl_dt = (csitpp.first.second->dt());  
-		for(auto it = csitpp.second.second; it != csitpp.second.first; it--){
-			if(it->dt() == fl_dt){
-				csitpp.second.second = it; 
-			}
-		}
-	}else{
-		fl_dt = (csitpp.second.second->dt());  
-		for(auto it = csitpp.first.second; it != csitpp.first.first; it--){
-			if(it->dt() == fl_dt){
-				csitpp.first.second = it; 
-			}
-		}
+	if(n_out < n - k + 1){
+		throw std::invalid_argument(fn + ": out must hold x.size() - k + 1 values");
 	}
 }
-
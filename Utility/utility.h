@@ -12,10 +12,16 @@
 #include <thread>
 #include <filesystem>
 #include <stack> 
+#include <iterator> 
 #include <stdio.h>
 #include <pugixml.hpp> 
 #include <boost/regex.hpp> 
+#include <span>
+#include <concepts>
+#include <type_traits>
+#include "simd.h"
 #include "../Timestamp/Timestamp.h"
+#include "../Timestamp/TimeSeries.h"
 #include "../Candle/CandlePtr.h" 
 #include "../Candle/Candle.h" 
 
@@ -237,6 +243,21 @@ namespace utility{
 	template <typename InputIt, typename OutputIt, typename UnaryOp, typename T> 
 	void roll_log_returns(InputIt first1, InputIt last1, OutputIt first2, int k, UnaryOp un_op, T ex);
 
+	//Neumaier (improved Kahan) compensated sum: the rounding error of every add/sub is carried in a second term, so a running
+	//window sum (add the new value, sub the old one) stays within a few ulps of the exact window sum however many values pass
+	//through it instead of drifting like roll_mean_update (used by the float feature pipeline, see FeaturePlan::eval)
+	template <typename T> 
+	class NeumaierSum{
+		public:
+			NeumaierSum() = default;
+			NeumaierSum(T s);
+			void add(T x);
+			void sub(T x);
+			T value() const;
+		private:
+			T s_ = 0;
+			T c_ = 0;
+	};
 	//rolling update functions 
 	template <typename T>
 	void roll_mean_update(T& mean, const T& old_val, const T& new_val, int k);
@@ -485,6 +506,30 @@ namespace utility{
 	template <typename InputIt, typename OutputIt, typename T, typename UnaryOp>	
 	void roll_zscore(InputIt first1, InputIt last1, OutputIt first2, int k, T init, UnaryOp un_op); 
 
+	//span overloads of the rolling kernels for contiguous float & double data (the iterator versions without a unary call these
+	//when both ranges are contiguous & hold T). out holds x.size() - k + 1 values (x.size() - weights.size() + 1 for roll_wtd_mean)
+	//The loop carried updates (roll_mean_update, roll_std_update ...) run in the same order as in the iterator versions & the
+	//lane independent work (the weighted means of different windows, the z-scores from the rolling means & stds) is done a
+	//simd::pack at a time, so the values are bit identical to the iterator versions (throws if out is too small or k is invalid)
+	template <typename T> 
+	concept span_kernel_type = std::same_as<T, float> || std::same_as<T, double>;
+	//true if an iterator version can forward [first1, last1) & first2 to the span overloads
+	template <typename InputIt, typename OutputIt, typename T> 
+	concept span_kernel_its = span_kernel_type<T> && std::contiguous_iterator<InputIt> && std::contiguous_iterator<OutputIt> 
+		&& std::same_as<std::iter_value_t<InputIt>, T> && std::same_as<std::iter_value_t<OutputIt>, T>;
+	template <span_kernel_type T> 
+	void roll_mean(std::span<const std::type_identity_t<T>> x, std::span<std::type_identity_t<T>> out, int k, T init); 
+	template <span_kernel_type T> 
+	void roll_var(std::span<const std::type_identity_t<T>> x, std::span<std::type_identity_t<T>> out, int k, T init); 
+	template <span_kernel_type T> 
+	void roll_std(std::span<const std::type_identity_t<T>> x, std::span<std::type_identity_t<T>> out, int k, T init); 
+	template <span_kernel_type T> 
+	void roll_zscore(std::span<const std::type_identity_t<T>> x, std::span<std::type_identity_t<T>> out, int k, T init); 
+	template <span_kernel_type T> 
+	void roll_wtd_mean(std::span<const std::type_identity_t<T>> x, std::span<std::type_identity_t<T>> out, std::span<const std::type_identity_t<T>> weights, T init); 
+	//check the window & output size of a span kernel
+	void span_kernel_check(std::size_t n, std::size_t n_out, std::size_t k, std::size_t min_k, const std::string& fn); 
+
 	//rolling min-max normalization 
 	template <typename InputIt, typename OutputIt, typename T> 
 	void roll_minmax_norm(InputIt first1, InputIt last1, OutputIt first2, int k, T undef);
@@ -513,6 +558,7 @@ namespace utility{
 	
 	//function to fill a vector of timestamps from an iterator range given a starting iterator to an object which has a .dt() method
 	//name is the name of the variable held in the timestamps
+	//Note: if OutputIt is a TimeSeries<T>::writer the values are written straight into the series (no Timestamp objects are made) 
 	template <typename DtStartIt, typename InputIt, typename OutputIt, typename T> 
 	void timestamp_zip(InputIt first1, InputIt last1, DtStartIt dt_first, OutputIt first2, const std::string& name, T ex);
 	//Timestamp zip which takes two iterator ranges & a binary operation used to make the timestamps 
@@ -588,6 +634,10 @@ namespace utility{
 	
 	//given an iterator first we find the iterator in the range [it, last) whose .dt() method equals dt
 	//uses ++ if forwards = true and -- if false ==> InputIt must be a bidirectional iterator which points to objects with a .dt() method
+	//for random access iterators the range is assumed to be sorted by datetime and is searched without a scan (falls back to the scan if dt is not found)
+	//datetime of x whether x.dt() returns a Datetime (Candle, CandleView, Timestamp) or a pointer to one (CandlePtr)
+	template <typename T> 
+	Datetime dt_of(const T& x); 
 	template <typename InputIt> 
 	InputIt find_iterator_to_dt(InputIt it, InputIt last, const Datetime& dt, bool forwards = true);  
 	//assumes the objects pointed to by the iterators in the ItPairs have .dt() methods
@@ -595,11 +645,9 @@ namespace utility{
 	//returns the starting and ending pairs which have the same start datetime and end datetime
 	template <typename... ItPairs> 
 	void sync_iterators(std::tuple<ItPairs...>& iterator_pairs);
-	
-	void sync_iterators(std::pair<std::pair<std::vector<CandlePtr>::const_iterator, std::vector<CandlePtr>::const_iterator>, 
-			std::pair<std::vector<CandlePtr>::const_iterator, std::vector<CandlePtr>::const_iterator>>& csitp_tup); 
-	void sync_iterators(std::pair<std::pair<std::vector<Candle>::const_iterator, std::vector<Candle>::const_iterator>, 
-			std::pair<std::vector<Candle>::const_iterator, std::vector<Candle>::const_iterator>>& csitpp); 
+	//sync two (first, last) pairs of candle iterators (Candle, CandlePtr or CandleView iterators, e.g. cs_it_b or htf_it_b) 
+	template <typename CandleIt> 
+	void sync_iterators(std::pair<std::pair<CandleIt, CandleIt>, std::pair<CandleIt, CandleIt>>& csitpp); 
 
 	template <size_t... Is, typename... ItPairs> 
 	void sync_iterators_impl(std::tuple<ItPairs...>& iterator_pairs, std::index_sequence<Is...> indices); 
@@ -620,10 +668,9 @@ namespace utility{
 	template <typename LabelItPair, typename... ItPairs> 
 	void sync_matrix_labels_iterators(std::tuple<ItPairs...>& mat_it_pairs,  LabelItPair& lab_it_pair); 	
 	
-	template <typename... ItPairs> 
-	void sync_matrix_cs_iterators(std::tuple<ItPairs...>& mat_it_pairs, std::pair<std::vector<CandlePtr>::const_iterator, std::vector<CandlePtr>::const_iterator>& csitp); 
-	template <typename... ItPairs> 
-	void sync_matrix_cs_iterators(std::tuple<ItPairs...>& mat_it_pairs, std::pair<std::vector<Candle>::const_iterator, std::vector<Candle>::const_iterator>& csitp); 
+	//sync the iterators to be passed to generate_matrix with a pair of candle iterators (Candle, CandlePtr or CandleView iterators)
+	template <typename CandleIt, typename... ItPairs> 
+	void sync_matrix_cs_iterators(std::tuple<ItPairs...>& mat_it_pairs, std::pair<CandleIt, CandleIt>& csitp); 
 
 	template <typename T, typename It>
 	void split_matrix(const arma::Mat<T>& mat, std::vector<arma::Mat<T>>& mat_splits, const std::pair<It, It> flc_its, std::vector<std::pair<It, It>>& flc_its_splits, int k); 
@@ -1205,6 +1252,28 @@ T utility::mean_abs_diff(InputIt last, const T& val, int k, UnaryOp un_op, T ini
 	return utility::mean(std::prev(last, k - 1), std::next(last), init, mad); 
 }
 
+template <typename T>
+utility::NeumaierSum<T>::NeumaierSum(T s) : s_{s} {}
+template <typename T>
+void utility::NeumaierSum<T>::add(T x){
+	T t = s_ + x;
+	//the low order bits lost by t are in the smaller of s_ & x
+	if(std::abs(s_) >= std::abs(x)){
+		c_ += (s_ - t) + x;
+	}else{
+		c_ += (x - t) + s_;
+	}
+	s_ = t;
+}
+template <typename T>
+void utility::NeumaierSum<T>::sub(T x){
+	add(-x);
+}
+template <typename T>
+T utility::NeumaierSum<T>::value() const{
+	return s_ + c_;
+}
+
 template <typename T>
 void utility::roll_mean_update(T& mean, const T& old_val, const T& new_val, int k){
 	mean = (((mean * k) - old_val) + new_val) / k; 	
@@ -1503,8 +1572,8 @@ template <typename T>
 T utility::roll_zscore_update(T& std, T& mean, const T& old_val, const T& new_val, int k){
 	//update the mean and the standard deviation
 	roll_std_update(std, mean, old_val, new_val, k);
-	//return the z-score
-	return (new_val - mean) / std; 
+	//return the z-score (0 if the standard deviation is 0 as in zscore)
+	return zscore(new_val, mean, std); 
 }
 template <typename InputIt, typename OutputIt>
 void utility::roll_max_update(InputIt first1, OutputIt out, std::deque<int>& dq_max, int i, int k){
@@ -1730,17 +1799,23 @@ void utility::roll_percentile_update(InputIt first, OutputIt out, std::deque<int
 //functions for computing the rolling mean
 template <typename InputIt, typename OutputIt, typename T> 
 void utility::roll_mean(InputIt first1, InputIt last1, OutputIt first2, int k, T init){
-	//iterator to keep track of the discarded value
-	auto itd = first1; 
-	//compute the mean of the first k values
-	T m = mean(first1, std::next(first1, k), init);
-	*first2 = m;
-	auto comp_next_mean = [&itd, &m, &k](const auto& x){
-		roll_mean_update(m, *itd, x, k);
-		++itd; 
-		return m; 
-	}; 
-	std::transform(std::next(first1, k), last1, std::next(first2), comp_next_mean); 
+	if constexpr(span_kernel_its<InputIt, OutputIt, T>){
+		//contiguous float or double data (same values as the code below)
+		std::size_t n = std::distance(first1, last1);
+		roll_mean(std::span<const T>(std::to_address(first1), n), std::span<T>(std::to_address(first2), n - k + 1), k, init);
+	}else{
+		//iterator to keep track of the discarded value
+		auto itd = first1; 
+		//compute the mean of the first k values
+		T m = mean(first1, std::next(first1, k), init);
+		*first2 = m;
+		auto comp_next_mean = [&itd, &m, &k](const auto& x){
+			roll_mean_update(m, *itd, x, k);
+			++itd; 
+			return m; 
+		}; 
+		std::transform(std::next(first1, k), last1, std::next(first2), comp_next_mean); 
+	}
 }
 
 template <typename InputIt, typename OutputIt, typename UnaryOp, typename T>	
@@ -1761,10 +1836,17 @@ void utility::roll_mean(InputIt first1, InputIt last1, OutputIt first2, int k, U
 //computing the rolling weighted mean (where the weights vector remains constant)
 template <typename InputIt, typename OutputIt, typename W, typename T> 
 void utility::roll_wtd_mean(InputIt first1, InputIt last1, OutputIt first2, const std::vector<W>& weights, T init){
-	int k = weights.size();
-	for(auto it = std::next(first1, k - 1); it != last1; it++){
-		*first2 = wtd_mean(std::prev(it, k - 1), std::next(it), weights, init);
-		first2++; 
+	if constexpr(span_kernel_its<InputIt, OutputIt, T> && std::same_as<W, T>){
+		//contiguous float or double data & weights (same values as the code below)
+		std::size_t n = std::distance(first1, last1);
+		int k = weights.size();
+		roll_wtd_mean(std::span<const T>(std::to_address(first1), n), std::span<T>(std::to_address(first2), n - k + 1), std::span<const T>(weights), init);
+	}else{
+		int k = weights.size();
+		for(auto it = std::next(first1, k - 1); it != last1; it++){
+			*first2 = wtd_mean(std::prev(it, k - 1), std::next(it), weights, init);
+			first2++; 
+		}
 	}
 }
 //computing the rolling (w/ constant weights vector & we apply a unary to the elements of [first1, last))
@@ -2583,19 +2665,25 @@ void utility::tema_diff(InputIt first1, InputIt last1, OutputIt first2, int k1,
 //rolling variance 
 template <typename InputIt, typename OutputIt, typename T> 
 void utility::roll_var(InputIt first1, InputIt last1, OutputIt first2, int k, T init){
-	//iterator to the discarded value
-	auto itd = first1; 	
-	//compute the mean and variance and assign the first variance 
-	std::pair<T, T> mv = mean_var(first1, std::next(first1, k), init);
-	*first2 = mv.second;
-	//compute the other variances 
-	auto comp_next_var = [&itd, &k, &mv](const auto& x){
-		//update the mean & variance 
-		roll_var_update(mv.second, mv.first, *itd, x, k);
-		itd++; 
-		return mv.second; 
-	};
-	std::transform(std::next(first1, k), last1, std::next(first2), comp_next_var); 
+	if constexpr(span_kernel_its<InputIt, OutputIt, T>){
+		//contiguous float or double data (same values as the code below)
+		std::size_t n = std::distance(first1, last1);
+		roll_var(std::span<const T>(std::to_address(first1), n), std::span<T>(std::to_address(first2), n - k + 1), k, init);
+	}else{
+		//iterator to the discarded value
+		auto itd = first1; 	
+		//compute the mean and variance and assign the first variance 
+		std::pair<T, T> mv = mean_var(first1, std::next(first1, k), init);
+		*first2 = mv.second;
+		//compute the other variances 
+		auto comp_next_var = [&itd, &k, &mv](const auto& x){
+			//update the mean & variance 
+			roll_var_update(mv.second, mv.first, *itd, x, k);
+			itd++; 
+			return mv.second; 
+		};
+		std::transform(std::next(first1, k), last1, std::next(first2), comp_next_var); 
+	}
 }
 template <typename InputIt, typename OutputIt, typename T, typename UnaryOp>	
 void utility::roll_var(InputIt first1, InputIt last1, OutputIt first2, int k, T init, UnaryOp un_op){
@@ -2618,19 +2706,25 @@ void utility::roll_var(InputIt first1, InputIt last1, OutputIt first2, int k, T
 //computing the rolling standard deviation
 template <typename InputIt, typename OutputIt, typename T> 
 void utility::roll_std(InputIt first1, InputIt last1, OutputIt first2, int k, T init){
-	//iterator to the discarded value 
-	auto itd = first1; 
-	//compute the mean and variance & assign the first standard deviation
-	std::pair<T, T> mstd = mean_var(first1, std::next(first1, k), init);
-	mstd.second = std::sqrt(mstd.second); 
-	*first2 = mstd.second;  
-	//compute the other standard deviations by calling roll_std_update 
-	auto comp_next_std = [&k, &itd, &mstd](const auto &x){
-		roll_std_update(mstd.second, mstd.first, *itd, x, k);
-		itd++; 
-		return mstd.second; 
-	};
-	std::transform(std::next(first1, k), last1, std::next(first2), comp_next_std); 
+	if constexpr(span_kernel_its<InputIt, OutputIt, T>){
+		//contiguous float or double data (same values as the code below)
+		std::size_t n = std::distance(first1, last1);
+		roll_std(std::span<const T>(std::to_address(first1), n), std::span<T>(std::to_address(first2), n - k + 1), k, init);
+	}else{
+		//iterator to the discarded value 
+		auto itd = first1; 
+		//compute the mean and variance & assign the first standard deviation
+		std::pair<T, T> mstd = mean_var(first1, std::next(first1, k), init);
+		mstd.second = std::sqrt(mstd.second); 
+		*first2 = mstd.second;  
+		//compute the other standard deviations by calling roll_std_update 
+		auto comp_next_std = [&k, &itd, &mstd](const auto &x){
+			roll_std_update(mstd.second, mstd.first, *itd, x, k);
+			itd++; 
+			return mstd.second; 
+		};
+		std::transform(std::next(first1, k), last1, std::next(first2), comp_next_std); 
+	}
 }
 template <typename InputIt, typename OutputIt, typename T, typename UnaryOp>	
 void utility::roll_std(InputIt first1, InputIt last1, OutputIt first2, int k, T init, UnaryOp un_op){
@@ -2652,19 +2746,27 @@ void utility::roll_std(InputIt first1, InputIt last1, OutputIt first2, int k, T
 //computing the rolling z-score 
 template <typename InputIt, typename OutputIt, typename T> 
 void utility::roll_zscore(InputIt first1, InputIt last1, OutputIt first2, int k, T init){
-	//iterator to the discarded value 
-	auto itd = first1; 
-	//compute the mean and variance 
-	std::pair<T, T> mstd = mean_var(first1, std::next(first1, k), init);
-	//take the square root of the variance to get the standard deviation
-	mstd.second = std::sqrt(mstd.second);
-	//compute the first zscore 
-	*first2 = zscore(std::next(first1, k - 1), mstd.first, mstd.second);
-	//compute the other zscores by calling roll_zscore_update 
-	auto comp_next_zscore = [&k, &itd, &mstd](const auto& x){
-		return roll_zscore_update(mstd.second, mstd.first, *itd, x, k); 
-	};
-	std::transform(std::next(first1, k), last1, std::next(first2), comp_next_zscore); 
+	if constexpr(span_kernel_its<InputIt, OutputIt, T>){
+		//contiguous float or double data (same values as the code below)
+		std::size_t n = std::distance(first1, last1);
+		roll_zscore(std::span<const T>(std::to_address(first1), n), std::span<T>(std::to_address(first2), n - k + 1), k, init);
+	}else{
+		//iterator to the discarded value 
+		auto itd = first1; 
+		//compute the mean and variance 
+		std::pair<T, T> mstd = mean_var(first1, std::next(first1, k), init);
+		//take the square root of the variance to get the standard deviation
+		mstd.second = std::sqrt(mstd.second);
+		//compute the first zscore 
+		*first2 = zscore(*std::next(first1, k - 1), mstd.first, mstd.second);
+		//compute the other zscores by calling roll_zscore_update 
+		auto comp_next_zscore = [&k, &itd, &mstd](const auto& x){
+			T z = roll_zscore_update(mstd.second, mstd.first, *itd, x, k); 
+			itd++; 
+			return z; 
+		};
+		std::transform(std::next(first1, k), last1, std::next(first2), comp_next_zscore); 
+	}
 }
 template <typename InputIt, typename OutputIt, typename T, typename UnaryOp>	
 void utility::roll_zscore(InputIt first1, InputIt last1, OutputIt first2, int k, T init, UnaryOp un_op){
@@ -2675,13 +2777,102 @@ void utility::roll_zscore(InputIt first1, InputIt last1, OutputIt first2, int k,
 	//compute the standard deviation 
 	mstd.second = std::sqrt(mstd.second);
 	//compute the first zscore 
-	*first2 = zscore(un_op(std::next(first1, k - 1)), mstd.first, mstd.second);
+	*first2 = zscore(un_op(*std::next(first1, k - 1)), mstd.first, mstd.second);
 	//compute the other zscores 
 	auto comp_next_zscore = [&k, &itd, &mstd, &un_op](const auto& x){
-		return roll_zscore_update(mstd.second, mstd.first, un_op(*itd), un_op(x), k); 
+		T z = roll_zscore_update(mstd.second, mstd.first, un_op(*itd), un_op(x), k); 
+		itd++; 
+		return z; 
 	};
 	std::transform(std::next(first1, k), last1, std::next(first2), comp_next_zscore); 
 }
+
+//span overloads of the rolling kernels 
+template <utility::span_kernel_type T> 
+void utility::roll_mean(std::span<const std::type_identity_t<T>> x, std::span<std::type_identity_t<T>> out, int k, T init){
+	span_kernel_check(x.size(), out.size(), k, 1, "roll_mean");
+	//mean of the first k values & the rest by roll_mean_update (as in the iterator version)
+	T m = mean(x.begin(), std::next(x.begin(), k), init);
+	out[0] = m;
+	for(std::size_t i = k; i < x.size(); i++){
+		roll_mean_update(m, x[i - k], x[i], k);
+		out[i - k + 1] = m;
+	}
+}
+template <utility::span_kernel_type T> 
+void utility::roll_var(std::span<const std::type_identity_t<T>> x, std::span<std::type_identity_t<T>> out, int k, T init){
+	span_kernel_check(x.size(), out.size(), k, 2, "roll_var");
+	std::pair<T, T> mv = mean_var(x.begin(), std::next(x.begin(), k), init);
+	out[0] = mv.second;
+	for(std::size_t i = k; i < x.size(); i++){
+		roll_var_update(mv.second, mv.first, x[i - k], x[i], k);
+		out[i - k + 1] = mv.second;
+	}
+}
+template <utility::span_kernel_type T> 
+void utility::roll_std(std::span<const std::type_identity_t<T>> x, std::span<std::type_identity_t<T>> out, int k, T init){
+	span_kernel_check(x.size(), out.size(), k, 2, "roll_std");
+	std::pair<T, T> mstd = mean_var(x.begin(), std::next(x.begin(), k), init);
+	mstd.second = std::sqrt(mstd.second); 
+	out[0] = mstd.second;
+	for(std::size_t i = k; i < x.size(); i++){
+		roll_std_update(mstd.second, mstd.first, x[i - k], x[i], k);
+		out[i - k + 1] = mstd.second;
+	}
+}
+template <utility::span_kernel_type T> 
+void utility::roll_zscore(std::span<const std::type_identity_t<T>> x, std::span<std::type_identity_t<T>> out, int k, T init){
+	span_kernel_check(x.size(), out.size(), k, 2, "roll_zscore");
+	std::size_t n_out = x.size() - k + 1; 
+	std::pair<T, T> mstd = mean_var(x.begin(), std::next(x.begin(), k), init);
+	mstd.second = std::sqrt(mstd.second);
+	out[0] = zscore(x[k - 1], mstd.first, mstd.second);
+	//the means go to out & the standard deviations to stds (the recurrence of roll_std_update)
+	std::vector<T> stds(n_out);
+	for(std::size_t i = k; i < x.size(); i++){
+		roll_std_update(mstd.second, mstd.first, x[i - k], x[i], k);
+		out[i - k + 1] = mstd.first;
+		stds[i - k + 1] = mstd.second;
+	}
+	//z-scores (new_val - mean) / std (as in roll_zscore_update) a pack at a time
+	constexpr std::size_t w = simd::width<T>;
+	const T* xk = x.data() + k - 1;
+	std::size_t j = 1;
+	for(; j + w <= n_out; j += w){
+		simd::store((simd::load(xk + j) - simd::load(out.data() + j)) / simd::load(stds.data() + j), out.data() + j);
+	}
+	for(; j < n_out; j++){
+		out[j] = zscore(xk[j], out[j], stds[j]);
+	}
+	//the z-score is 0 where the standard deviation is 0 (as in zscore)
+	for(j = 1; j < n_out; j++){
+		if(stds[j] == 0){
+			out[j] = 0;
+		}
+	}
+}
+template <utility::span_kernel_type T> 
+void utility::roll_wtd_mean(std::span<const std::type_identity_t<T>> x, std::span<std::type_identity_t<T>> out, std::span<const std::type_identity_t<T>> weights, T init){
+	std::size_t k = weights.size();
+	span_kernel_check(x.size(), out.size(), k, 1, "roll_wtd_mean");
+	std::size_t n_out = x.size() - k + 1; 
+	//1 / (sum of the weights) as in wtd_mean
+	T w_sum = std::accumulate(weights.begin(), weights.end(), init, [](T val, const T& w){ return val + w; });
+	T scale = 1 / w_sum; 
+	//the inner products of w windows at once (each lane adds its products in the order of std::inner_product)
+	constexpr std::size_t w = simd::width<T>;
+	std::size_t i = 0;
+	for(; i + w <= n_out; i += w){
+		simd::pack<T> ip(init);
+		for(std::size_t j = 0; j < k; j++){
+			ip = ip + (simd::load(x.data() + i + j) * simd::pack<T>(weights[j]));
+		}
+		simd::store(simd::pack<T>(scale) * ip, out.data() + i);
+	}
+	for(; i < n_out; i++){
+		out[i] = scale * std::inner_product(std::next(x.begin(), i), std::next(x.begin(), i + k), weights.begin(), init);
+	}
+}
 //rolling minimum 
 template <typename InputIt, typename OutputIt> 
 void utility::roll_min(InputIt first1, InputIt last1, OutputIt first2, int k){
@@ -3062,24 +3253,60 @@ void utility::roll_robust_scale(InputIt first1, InputIt last1, OutputIt first2,
 //T is the type in the iterator range 
 template <typename DtStartIt, typename InputIt, typename OutputIt, typename T> 
 void utility::timestamp_zip(InputIt first1, InputIt last1, DtStartIt dt_first, OutputIt first2, const std::string& var, T ex){
-	auto create_ts = [&dt_first, &first1, &var](const auto& x){
-		return Timestamp<T>{std::next(dt_first, std::distance(&(*first1), &x))->dt(), std::move(x), var};
-	};
-	std::transform(std::execution::par_unseq, first1, last1, first2, create_ts);
+	if constexpr(requires { first2.series().write_span(0, dt_first->dt(), dt_first->dt(), 0); }){
+		//TimeSeries writer: the datetimes are taken from the series' axis 
+		std::size_t n = std::distance(first1, last1); 
+		if(n == 0){
+			return; 
+		}
+		auto& ts = first2.series(); 
+		ts.set_name(var); 
+		auto out = ts.write_span(first2.index(), dt_first->dt(), std::next(dt_first, n - 1)->dt(), n); 
+		std::copy(std::execution::par_unseq, first1, last1, out.begin()); 
+	}else{
+		auto create_ts = [&dt_first, &first1, &var](const auto& x){
+			return Timestamp<T>{std::next(dt_first, std::distance(&(*first1), &x))->dt(), std::move(x), var};
+		};
+		std::transform(std::execution::par_unseq, first1, last1, first2, create_ts);
+	}
 }
 template <typename DtStartIt, typename InputIt1, typename InputIt2, typename OutputIt, typename BinOp, typename T> 
 void utility::timestamp_zip(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, DtStartIt dt_first, OutputIt first3, BinOp bin_op, const std::string& name, T ex){
-	auto create_ts = [&dt_first, &first1, &name, &bin_op](const auto& z1, const auto& z2){
-		return std::move(Timestamp<T>{std::next(dt_first, std::distance(&(*first1), &z1))->dt(), bin_op(z1, z2), name}); 
-	};
-	std::transform(std::execution::par_unseq, first1, last1, first2, first3, create_ts); 
+	if constexpr(requires { first3.series().write_span(0, dt_first->dt(), dt_first->dt(), 0); }){
+		//TimeSeries writer: the datetimes are taken from the series' axis 
+		std::size_t n = std::distance(first1, last1); 
+		if(n == 0){
+			return; 
+		}
+		auto& ts = first3.series(); 
+		ts.set_name(name); 
+		auto out = ts.write_span(first3.index(), dt_first->dt(), std::next(dt_first, n - 1)->dt(), n); 
+		std::transform(std::execution::par_unseq, first1, last1, first2, out.begin(), bin_op); 
+	}else{
+		auto create_ts = [&dt_first, &first1, &name, &bin_op](const auto& z1, const auto& z2){
+			return std::move(Timestamp<T>{std::next(dt_first, std::distance(&(*first1), &z1))->dt(), bin_op(z1, z2), name}); 
+		};
+		std::transform(std::execution::par_unseq, first1, last1, first2, first3, create_ts); 
+	}
 }
 template <typename InputIt1, typename InputIt2, typename OutputIt, typename BinOp, typename T> 
 void utility::timestamp_zip(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt first3, BinOp bin_op, const std::string& name, T ex){
-	auto create_ts = [&first1, &name, &bin_op](const auto& z1, const auto& z2){
-		return std::move(Timestamp<T>{z1.dt(), bin_op(z1, z2), name}); 
-	};
-	std::transform(std::execution::par_unseq, first1, last1, first2, first3, create_ts); 
+	if constexpr(requires { first3.series().write_span(0, first1->dt(), first1->dt(), 0); }){
+		//TimeSeries writer: the datetimes are taken from the series' axis 
+		std::size_t n = std::distance(first1, last1); 
+		if(n == 0){
+			return; 
+		}
+		auto& ts = first3.series(); 
+		ts.set_name(name); 
+		auto out = ts.write_span(first3.index(), first1->dt(), std::next(first1, n - 1)->dt(), n); 
+		std::transform(std::execution::par_unseq, first1, last1, first2, out.begin(), bin_op); 
+	}else{
+		auto create_ts = [&first1, &name, &bin_op](const auto& z1, const auto& z2){
+			return std::move(Timestamp<T>{z1.dt(), bin_op(z1, z2), name}); 
+		};
+		std::transform(std::execution::par_unseq, first1, last1, first2, first3, create_ts); 
+	}
 }
 
 template <typename InputIt, typename OutputIt, typename T, typename UnaryOp> 
@@ -3154,17 +3381,51 @@ void utility::fout_open(std::ofstream& ofs, S path){
 		throw std::runtime_error("fout_open: Could not open the file."); 
 	}
 }
+template <typename T> 
+Datetime utility::dt_of(const T& x){
+	if constexpr(requires { *x.dt(); }){
+		return *x.dt(); 
+	}else{
+		return x.dt(); 
+	}
+}
 template <typename InputIt> 
 InputIt utility::find_iterator_to_dt(InputIt it, InputIt last, const Datetime& dt, bool forwards){
+	if constexpr(std::random_access_iterator<InputIt>){
+		//the backwards search covers (last, it]
+		InputIt lo = forwards ? it : std::next(last); 
+		InputIt hi = forwards ? last : std::next(it); 
+		if(lo < hi){
+			std::int64_t e = dt.epoch(); 
+			std::int64_t e0 = dt_of(*lo).epoch(); 
+			std::int64_t e1 = dt_of(*std::prev(hi)).epoch(); 
+			if(e0 <= e && e <= e1){
+				//guess the position assuming the datetimes are evenly spaced (exact for a series without gaps)
+				auto n = hi - lo; 
+				decltype(n) g = 0; 
+				if(e1 > e0){
+					g = static_cast<decltype(n)>((double(e - e0) / double(e1 - e0)) * (n - 1)); 
+				}
+				if(dt_of(lo[g]) == dt){
+					return lo + g; 
+				}
+				//binary search 
+				InputIt f = std::partition_point(lo, hi, [&](const auto& x){return dt_of(x).epoch() < e;}); 
+				if(f != hi && dt_of(*f) == dt){
+					return f; 
+				}
+			}
+		}
+	}
 	if(forwards){
 		for(it; it != last; it++){
-			if(it->dt() == dt){
+			if(utility::dt_of(*it) == dt){
 				return it; 
 			}
 		}
 	}else{
 		for(it; it != last; it--){
-			if(it->dt() == dt){
+			if(utility::dt_of(*it) == dt){
 				return it; 
 			}
 		}
@@ -3179,14 +3440,14 @@ void utility::sync_iterators(std::tuple<ItPairs...>& iterator_pairs){
 //assumes that the second iterators in the pairs are .end() iterators
 template <size_t... Is, typename... ItPairs> 
 void utility::sync_iterators_impl(std::tuple<ItPairs...>& iterator_pairs, std::index_sequence<Is...> indices){
-	Datetime lf_dt = std::get<0>(iterator_pairs).first->dt();  
-	Datetime fl_dt = std::prev(std::get<0>(iterator_pairs).second)->dt(); 
+	Datetime lf_dt = utility::dt_of(*std::get<0>(iterator_pairs).first);  
+	Datetime fl_dt = utility::dt_of(*std::prev(std::get<0>(iterator_pairs).second)); 
 	auto dt_cmp = [&lf_dt, &fl_dt](const auto& p){
-		if(p.first->dt() > lf_dt){
-			lf_dt = p.first->dt(); 
+		if(utility::dt_of(*p.first) > lf_dt){
+			lf_dt = utility::dt_of(*p.first); 
 		}
-		if(std::prev(p.second)->dt() < fl_dt){
-			fl_dt = std::prev(p.second)->dt(); 
+		if(utility::dt_of(*std::prev(p.second)) < fl_dt){
+			fl_dt = utility::dt_of(*std::prev(p.second)); 
 		}
 	}; 
 	((dt_cmp(std::get<Is>(iterator_pairs))), ...);
@@ -3241,27 +3502,45 @@ void utility::sync_matrix_labels_iterators(std::tuple<ItPairs...>& mat_it_pairs,
 	utility::tuple_split(it_pairs, mat_it_pairs, lab_it_pair_tup);
 	lab_it_pair = std::get<0>(lab_it_pair_tup); 
 }
-template <typename... ItPairs> 
-void utility::sync_matrix_cs_iterators(std::tuple<ItPairs...>& mat_it_pairs, std::pair<std::vector<CandlePtr>::const_iterator, std::vector<CandlePtr>::const_iterator>& csitp){
-	utility::sync_iterators(mat_it_pairs);
-	Datetime lf_dt = std::get<0>(mat_it_pairs).first->dt(); 
-	Datetime fl_dt = std::get<0>(mat_it_pairs).second->dt();
-	auto out = csitp; 
-	for(auto it = csitp.first; it != csitp.second; it++){
-		if(*(it->dt()) == lf_dt){
-			out.first = it;  
+template <typename CandleIt, typename... ItPairs> 
+void utility::sync_matrix_cs_iterators(std::tuple<ItPairs...>& mat_it_pairs, std::pair<CandleIt, CandleIt>& csitp){
+	utility::sync_matrix_labels_iterators(mat_it_pairs, csitp); 
+}
+template <typename CandleIt> 
+void utility::sync_iterators(std::pair<std::pair<CandleIt, CandleIt>, std::pair<CandleIt, CandleIt>>& csitpp){
+	Datetime lf_dt; 
+	Datetime fl_dt;
+	if(utility::dt_of(*csitpp.first.first) > utility::dt_of(*csitpp.second.first)){
+		lf_dt = utility::dt_of(*csitpp.first.first);  
+		for(auto it = csitpp.second.first; it != csitpp.second.second; it++){
+			if(utility::dt_of(*it) == lf_dt){
+				csitpp.second.first = it; 
+			}
+		}
+	}else{
+		lf_dt = utility::dt_of(*csitpp.second.first);  
+		for(auto it = csitpp.first.first; it != csitpp.first.second; it++){
+			if(utility::dt_of(*it) == lf_dt){
+				csitpp.first.first = it; 
+			}
 		}
 	}
-	for(auto it = csitp.second; it != csitp.first; it--){
-		if(*(it->dt()) == fl_dt){
-			out.second = it;  
+	if(utility::dt_of(*csitpp.first.second) < utility::dt_of(*csitpp.second.second)){
+		fl_dt = utility::dt_of(*csitpp.first.second);  
+		for(auto it = csitpp.second.second; it != csitpp.second.first; it--){
+			if(utility::dt_of(*it) == fl_dt){
+				csitpp.second.second = it; 
+			}
+		}
+	}else{
+		fl_dt = utility::dt_of(*csitpp.second.second);  
+		for(auto it = csitpp.first.second; it != csitpp.first.first; it--){
+			if(utility::dt_of(*it) == fl_dt){
+				csitpp.first.second = it; 
+			}
 		}
 	}
 }
-template <typename... ItPairs> 
-void utility::sync_matrix_cs_iterators(std::tuple<ItPairs...>& mat_it_pairs, std::pair<std::vector<Candle>::const_iterator, std::vector<Candle>::const_iterator>& csitp){
-	utility::sync_matrix_labels_iterators(mat_it_pairs, csitp); 
-}
 
 template <typename T, typename It>
 void utility::split_matrix(const arma::Mat<T>& mat, std::vector<arma::Mat<T>>& mat_splits, const std::pair<It, It> flc_its, std::vector<std::pair<It, It>>& flc_its_splits, int k){